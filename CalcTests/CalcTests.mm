@@ -29,11 +29,149 @@
 #import <XCTest/XCTest.h>
 
 #import "BuildTreeFromDictionary.hpp"
+#import "Average.hpp"
 #import "Calculate.hpp"
+#import "ChebyshevApproximant.hpp"
+#import "EvaluationThread.hpp"
+#import "FusedIterationNode.hpp"
+#import "HarmonicMean.hpp"
+#import "Max.hpp"
+#import "Min.hpp"
+#import "NaryFuncNode.hpp"
+#import "NumberNode.hpp"
+#import "ParallelEvaluation.hpp"
+#import "PolynomialNode.hpp"
+#import "Product.hpp"
 #import "SCalcState.hpp"
+#import "Sum.hpp"
+#import "TreeUtilities.hpp"
+#import "UserFuncNode.hpp"
+#import "VectorMath.hpp"
+#import "WorkStealingPool.hpp"
 
+#import <boost/multiprecision/cpp_bin_float.hpp>
+
+#import <float.h>
+#import <malloc/malloc.h>
+#import <mach/mach.h>
 #import <math.h>
 #import <iostream>
+#import <atomic>
+#import <new>
+#import <thread>
+#import <bit>
+#import <random>
+#import <mutex>
+
+// Allocation counting for tests of steady-state memory behavior.  The
+// evaluator is in the host app, which would not see a replacement operator
+// new in this bundle, so we count calls to the default malloc zone instead.
+// All forms of operator new get their memory there.  Allocations are only
+// counted while sCountAllocations is true.
+static std::atomic<bool>	sCountAllocations{ false };
+static std::atomic<size_t>	sAllocationCount{ 0 };
+static malloc_zone_t		sOriginalZone;
+
+static void	CountAllocation()
+{
+	if (sCountAllocations)
+	{
+		++sAllocationCount;
+	}
+}
+
+static void*	CountingMalloc( malloc_zone_t* zone, size_t size )
+{
+	CountAllocation();
+	return sOriginalZone.malloc( zone, size );
+}
+
+static void*	CountingCalloc( malloc_zone_t* zone, size_t count, size_t size )
+{
+	CountAllocation();
+	return sOriginalZone.calloc( zone, count, size );
+}
+
+static void*	CountingValloc( malloc_zone_t* zone, size_t size )
+{
+	CountAllocation();
+	return sOriginalZone.valloc( zone, size );
+}
+
+static void*	CountingRealloc( malloc_zone_t* zone, void* block, size_t size )
+{
+	CountAllocation();
+	return sOriginalZone.realloc( zone, block, size );
+}
+
+static void*	CountingMemalign( malloc_zone_t* zone, size_t alignment, size_t size )
+{
+	CountAllocation();
+	return sOriginalZone.memalign( zone, alignment, size );
+}
+
+// Patch the zone that malloc uses, which is the first registered zone.  The
+// zone structure is normally read-only.
+static void	InstallAllocationCounter()
+{
+	static std::once_flag sInstalled;
+	std::call_once( sInstalled, []()
+	{
+		vm_address_t* zones = nullptr;
+		unsigned int zoneCount = 0;
+		malloc_get_all_zones( mach_task_self(), nullptr, &zones, &zoneCount );
+		malloc_zone_t* zone = reinterpret_cast<malloc_zone_t*>( zones[0] );
+		sOriginalZone = *zone;
+		
+		vm_protect( mach_task_self(), reinterpret_cast<vm_address_t>( zone ),
+			sizeof(malloc_zone_t), false, VM_PROT_READ | VM_PROT_WRITE );
+		zone->malloc = CountingMalloc;
+		zone->calloc = CountingCalloc;
+		zone->valloc = CountingValloc;
+		zone->realloc = CountingRealloc;
+		if (zone->version >= 5)
+		{
+			zone->memalign = CountingMemalign;
+		}
+		vm_protect( mach_task_self(), reinterpret_cast<vm_address_t>( zone ),
+			sizeof(malloc_zone_t), false, VM_PROT_READ );
+	} );
+}
+
+// Number of steps between two doubles through the representable numbers.
+// NaNs are no distance from each other and infinitely far from the rest.
+static double	UlpDistance( double inA, double inB )
+{
+	if (isnan( inA ) or isnan( inB ))
+	{
+		return (isnan( inA ) and isnan( inB ))? 0.0 : INFINITY;
+	}
+	
+	// Map the bit patterns to integers ordered as the doubles are.
+	auto ordered = []( double x ) -> int64_t
+	{
+		const int64_t bits = std::bit_cast<int64_t>( x );
+		return (bits < 0)? INT64_MIN - bits : bits;
+	};
+	const int64_t a = ordered( inA );
+	const int64_t b = ordered( inB );
+	const uint64_t distance = (a > b)? static_cast<uint64_t>( a ) - static_cast<uint64_t>( b ) :
+		static_cast<uint64_t>( b ) - static_cast<uint64_t>( a );
+	return static_cast<double>( distance );
+}
+
+using Exact = boost::multiprecision::cpp_bin_float_50;
+
+// Error of a double in units in the last place of an exact value, given to
+// 50 digits, whose rounding to double is finite and nonzero.
+static double	UlpError( double inValue, const Exact& inExact )
+{
+	int exponent = 0;
+	frexp( static_cast<double>( inExact ), &exponent );
+	const double ulp = ldexp( 1.0,
+		std::max( exponent - DBL_MANT_DIG, DBL_MIN_EXP - DBL_MANT_DIG ) );
+	return static_cast<double>( abs( Exact( inValue ) - inExact ) / ulp );
+}
 
 @interface CalcTests : XCTestCase
 
@@ -154,6 +292,11 @@
 	XCTAssert( result.type == CalcResultType::value );
 	XCTAssert( fabs( 2.91667 - result.calculatedValue ) < 1.0e-4 );
 	
+	// Deviations are small compared to the mean
+	result = Calculate( "Var(1e9+4, 1e9+7, 1e9+13, 1e9+16)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 22.5, 1.0e-9 );
+	
 	result = Calculate( "SD(3,2,5,4,1,6)", state );
 	XCTAssert( result.type == CalcResultType::value );
 	XCTAssert( fabs( 1.70783 - result.calculatedValue ) < 1.0e-4 );
@@ -162,6 +305,14 @@
 	XCTAssert( result.type == CalcResultType::value );
 	XCTAssert( fabs( 2.9938 - result.calculatedValue ) < 1.0e-4 );
 	
+	// Partial products out of range
+	result = Calculate( "GM(1e300, 1e300, 1e-30)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue / 1e190, 1.0, 1.0e-13 );
+	result = Calculate( "product(1e200, 1e200, 1e-300)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue / 1e100, 1.0, 1.0e-13 );
+	result = Calculate( "product(1e200, 1e200, 1e-30)", state );
+	XCTAssert( isinf( result.calculatedValue ) );
+	
 	result = Calculate( "HM(3,2,5,4,1,6)", state );
 	XCTAssert( result.type == CalcResultType::value );
 	XCTAssert( fabs( 2.44898 - result.calculatedValue ) < 1.0e-4 );
@@ -169,6 +320,63 @@
 	result = Calculate( "median(3,2,5,4,1,6)", state );
 	XCTAssert( result.type == CalcResultType::value );
 	XCTAssert( fabs( 3.5 - result.calculatedValue ) < 1.0e-10 );
+	
+	// Selection-based order statistics
+	result = Calculate( "median(7,1,5)", state );
+	XCTAssertEqual( result.calculatedValue, 5.0 );
+	result = Calculate( "quantile(0.25, 5,4,3,2,1)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 2.0 );
+	result = Calculate( "percentile(90, 10,9,8,7,6,5,4,3,2,1)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 9.1, 1.0e-12 );
+	result = Calculate( "IQR(1,2,3,4,5,6,7,8)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 3.5, 1.0e-12 );
+	result = Calculate( "MAD(1,1,2,2,4,6,9)", state );
+	XCTAssertEqual( result.calculatedValue, 1.0 );
+	result = Calculate( "quantile(1.5, 1, 2)", state );
+	XCTAssert( isnan( result.calculatedValue ) );
+	
+	// Interpolation between infinities
+	result = Calculate( "median(∞, ∞)", state );
+	XCTAssertEqual( result.calculatedValue, INFINITY );
+	result = Calculate( "median(-∞, 1)", state );
+	XCTAssertEqual( result.calculatedValue, -INFINITY );
+	result = Calculate( "percentile(25, 1, ∞)", state );
+	XCTAssertEqual( result.calculatedValue, INFINITY );
+}
+
+- (void) testLiteralArgumentList
+{
+	SCalcState state;
+	std::string longList( "sum(1.5" );
+	for (int i = 2; i <= 50000; ++i)
+	{
+		longList += ", " + std::to_string( i ) + ".5";
+	}
+	longList += ")";
+	auto result = Calculate( longList, state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 50000.0 * 50001.0 / 2.0 + 25000.0 );
+	
+	result = Calculate( "max(-1, -2.5e1, -3)", state );
+	XCTAssertEqual( result.calculatedValue, -1.0 );
+	result = Calculate( "quantile(0.5, 3, 1, 2)", state );
+	XCTAssertEqual( result.calculatedValue, 2.0 );
+	result = Calculate( "2 *\u00A0max(1, 3)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 6.0 );
+	
+	// Lists that are not all literal numbers take the general path.
+	result = Calculate( "sum(1, 2, 3 + 4)", state );
+	XCTAssertEqual( result.calculatedValue, 10.0 );
+	result = Calculate( "sum(1, 2 3, 0x10)", state );
+	XCTAssertEqual( result.calculatedValue, 23.0 );
+	result = Calculate( "sum(1, -2^2)", state );
+	XCTAssertEqual( result.calculatedValue, -3.0 );
+	result = Calculate( "sum(5)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "sum(1, +2)", state );
+	XCTAssert( result.type == CalcResultType::error );
 }
 
 - (void) testAssigningVariables
@@ -418,6 +626,54 @@
 		CalcInterruptCode::stackLimit );
 }
 
+- (void) testEvaluationStackSize
+{
+	// Two parameters, so that the recursion is not turned into a table.
+	// The stacks are sized explicitly, so that the test does not depend on
+	// the stack of the thread running it, and kept small, so that it does
+	// not take long to use them up.
+	SCalcState state;
+	auto result = Calculate( "f(n, x) = if(n, x + f(n-1, x), 0)", state );
+	state.SetEvaluationStackSize( 1024U * 1024U );
+	result = Calculate( "f(10000, 1)", state );
+	XCTAssert( result.type == CalcResultType::interrupt );
+	XCTAssertEqual( result.interruptCode, CalcInterruptCode::stackLimit );
+	
+	state.SetEvaluationStackSize( 64U * 1024U * 1024U );
+	result = Calculate( "f(10000, 1)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 10000.0 );
+	
+	// Infinite recursion is still stopped.
+	result = Calculate( "g(n) = 1 + g(n)", state );
+	result = Calculate( "g(1)", state );
+	XCTAssert( result.type == CalcResultType::interrupt );
+	XCTAssertEqual( result.interruptCode, CalcInterruptCode::stackLimit );
+	
+	// Parallel workers get stacks of the same size.
+	state.SetEvaluationThreadCount( 4 );
+	result = Calculate( "∑(i, 1, 4, f(10000, i))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 100000.0 );
+	
+	// An exception thrown by a job reaches the thread that is waiting for
+	// it, and the evaluation thread goes on working.
+	EvaluationThread thread( 1024U * 1024U );
+	bool didThrow = false;
+	try
+	{
+		thread.Run( []() { throw std::bad_alloc(); } );
+	}
+	catch (const std::bad_alloc&)
+	{
+		didThrow = true;
+	}
+	XCTAssert( didThrow );
+	bool didRun = false;
+	thread.Run( [&didRun]() { didRun = true; } );
+	XCTAssert( didRun );
+}
+
 - (void) testdictionaryRepresentation
 {
 	SCalcState state;
@@ -460,6 +716,1239 @@
 	XCTAssertEqual( result.calculatedValue, 86400.0 );
 }
 
+- (void) testSteadyStateAllocations
+{
+	InstallAllocationCounter();
+	SCalcState state;
+	auto result = Calculate( "x = 4", state );
+	
+	// Defining a variable allocates, which shows that allocations made by
+	// the evaluator are counted.
+	sAllocationCount = 0;
+	sCountAllocations = true;
+	result = Calculate( "y = 5", state );
+	sCountAllocations = false;
+	XCTAssertGreaterThan( sAllocationCount, 0 );
+	
+	// Warm up the reusable buffers and the node pool.
+	for (int i = 0; i < 3; ++i)
+	{
+		result = Calculate( "2+3*x", state );
+	}
+	
+	sAllocationCount = 0;
+	sCountAllocations = true;
+	result = Calculate( "2+3*x", state );
+	sCountAllocations = false;
+	size_t allocations = sAllocationCount;
+	
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 14.0 );
+	XCTAssertEqual( allocations, 0 );
+	
+	// Calls of n-ary and user functions reuse argument vectors, and find
+	// cached results without making keys.
+	result = Calculate( "f(a, b) = a - b", state );
+	autoASTNode maxNode( new NaryFuncNode( Max, { MakeNode<NumberNode>( 1.0 ),
+		MakeNode<NumberNode>( 5.0 ), MakeNode<NumberNode>( 3.0 ) } ) );
+	autoASTNode callNode( new UserFuncNode( "f",
+		{ maxNode, MakeNode<NumberNode>( 2.0 ) } ) );
+	XCTAssertEqual( callNode->Evaluate( state ).value_or( 0.0 ), 3.0 );
+	
+	sAllocationCount = 0;
+	sCountAllocations = true;
+	for (int i = 0; i < 100; ++i)
+	{
+		callNode->Evaluate( state );
+	}
+	sCountAllocations = false;
+	XCTAssertEqual( sAllocationCount, 0 );
+}
+
+- (void) testInlining
+{
+	SCalcState state;
+	auto result = Calculate( "sq(x) = x*x", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "hyp(a, b) = sqrt(sq(a) + sq(b))", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	XCTAssert( state.compiledFunctions.contains( "hyp" ) );
+	XCTAssertFalse( ContainsNodeOfType<UserFuncNode>( *state.compiledFunctions[ "hyp" ].body ) );
+	result = Calculate( "hyp(3, 4)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 5.0 );
+	
+	// Redefining the inner function must affect the outer one.
+	result = Calculate( "sq(x) = 2x", state );
+	XCTAssert( result.type == CalcResultType::redefinedFunc );
+	result = Calculate( "hyp(3, 4)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, sqrt(14.0), 1.0e-12 );
+	
+	// Recursive functions are not inlined.
+	result = Calculate( "fact(n) = if(n, n * fact(n-1), 1)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "g(n) = fact(n) + 1", state );
+	XCTAssert( ContainsNodeOfType<UserFuncNode>( *state.compiledFunctions[ "g" ].body ) );
+	result = Calculate( "g(5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 121.0 );
+	
+	// Removing the inner function must affect the outer one.
+	result = Calculate( "sq = 3", state );
+	result = Calculate( "hyp(3, 4)", state );
+	XCTAssert( result.type != CalcResultType::value );
+}
+
+- (void) testSpecialization
+{
+	SCalcState state;
+	auto result = Calculate( "p(x, n) = if(n, x * p(x, n-1), 1)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "cube(x) = p(x, 3)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	
+	// The recursion is unrolled, and the resulting small functions inlined.
+	XCTAssertFalse( ContainsNodeOfType<UserFuncNode>( *state.compiledFunctions[ "cube" ].body ) );
+	result = Calculate( "cube(2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 8.0 );
+	
+	// Constant arguments inside an iteration at the top level.
+	result = Calculate( "∑(i, 1, 3, p(i, 2))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 14.0 );
+	
+	// Redefining the callee discards the specializations.
+	result = Calculate( "p(x, n) = if(n, x + p(x, n-1), 0)", state );
+	XCTAssert( result.type == CalcResultType::redefinedFunc );
+	result = Calculate( "cube(2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 6.0 );
+	
+	// Repeating a top-level calculation reuses its specializations.
+	result = Calculate( "∑(i, 1, 3, p(i, 2))", state );
+	const size_t specializationCount = state.specializations.size();
+	result = Calculate( "∑(i, 1, 3, p(i, 2))", state );
+	XCTAssertEqual( result.calculatedValue, 12.0 );
+	XCTAssertEqual( state.specializations.size(), specializationCount );
+	
+	// Many different ones do not use up the limit for later calculations.
+	for (int n = 3; n < 100; ++n)
+	{
+		result = Calculate( "∑(i, 1, 2, p(i, " + std::to_string( n ) + "))", state );
+		XCTAssertEqual( result.calculatedValue, 3.0 * n );
+	}
+	XCTAssertLessThanOrEqual( state.specializations.size(), 64 );
+	result = Calculate( "∑(i, 1, 2, p(i, 150))", state );
+	XCTAssertEqual( result.calculatedValue, 450.0 );
+	XCTAssert( state.specializations.contains( SpecializationKey( "p",
+		{ std::nullopt, 150.0 } ) ) );
+}
+
+- (void) testPolynomial
+{
+	SCalcState state;
+	auto result = Calculate( "p(x) = 3x^4 - 2x^3 + x^2 - 7x + 1", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	const PolynomialNode* poly = dynamic_cast<const PolynomialNode*>(
+		state.compiledFunctions[ "p" ].body.get() );
+	XCTAssert( poly != nullptr );
+	XCTAssert( poly->Coefficients() == std::vector<double>({ 1.0, -7.0, 1.0, -2.0, 3.0 }) );
+	result = Calculate( "p(2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 23.0 );
+	
+	autoCFDictionaryRef theDict( poly->ToDictionary() );
+	autoASTNode rebuilt( BuildTreeFromDictionary( theDict ) );
+	XCTAssert( *rebuilt == *poly );
+	
+	// High enough degree for Estrin's scheme.
+	result = Calculate( "q(x) = x^11 - x^9/2 + 3x^6 + x - 5", state );
+	poly = dynamic_cast<const PolynomialNode*>( state.compiledFunctions[ "q" ].body.get() );
+	XCTAssert( (poly != nullptr) and (poly->Degree() == 11) );
+	for (double x : { -1.5, -0.25, 0.0, 0.75, 2.0 })
+	{
+		double expected = pow( x, 11.0 ) - pow( x, 9.0 ) / 2.0 + 3.0 * pow( x, 6.0 ) + x - 5.0;
+		XCTAssertEqualWithAccuracy( poly->EvaluateAt( x ), expected, 1.0e-12 * fmax( 1.0, fabs( expected ) ) );
+	}
+	
+	// Factored forms are not expanded.
+	result = Calculate( "r(x) = (x - 1)(x + 1)", state );
+	XCTAssert( dynamic_cast<const PolynomialNode*>( state.compiledFunctions[ "r" ].body.get() ) == nullptr );
+	
+	// Polynomials in an index variable, and with a non-constant argument.
+	result = Calculate( "∑(k, 1, 4, 2k^2 + k)", state );
+	XCTAssertEqual( result.calculatedValue, 70.0 );
+	result = Calculate( "s(a) = p(sqrt(a))", state );
+	result = Calculate( "s(4)", state );
+	XCTAssertEqual( result.calculatedValue, 23.0 );
+}
+
+- (void) testRecursionTable
+{
+	SCalcState state;
+	auto result = Calculate( "p(n) = if(n-1, p(n-1) + p(n-2) + p(n-3), 1)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	XCTAssertEqual( state.compiledFunctions[ "p" ].maxRecursionOffset, 3 );
+	result = Calculate( "p(10)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 355.0 );
+	
+	// Far too deep for recursion, but fine for a table.
+	result = Calculate( "p(50000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	
+	result = Calculate( "q(n) = if(n-1, (q(n-1) + q(n-2))/2, n)", state );
+	result = Calculate( "q(50000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.0/3.0, 1.0e-12 );
+	
+	// Large tables are not kept for later calculations.
+	result = Calculate( "q(200000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertGreaterThan( state.recursionTables[ "q" ].values.size(), 100000 );
+	result = Calculate( "q(10)", state );
+	XCTAssertEqual( result.calculatedValue, 0.666015625 );
+	XCTAssertLessThan( state.recursionTables[ "q" ].values.size(), 100 );
+	
+	// Arguments that are not integers work too.
+	result = Calculate( "q(2.5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.25 );
+	
+	// A function that calls another user function does not qualify.
+	result = Calculate( "r(n) = if(n, r(n-1) + q(n), 0)", state );
+	XCTAssertEqual( state.compiledFunctions[ "r" ].maxRecursionOffset, 0 );
+}
+
+- (void) testLinearRecurrence
+{
+	SCalcState state;
+	auto result = Calculate( "fib(n) = if(n-1, fib(n-1) + fib(n-2), n)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	XCTAssert( state.compiledFunctions[ "fib" ].recurrence != nullptr );
+	result = Calculate( "fib(70)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 190392490709135.0 );
+	XCTAssertEqual( state.resultCache.size(), 0 );	// no memo needed
+	
+	result = Calculate( "g(n) = if(n, 2g(n-1) + 1, 0)", state );
+	XCTAssert( state.compiledFunctions[ "g" ].recurrence != nullptr );
+	result = Calculate( "g(40)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 1099511627775.0 );
+	
+	// Arguments that are not integers, or are in the range of the base case,
+	// are evaluated the usual way.
+	result = Calculate( "fib(0.5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.5 );
+	result = Calculate( "fib(3.5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.5 );
+	
+	// Not linear.
+	result = Calculate( "h(n) = if(n, h(n-1) * h(n-1), 2)", state );
+	XCTAssert( state.compiledFunctions[ "h" ].recurrence == nullptr );
+}
+
+- (void) testPrefixSums
+{
+	SCalcState state;
+	auto result = Calculate( "f(k) = k^2", state );
+	result = Calculate( "∑(k, 1, 100, f(k))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 338350.0 );
+	XCTAssertEqual( state.prefixSums.size(), 1 );
+	XCTAssertEqual( state.prefixSums.begin()->second.partials.size(), 100 );
+	
+	// A longer range extends the cached partial sums, a shorter one
+	// just looks them up.
+	result = Calculate( "∑(k, 1, 200, f(k))", state );
+	XCTAssertEqual( result.calculatedValue, 2686700.0 );
+	XCTAssertEqual( state.prefixSums.size(), 1 );
+	XCTAssertEqual( state.prefixSums.begin()->second.partials.size(), 200 );
+	result = Calculate( "∑(k, 1, 50, f(k))", state );
+	XCTAssertEqual( result.calculatedValue, 42925.0 );
+	XCTAssertEqual( state.prefixSums.begin()->second.partials.size(), 200 );
+	
+	// A different start or body gets its own entry.
+	result = Calculate( "∑(k, 2, 100, f(k))", state );
+	XCTAssertEqual( result.calculatedValue, 338349.0 );
+	XCTAssertEqual( state.prefixSums.size(), 2 );
+	
+	// Redefining a function discards the cache.
+	result = Calculate( "f(k) = k", state );
+	XCTAssertEqual( state.prefixSums.size(), 0 );
+	result = Calculate( "∑(k, 1, 100, f(k))", state );
+	XCTAssertEqual( result.calculatedValue, 5050.0 );
+	
+	// Function arguments used by the content are part of the key.
+	result = Calculate( "g(x, n) = ∏(k, 1, n, 1 + x/k)", state );
+	result = Calculate( "g(1, 20)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 21.0, 1.0e-12 );
+	result = Calculate( "g(2, 20)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 231.0, 1.0e-10 );
+	result = Calculate( "g(1, 30)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 31.0, 1.0e-12 );
+	
+	// Long ranges are not kept.
+	result = Calculate( "∑(k, 1, 100000, f(k))", state );
+	XCTAssertEqual( result.calculatedValue, 5000050000.0 );
+	for (const auto& entry : state.prefixSums)
+	{
+		XCTAssertLessThanOrEqual( entry.second.partials.size(), 65536 );
+	}
+}
+
+- (void) testInfiniteSeries
+{
+	SCalcState state;
+	auto result = Calculate( "∑(n, 1, ∞, 1/n^2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, M_PI * M_PI / 6.0, 1.0e-9 );
+	XCTAssert( result.IsApproximate() );
+	XCTAssertLessThan( result.seriesTermCount, 10000 );
+	XCTAssertLessThan( result.seriesErrorEstimate, 1.0e-9 );
+	
+	// Alternating
+	result = Calculate( "∑(n, 1, ∞, (-1)^(n+1)/n)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, log(2.0), 1.0e-9 );
+	XCTAssertLessThan( result.seriesTermCount, 100 );
+	
+	// Geometric
+	result = Calculate( "∑(n, 0, ∞, (1/2)^n)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.0, 1.0e-12 );
+	
+	// Product
+	result = Calculate( "∏(n, 2, ∞, 1 - 1/n^2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 0.5, 1.0e-9 );
+	
+	// Explicit tolerance
+	result = Calculate( "∑(n, 1, ∞, (-1)^(n+1)/(2n-1), 1e-4)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, M_PI / 4.0, 1.0e-4 );
+	result = Calculate( "∑(n, 1, ∞, (-1)^(n+1)/(2n-1), 0)", state );
+	XCTAssert( result.type != CalcResultType::value );
+	
+	// Divergent
+	result = Calculate( "∑(n, 1, ∞, 1/n)", state );
+	XCTAssert( result.type != CalcResultType::value );
+	
+	// Divergent alternating series have estimates that settle down, at the
+	// Abel sum, but their terms do not shrink to 0.
+	result = Calculate( "∑(n, 1, ∞, (-1)^n)", state );
+	XCTAssert( result.type != CalcResultType::value );
+	result = Calculate( "∑(n, 1, ∞, (-1)^n n)", state );
+	XCTAssert( result.type != CalcResultType::value );
+	result = Calculate( "∑(n, 1, ∞, (-1)^n (1 + 1/n))", state );
+	XCTAssert( result.type != CalcResultType::value );
+	
+	// Alternating terms that get too small to change the partial sums
+	result = Calculate( "∑(n, 1, ∞, (-1)^n/n^n)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, -0.78343051071213440, 1.0e-12 );
+	
+	// Leading zero terms must not pass for convergence.
+	result = Calculate( "∑(n, 1, ∞, if(n-20, 1/n^2, 0))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	double firstTerms = 0.0;
+	for (int n = 1; n <= 20; ++n)
+	{
+		firstTerms += 1.0 / (n * n);
+	}
+	XCTAssertEqualWithAccuracy( result.calculatedValue,
+		M_PI * M_PI / 6.0 - firstTerms, 1.0e-9 );
+	XCTAssertGreaterThan( result.seriesTermCount, 20 );
+	result = Calculate( "∑(n, 1, ∞, 0)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.0 );
+	
+	// Finite bounds are not approximate.
+	result = Calculate( "∑(n, 1, 20, (1/2)^n)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertFalse( result.IsApproximate() );
+	
+	// Inside a function
+	result = Calculate( "zeta(s) = ∑(n, 1, ∞, n^(-s))", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "zeta(4)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, pow( M_PI, 4.0 ) / 90.0, 1.0e-9 );
+	XCTAssert( result.IsApproximate() );
+}
+
+- (void) testIterationFusion
+{
+	SCalcState state;
+	auto result = Calculate( "∑(i, 1, 3, ∑(j, 1, 4, i j))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 60.0 );
+	const FusedIterationNode* fused = dynamic_cast<const FusedIterationNode*>(
+		state.valStack.top().get() );
+	XCTAssert( fused != nullptr );
+	
+	// Fused nodes are recorded as the original nested iterations.
+	autoCFDictionaryRef theDict( fused->ToDictionary() );
+	autoASTNode rebuilt( BuildTreeFromDictionary( theDict ) );
+	XCTAssert( *rebuilt == *fused->Unfuse() );
+	
+	result = Calculate( "∏(i, 1, 3, ∏(j, 1, 2, ∏(k, 1, 2, i)))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 1.0 * 16.0 * 81.0 );
+	fused = dynamic_cast<const FusedIterationNode*>( state.valStack.top().get() );
+	XCTAssert( (fused != nullptr) and (fused->Variables().size() == 3) );
+	
+	result = Calculate( "∑(i, 1, 3, ∑(j, 5, 1, 1))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.0 );
+	
+	// An empty outer range gives the identity, even if the inner bounds
+	// can not be evaluated.
+	result = Calculate( "∑(i, 1, 0, ∑(j, 1, ∑(k, 1, ∞, 1/k), 1))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.0 );
+	
+	// Not fused: inner bounds depend on the outer index, or kinds differ.
+	result = Calculate( "∑(i, 1, 4, ∑(j, 1, i, 1))", state );
+	XCTAssertEqual( result.calculatedValue, 10.0 );
+	XCTAssert( dynamic_cast<const FusedIterationNode*>( state.valStack.top().get() ) == nullptr );
+	result = Calculate( "∑(i, 1, 2, ∏(j, 1, 3, i))", state );
+	XCTAssertEqual( result.calculatedValue, 9.0 );
+	XCTAssert( dynamic_cast<const FusedIterationNode*>( state.valStack.top().get() ) == nullptr );
+	
+	// A function that uses the same index variable name does not disturb
+	// the outer iteration.
+	result = Calculate( "h(x) = ∑(i, 1, x, i)", state );
+	result = Calculate( "∑(i, 1, 3, ∑(j, 1, 2, i h(j)))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 24.0 );
+	
+	// Tiled, since the content calls a user function.
+	result = Calculate( "c(n) = if(n, c(n-1) + 1, 0)", state );
+	result = Calculate( "∑(i, 0, 49, ∑(j, 0, 49, c(i + j)))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 122500.0 );
+	
+	
+	// Terms are added in the same order as by the nested iterations, so
+	// the result is the same to the last bit.
+	result = Calculate( "w(x) = ∑(k, 1, 3, 1/(x + k))", state );
+	result = Calculate( "∑(i, 1, 70, ∑(j, 1, 70, w(i + j/7)))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	fused = dynamic_cast<const FusedIterationNode*>( state.valStack.top().get() );
+	XCTAssert( fused != nullptr );
+	const double sequentialValue = result.calculatedValue;
+	XCTAssertEqual( sequentialValue, fused->Unfuse()->Evaluate( state ).value_or( 0.0 ) );
+	
+	SCalcState parallelState;
+	parallelState.SetEvaluationThreadCount( 4 );
+	result = Calculate( "c(n) = if(n, c(n-1) + 1, 0)", parallelState );
+	result = Calculate( "∑(i, 0, 49, ∑(j, 0, 49, c(i + j)))", parallelState );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 122500.0 );
+	
+	// In parallel, the outermost sum is grouped by chunks, which can change
+	// the last bits.
+	result = Calculate( "w(x) = ∑(k, 1, 3, 1/(x + k))", parallelState );
+	result = Calculate( "∑(i, 1, 70, ∑(j, 1, 70, w(i + j/7)))", parallelState );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, sequentialValue,
+		1.0e-13 * sequentialValue );
+}
+
+- (void) testTabulate
+{
+	SCalcState state;
+	auto result = Calculate( "g(x) = ∑(k, 1, 50, cos(k x)/k^3)", state );
+	result = Calculate( "tabulate(g, 0, 2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertLessThan( result.calculatedValue, 1.0e-12 );
+	XCTAssertEqual( state.tabulations.size(), 1 );
+	XCTAssertGreaterThan( state.tabulations["g"].approximant->PieceCount(), 1 );
+	
+	double expected = 0.0;
+	for (int k = 1; k <= 50; ++k)
+	{
+		expected += cos( k * 1.3 ) / (k * k * k);
+	}
+	result = Calculate( "g(1.3)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, expected, 1.0e-12 );
+	
+	// Outside the interval, the function is evaluated as usual.
+	result = Calculate( "g(0)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 1.20186086316, 1.0e-10 );
+	
+	// A coarser tolerance needs fewer pieces.
+	size_t finePieces = state.tabulations["g"].approximant->PieceCount();
+	result = Calculate( "tabulate(g, 0, 2, 1e-6)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertLessThan( result.calculatedValue, 1.0e-5 );
+	XCTAssertLessThan( state.tabulations["g"].approximant->PieceCount(), finePieces );
+	
+	// Redefining a function discards the approximations that depend on it.
+	result = Calculate( "h(x) = x^2", state );
+	result = Calculate( "u(x) = exp(h(x))", state );
+	result = Calculate( "tabulate(u, -1, 1)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( state.tabulations.size(), 2 );
+	result = Calculate( "v(x) = x", state );
+	XCTAssertEqual( state.tabulations.size(), 2 );
+	result = Calculate( "h(x) = x^3", state );
+	XCTAssertEqual( state.tabulations.size(), 1 );
+	XCTAssert( state.tabulations.contains( "g" ) );
+	result = Calculate( "u(0.5)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, exp(0.125), 1.0e-15 );
+	
+	// A caller defined earlier, which had the function inlined, now uses
+	// the approximation.
+	result = Calculate( "t(x) = x^2 + 1", state );
+	result = Calculate( "c(x) = 2 t(x)", state );
+	XCTAssertFalse( ContainsNodeOfType<UserFuncNode>( *state.compiledFunctions[ "c" ].body ) );
+	result = Calculate( "tabulate(t, 0, 1)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssert( ContainsNodeOfType<UserFuncNode>( *state.compiledFunctions[ "c" ].body ) );
+	result = Calculate( "c(0.5)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.5, 1.0e-12 );
+	
+	// Errors
+	result = Calculate( "tabulate(g, 2, 0)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "s(x) = sqrt(x)", state );
+	result = Calculate( "tabulate(s, -1, 1)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "w(x, y) = x y", state );
+	result = Calculate( "tabulate(w, 0, 1)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "tabulate = 3", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testDerivative
+{
+	SCalcState state;
+	auto result = Calculate( "f(x) = x sin(x)", state );
+	result = Calculate( "deriv(f, 0.5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue,
+		sin(0.5) + 0.5 * cos(0.5), 1.0e-15 );
+	
+	// Polynomials, n-ary functions, and constants
+	result = Calculate( "p(x) = 3x^3 - 2x + 1", state );
+	result = Calculate( "deriv(p, 2)", state );
+	XCTAssertEqual( result.calculatedValue, 34.0 );
+	result = Calculate( "m(x) = max(x, 2x, 3)", state );
+	result = Calculate( "deriv(m, 2)", state );
+	XCTAssertEqual( result.calculatedValue, 2.0 );
+	result = Calculate( "a(x) = average(x, x^2)", state );
+	result = Calculate( "deriv(a, 3)", state );
+	XCTAssertEqual( result.calculatedValue, 3.5 );
+	result = Calculate( "c(x) = 7", state );
+	result = Calculate( "deriv(c, 3)", state );
+	XCTAssertEqual( result.calculatedValue, 0.0 );
+	
+	// Order statistics
+	result = Calculate( "md(x) = median(x, 2x, 3x, 4x)", state );
+	result = Calculate( "deriv(md, 1)", state );
+	XCTAssertEqual( result.calculatedValue, 2.5 );
+	result = Calculate( "qt(x) = quantile(x, 0, 10, 20)", state );
+	result = Calculate( "deriv(qt, 0.25)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 20.0, 1.0e-12 );
+	result = Calculate( "pc(x) = percentile(50, x, 3x, 5x)", state );
+	result = Calculate( "deriv(pc, 1)", state );
+	XCTAssertEqual( result.calculatedValue, 3.0 );
+	result = Calculate( "iq(x) = IQR(x, 2x, 3x, 4x, 5x)", state );
+	result = Calculate( "deriv(iq, 1)", state );
+	XCTAssertEqual( result.calculatedValue, 2.0 );
+	result = Calculate( "dev(x) = MAD(x, 2x, 4x)", state );
+	result = Calculate( "deriv(dev, 1)", state );
+	XCTAssertEqual( result.calculatedValue, 1.0 );
+	
+	// Sums, including infinite ones
+	result = Calculate( "s(x) = ∑(k, 1, 10, x^k)", state );
+	result = Calculate( "deriv(s, 1)", state );
+	XCTAssertEqual( result.calculatedValue, 55.0 );
+	result = Calculate( "L(x) = ∑(k, 1, ∞, x^k/k^2)", state );
+	result = Calculate( "deriv(L, 0.5)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.0 * log(2.0), 1.0e-10 );
+	
+	// Recursive and nested user functions
+	result = Calculate( "pw(n, x) = if(n, x pw(n-1, x), 1)", state );
+	result = Calculate( "q(x) = pw(5, x)", state );
+	result = Calculate( "deriv(q, 2)", state );
+	XCTAssertEqual( result.calculatedValue, 80.0 );
+	result = Calculate( "d(x) = 2 deriv(f, x)", state );
+	result = Calculate( "d(0.5)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue,
+		2.0 * (sin(0.5) + 0.5 * cos(0.5)), 1.0e-15 );
+	
+	// Errors
+	result = Calculate( "deriv(d, 0.5)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+	result = Calculate( "deriv(pw, 1)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "deriv(sin, 1)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "deriv = 3", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testIntegration
+{
+	SCalcState state;
+	auto result = Calculate( "∫(x, 0, 1, 4/(1+x^2))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, M_PI, 1.0e-13 );
+	XCTAssert( result.IsApproximate() );
+	XCTAssertEqual( result.seriesTermCount, 0 );
+	XCTAssertGreaterThan( result.integrandEvaluationCount, 0 );
+	XCTAssertLessThan( result.integrationErrorEstimate, 1.0e-10 );
+	
+	// Singularities at the limits, and infinite limits
+	result = Calculate( "integrate(x, 0, 1, 1/sqrt(x))", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.0, 1.0e-13 );
+	result = Calculate( "∫(x, 0, 1, ln(x))", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, -1.0, 1.0e-13 );
+	result = Calculate( "∫(x, -∞, ∞, exp(-x^2))", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, sqrt(M_PI), 1.0e-12 );
+	result = Calculate( "∫(x, 1, ∞, 1/x^2)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 1.0, 1.0e-13 );
+	
+	// Reversed limits, and a tolerance
+	result = Calculate( "∫(x, 1, 0, x^2)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, -1.0/3.0, 1.0e-15 );
+	result = Calculate( "∫(x, 0, π, sin(x), 1e-4)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 2.0, 1.0e-4 );
+	
+	// In function definitions, and differentiated
+	result = Calculate( "F(t) = ∫(x, 0, t, exp(-x^2))", state );
+	result = Calculate( "F(1)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue,
+		0.5 * sqrt(M_PI) * erf(1.0), 1.0e-13 );
+	result = Calculate( "deriv(F, 1)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, exp(-1.0), 1.0e-13 );
+	result = Calculate( "G(a) = ∫(x, 0, 1, exp(a x))", state );
+	result = Calculate( "deriv(G, 1)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 1.0, 1.0e-12 );
+	
+	// Errors
+	result = Calculate( "∫(x, 0, 1, 1/x)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+	result = Calculate( "∫(x, 0, 1, x, 0)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+}
+
+- (void) testSolve
+{
+	SCalcState state;
+	auto result = Calculate( "solve(x, 0, 1, cos(x) - x)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 0.739085133215161, 1.0e-15 );
+	XCTAssert( result.IsApproximate() );
+	XCTAssertGreaterThan( result.solverEvaluationCount, 0 );
+	result = Calculate( "solve(x, 0, 2, x^2 - 2)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, M_SQRT2, 1.0e-15 );
+	
+	// No change of sign at the ends, a sum in the expression, and a tolerance
+	result = Calculate( "solve(x, -1, 1, x^2 - 0.25)", state );
+	XCTAssertEqualWithAccuracy( fabs( result.calculatedValue ), 0.5, 1.0e-15 );
+	result = Calculate( "solve(x, 0, 1, ∑(k, 1, 3, x^k) - 1)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 0.543689012692076, 1.0e-15 );
+	result = Calculate( "solve(x, 3, 4, sin(x), 1e-3)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, M_PI, 1.0e-3 );
+	
+	// In function definitions, and differentiated
+	result = Calculate( "Root(a) = solve(x, 0, a, x^2 - a)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "Root(9)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 3.0, 1.0e-15 );
+	result = Calculate( "deriv(Root, 4)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 0.25, 1.0e-14 );
+	
+	// Errors
+	result = Calculate( "solve(x, -1, 2, 1/x)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+	result = Calculate( "solve(x, -1, 1, x^2 + 1)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+	result = Calculate( "solve(x, 0, 1, x - 0.5, -1)", state );
+	XCTAssert( result.type == CalcResultType::undefined );
+}
+
+- (void) testMinimize
+{
+	SCalcState state;
+	auto result = Calculate( "Cost(x, y) = (x - 1)^2 + 2(y + 0.5)^2 + 3", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "minimize(Cost, 0, 0)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 3.0, 1.0e-14 );
+	XCTAssert( result.IsApproximate() );
+	XCTAssertGreaterThan( result.minimizerEvaluationCount, 0 );
+	XCTAssertEqual( result.minimumLocation.size(), 2 );
+	XCTAssertEqualWithAccuracy( result.minimumLocation[0], 1.0, 1.0e-6 );
+	XCTAssertEqualWithAccuracy( result.minimumLocation[1], -0.5, 1.0e-6 );
+	
+	// Over an interval, where a start from 0 would find the other minimum
+	result = Calculate( "g(t) = t^4 - 3t^2 + t", state );
+	result = Calculate( "minimize(g, -2, 2)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, -3.513905038934, 1.0e-11 );
+	XCTAssertEqual( result.minimumLocation.size(), 1 );
+	XCTAssertEqualWithAccuracy( result.minimumLocation[0], -1.300839566, 1.0e-6 );
+	
+	// Over a box, on several threads
+	state.SetEvaluationThreadCount( 4 );
+	result = Calculate( "h(x, y) = (x^2 - 1)^2 + (y - x)^2 + 0.1 x", state );
+	result = Calculate( "minimize(h, -2, 2, -2, 2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertLessThan( result.minimumLocation[0], 0.0 );
+	double parallelValue = result.calculatedValue;
+	state.SetEvaluationThreadCount( 1 );
+	result = Calculate( "minimize(h, -2, 2, -2, 2)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, parallelValue, 1.0e-14 );
+	
+	// Errors
+	result = Calculate( "minimize(Cost, 0)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "minimize(nothing, 0)", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testTable
+{
+	SCalcState state;
+	auto result = Calculate( "table(x, 0, 1, 0.25, x^2)", state );
+	XCTAssert( result.type == CalcResultType::table );
+	XCTAssertEqual( result.tableRows.size(), 5 );
+	XCTAssertEqual( result.tableRows[4].first, 1.0 );
+	XCTAssertEqual( result.tableRows[3].second, 0.5625 );
+	
+	// Counting down, with a step that does not divide the interval
+	result = Calculate( "f(t) = 1 / t", state );
+	result = Calculate( "  table(s, 1, -1.2, -0.5, f(s))", state );
+	XCTAssert( result.type == CalcResultType::table );
+	XCTAssertEqual( result.tableRows.size(), 5 );
+	XCTAssertEqual( result.tableRows[1].second, 2.0 );
+	XCTAssertEqual( result.tableRows[4].first, -1.0 );
+	
+	// A long table, on several threads
+	state.SetEvaluationThreadCount( 4 );
+	result = Calculate( "table(k, 1, 10000, 1, ∑(j, 1, k, j))", state );
+	XCTAssert( result.type == CalcResultType::table );
+	XCTAssertEqual( result.tableRows.size(), 10000 );
+	for (const auto& [k, sum] : result.tableRows)
+	{
+		XCTAssertEqual( sum, k * (k + 1) / 2 );
+	}
+	state.SetEvaluationThreadCount( 1 );
+	
+	// Errors
+	result = Calculate( "table(x, 0, 1, 0, x)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "table(x, 0, 1, -0.5, x)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "table(x, 0, 1, 1e-6, x)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "table(x, 0, x, 0.5, x)", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testShadowedBuiltIns
+{
+	// Documents written before table, deriv, solve, and the like were built
+	// in may define functions and variables with those names.  Such a
+	// definition takes precedence over the built-in meaning.
+	SCalcState state;
+	auto result = Calculate( "table(x) = 2x", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "table(3)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 6.0 );
+	result = Calculate( "table(x, 0, 1, 0.5, x)", state );
+	XCTAssert( result.type == CalcResultType::error );
+	
+	result = Calculate( "solve(a, b) = a - b", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "solve(5, 2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 3.0 );
+	result = Calculate( "integrate(t) = t^2", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "integrate(3)", state );
+	XCTAssertEqual( result.calculatedValue, 9.0 );
+	
+	// A variable does not hide a built-in function, since it can not be
+	// followed by a parenthesis.
+	result = Calculate( "deriv = 4", state );
+	XCTAssert( result.type == CalcResultType::value );
+	result = Calculate( "deriv + 1", state );
+	XCTAssertEqual( result.calculatedValue, 5.0 );
+	result = Calculate( "p(x) = 3x^3 - 2x + 1", state );
+	result = Calculate( "deriv(p, 2)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 34.0 );
+	
+	// Except for a table statement, which is taken as an expression.
+	SCalcState other;
+	result = Calculate( "table = 3", other );
+	XCTAssert( result.type == CalcResultType::value );
+	result = Calculate( "table(2)", other );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 6.0 );
+	
+	// Names that were always built in stay reserved.
+	result = Calculate( "if(x) = x", state );
+	XCTAssert( result.type == CalcResultType::error );
+	result = Calculate( "summation = 1", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testAdaptivePrecision
+{
+	SCalcState state;
+	auto result = Calculate( "(1e16 + 1) - 1e16", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 0.0 );
+	XCTAssertFalse( result.isExtendedPrecision );
+	
+	state.precisionTolerance = 1.0e-12;
+	result = Calculate( "(1e16 + 1) - 1e16", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 1.0 );
+	XCTAssert( result.isExtendedPrecision );
+	XCTAssertGreaterThan( result.roundingErrorBound, 0.5 );
+	
+	result = Calculate( "sum(1e16 + 1, 1, -1e16)", state );
+	XCTAssertEqual( result.calculatedValue, 2.0 );
+	XCTAssert( result.isExtendedPrecision );
+	
+	result = Calculate( "1 - cos(1e-8)", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 5.0e-17, 1.0e-30 );
+	XCTAssert( result.isExtendedPrecision );
+	
+	// Intermediate overflow.
+	result = Calculate( "1e300 * 1e300 / 1e300", state );
+	XCTAssertEqualWithAccuracy( result.calculatedValue, 1.0e300, 1.0e286 );
+	
+	// Well conditioned statements stay in double precision.
+	result = Calculate( "x = 2 sin(0.5) + 3", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertFalse( result.isExtendedPrecision );
+	XCTAssertLessThan( result.roundingErrorBound, 1.0e-14 );
+	XCTAssertEqual( state.variables[ "x" ], 2.0 * sin( 0.5 ) + 3.0 );
+	
+	// An assignment keeps the improved value.
+	result = Calculate( "y = (1e16 + 1) - 1e16", state );
+	XCTAssertEqual( state.variables[ "y" ], 1.0 );
+	
+	// Parse errors are reported as usual.
+	result = Calculate( "(1e16 + 1 - 1e16", state );
+	XCTAssert( result.type == CalcResultType::error );
+}
+
+- (void) testVectorMath
+{
+	// Accuracy is checked on random bit patterns, which cover the whole
+	// range of doubles, and on uniform samples of ordinary arguments.
+	const size_t kSampleCount = 1000000;
+	std::mt19937_64 generator( 20261019 );
+	std::uniform_real_distribution<double> ordinary( -100.0, 100.0 );
+	std::uniform_real_distribution<double> exponents( -30.0, 30.0 );
+	std::vector<double> xs{ 0.0, -0.0, INFINITY, -INFINITY, NAN, 1.0, -1.0,
+		0x1p-1074, DBL_MIN, DBL_MAX, M_PI, 709.78, -745.1 };
+	std::vector<double> ys( xs.size(), 2.0 );
+	while (xs.size() < kSampleCount)
+	{
+		const bool randomBits = (xs.size() % 2 == 0);
+		xs.push_back( randomBits? std::bit_cast<double>( generator() ) :
+			ordinary( generator ) );
+		ys.push_back( randomBits? exponents( generator ) :
+			std::bit_cast<double>( generator() ) );
+	}
+	
+	std::vector<double> reference( kSampleCount ), fast( kSampleCount );
+	const auto maxDistance = [&]() -> double
+	{
+		double result = 0.0;
+		for (size_t i = 0; i < kSampleCount; ++i)
+		{
+			result = std::max( result, UlpDistance( fast[i], reference[i] ) );
+		}
+		return result;
+	};
+	
+	// The error bounds are relative to the exact results, which we compute
+	// to 50 digits for part of the samples.  Special values, and arguments
+	// that are passed to the C library, are left to the comparison with the
+	// C library.
+	const size_t kExactCount = 20000;
+	const struct
+	{
+		const char*	name;
+		UnaryFunc	libm;
+		void		(*vector)( const double*, double*, size_t );
+		Exact		(*exact)( const Exact& );
+		double		maxArgument;
+	} unaryFuncs[] =
+	{
+		{ "sin", ::sin, VectorSin,
+			[]( const Exact& x ) -> Exact { return sin( x ); }, 0x1p19 * M_PI },
+		{ "cos", ::cos, VectorCos,
+			[]( const Exact& x ) -> Exact { return cos( x ); }, 0x1p19 * M_PI },
+		{ "exp", ::exp, VectorExp,
+			[]( const Exact& x ) -> Exact { return exp( x ); }, INFINITY },
+		{ "log", ::log, VectorLog,
+			[]( const Exact& x ) -> Exact { return log( x ); }, INFINITY }
+	};
+	
+	for (const auto& func : unaryFuncs)
+	{
+		std::transform( xs.begin(), xs.end(), reference.begin(), func.libm );
+		func.vector( xs.data(), fast.data(), kSampleCount );
+		
+		double maxError = 0.0;
+		for (size_t i = 0; i < kExactCount; ++i)
+		{
+			if ( isfinite( reference[i] ) and (reference[i] != 0.0) and
+				(fabs( xs[i] ) <= func.maxArgument) )
+			{
+				maxError = std::max( maxError,
+					UlpError( fast[i], func.exact( Exact( xs[i] ) ) ) );
+			}
+		}
+		XCTAssertLessThan( maxError, 1.0, @"%s", func.name );
+		XCTAssertLessThanOrEqual( maxDistance(), 1.0, @"%s", func.name );
+	}
+	
+	std::transform( xs.begin(), xs.end(), ys.begin(), reference.begin(),
+		[]( double x, double y ) { return ::pow( x, y ); } );
+	VectorPow( xs.data(), ys.data(), fast.data(), kSampleCount );
+	double maxError = 0.0;
+	for (size_t i = 0; i < kExactCount; ++i)
+	{
+		if ( isfinite( reference[i] ) and (reference[i] != 0.0) and
+			(xs[i] > 0.0) and (fabs( ys[i] ) <= 0x1p900) )
+		{
+			maxError = std::max( maxError,
+				UlpError( fast[i], pow( Exact( xs[i] ), Exact( ys[i] ) ) ) );
+		}
+	}
+	XCTAssertLessThan( maxError, 1.0, @"pow" );
+	XCTAssertLessThanOrEqual( maxDistance(), 1.0, @"pow" );
+	
+	// Exact powers come out exact.
+	const double bases[] = { 10.0, 2.0, 3.0, 1.5, 49.0, 7.0 };
+	const double powers[] = { 2.0, -3.0, 20.0, 2.0, 0.5, 18.0 };
+	double results[6];
+	VectorPow( bases, powers, results, 6 );
+	XCTAssertEqual( results[0], 100.0 );
+	XCTAssertEqual( results[1], 0.125 );
+	XCTAssertEqual( results[2], 3486784401.0 );
+	XCTAssertEqual( results[3], 2.25 );
+	XCTAssertEqual( results[4], 7.0 );
+	XCTAssertEqual( results[5], 1628413597910449.0 );
+}
+
+// Speed is measured on the kind of arguments that do not need the C library
+// as a fallback.  The same work done by the C library is measured by
+// testLibmMathPerformance, for comparison.
+- (void) testVectorMathPerformance
+{
+	const size_t kSampleCount = 1000000;
+	std::mt19937_64 generator( 20261019 );
+	std::uniform_real_distribution<double> positive( 0.001, 100.0 );
+	std::uniform_real_distribution<double> exponents( -30.0, 30.0 );
+	std::vector<double> xs( kSampleCount ), ys( kSampleCount ), results( kSampleCount );
+	for (size_t i = 0; i < kSampleCount; ++i)
+	{
+		xs[i] = positive( generator );
+		ys[i] = exponents( generator );
+	}
+	
+	// Blocks can not capture vectors without copying them.
+	const double* xPtr = xs.data();
+	const double* yPtr = ys.data();
+	double* resultPtr = results.data();
+	[self measureBlock:^{
+		VectorSin( xPtr, resultPtr, kSampleCount );
+		VectorCos( xPtr, resultPtr, kSampleCount );
+		VectorExp( xPtr, resultPtr, kSampleCount );
+		VectorLog( xPtr, resultPtr, kSampleCount );
+		VectorPow( xPtr, yPtr, resultPtr, kSampleCount );
+		XCTAssert( isfinite( resultPtr[0] ) );
+	}];
+}
+
+- (void) testLibmMathPerformance
+{
+	const size_t kSampleCount = 1000000;
+	std::mt19937_64 generator( 20261019 );
+	std::uniform_real_distribution<double> positive( 0.001, 100.0 );
+	std::uniform_real_distribution<double> exponents( -30.0, 30.0 );
+	std::vector<double> xs( kSampleCount ), ys( kSampleCount ), results( kSampleCount );
+	for (size_t i = 0; i < kSampleCount; ++i)
+	{
+		xs[i] = positive( generator );
+		ys[i] = exponents( generator );
+	}
+	
+	const UnaryFunc funcs[] = { ::sin, ::cos, ::exp, ::log };
+	std::span<const UnaryFunc> funcList( funcs );
+	const double* xPtr = xs.data();
+	const double* yPtr = ys.data();
+	double* resultPtr = results.data();
+	[self measureBlock:^{
+		for (UnaryFunc func : funcList)
+		{
+			std::transform( xPtr, xPtr + kSampleCount, resultPtr, func );
+		}
+		std::transform( xPtr, xPtr + kSampleCount, yPtr, resultPtr,
+			[]( double x, double y ) { return ::pow( x, y ); } );
+		XCTAssert( isfinite( resultPtr[0] ) );
+	}];
+}
+
+- (void) testFastTranscendentals
+{
+	SCalcState state;
+	
+	// By default, batch evaluation gives the results of the C library.
+	auto result = Calculate( "table(x, 0, 1, 0.125, sin(x))", state );
+	XCTAssert( result.type == CalcResultType::table );
+	for (const auto& [x, y] : result.tableRows)
+	{
+		XCTAssertEqual( y, sin( x ) );
+	}
+	state.fastTranscendentals = true;
+	result = Calculate( "table(x, 0, 1, 0.125, sin(x))", state );
+	for (const auto& [x, y] : result.tableRows)
+	{
+		XCTAssertLessThanOrEqual( UlpDistance( y, sin( x ) ), 1.0 );
+	}
+	
+	// Both modes agree closely on longer expressions, also on several
+	// threads.
+	const char* tableText = "table(x, -10, 10, 0.001, sin(x) cos(2x) + "
+		"exp(-x^2 / 2) + ln(1 + x^2) + (1 + x^2)^0.3)";
+	state.fastTranscendentals = false;
+	auto reference = Calculate( tableText, state );
+	state.fastTranscendentals = true;
+	state.SetEvaluationThreadCount( 4 );
+	result = Calculate( tableText, state );
+	state.SetEvaluationThreadCount( 1 );
+	XCTAssert( result.type == CalcResultType::table );
+	XCTAssertEqual( result.tableRows.size(), reference.tableRows.size() );
+	for (size_t i = 0; i < result.tableRows.size(); ++i)
+	{
+		const double expected = reference.tableRows[i].second;
+		XCTAssertEqual( result.tableRows[i].first, reference.tableRows[i].first );
+		XCTAssertEqualWithAccuracy( result.tableRows[i].second, expected,
+			1.0e-14 * std::max( 1.0, fabs( expected ) ) );
+	}
+	
+	// Integrands are evaluated in batches too.
+	result = Calculate( "integrate(x, 0, 1, exp(-x^2))", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqualWithAccuracy( result.calculatedValue,
+		0.5 * sqrt( M_PI ) * erf( 1.0 ), 1.0e-10 );
+}
+
+- (void) testParallelEvaluation
+{
+	SCalcState state;
+	state.SetEvaluationThreadCount( 4 );
+	auto result = Calculate( "fib(n) = if(n-1, fib(n-1) + fib(n-2), n)", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "fib(40)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, 102334155.0 );
+	
+	result = Calculate( "g(n, k) = ∑(i, 1, k, sin(i + n))", state );
+	result = Calculate( "h(k) = sum(g(1, k), g(2, k), g(3, k), g(4, k))", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	result = Calculate( "h(1000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	double parallelValue = result.calculatedValue;
+	
+	// A user function call is expensive enough to spawn by default, a
+	// little arithmetic is not, and the threshold can be raised.
+	autoASTNode hBody( std::get<autoASTNode>( state.userFunctions[ "h" ] ) );
+	XCTAssert( EstimateCost( *hBody->Children()[0] ) >=
+		state.parallelEvaluator->MinSpawnCost() );
+	autoASTNode cheap( MakeNode<NumberNode>( 2.0 ) );
+	XCTAssert( EstimateCost( *cheap ) < state.parallelEvaluator->MinSpawnCost() );
+	state.parallelEvaluator->SetMinSpawnCost( INFINITY );
+	XCTAssertFalse( state.parallelEvaluator->ShouldSpawn( state, hBody->Children() ) );
+	result = Calculate( "h(1000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, parallelValue );
+	
+	state.SetEvaluationThreadCount( 1 );
+	result = Calculate( "h(1000)", state );
+	XCTAssert( result.type == CalcResultType::value );
+	XCTAssertEqual( result.calculatedValue, parallelValue );
+	
+	// The stack limit still applies on worker threads.
+	state.SetEvaluationThreadCount( 4 );
+	result = Calculate( "deep(n) = if(n, 1 + deep(n-1), 0) + if(n, deep(n-1), 0)", state );
+	result = Calculate( "deep(100000)", state );
+	XCTAssert( result.type == CalcResultType::interrupt );
+	
+	// Exceptions thrown by tasks reach the thread that waits for them,
+	// after the other tasks are done.
+	WorkStealingPool pool( 3, 0 );
+	std::atomic<int> finishedCount{ 0 };
+	std::vector< WorkStealingPool::autoTask > tasks;
+	for (int i = 0; i < 8; ++i)
+	{
+		tasks.push_back( pool.Spawn( [&finishedCount, i]()
+			{
+				finishedCount += 1;
+				if (i == 3)
+				{
+					throw std::bad_alloc();
+				}
+			} ) );
+	}
+	bool didThrow = false;
+	try
+	{
+		pool.WaitAll( tasks );
+	}
+	catch (const std::bad_alloc&)
+	{
+		didThrow = true;
+	}
+	XCTAssert( didThrow );
+	XCTAssertEqual( finishedCount.load(), 8 );
+}
+
+// Measure a sum of 8 independent iterations using the given number of
+// threads, so that the measurements at 1, 2, 4, ... threads show how the
+// parallel evaluation scales.
+- (void) measureParallelWithThreads: (unsigned int) inThreadCount
+{
+	XCTSkipIf( inThreadCount > std::max( 1U, std::thread::hardware_concurrency() ),
+		@"Only %u cores", std::thread::hardware_concurrency() );
+	
+	SCalcState state;
+	state.SetEvaluationThreadCount( inThreadCount );
+	auto result = Calculate( "g(n, k) = ∑(i, 1, k, sin(i + n))", state );
+	result = Calculate( "h(k) = sum(g(1, k), g(2, k), g(3, k), g(4, k), "
+		"g(5, k), g(6, k), g(7, k), g(8, k))", state );
+	XCTAssert( result.type == CalcResultType::definedFunc );
+	
+	// Blocks can not copy a state, so they capture a pointer to it.
+	SCalcState* statePtr = &state;
+	[self measureBlock:^{
+		auto result = Calculate( "h(200000)", *statePtr );
+		XCTAssert( result.type == CalcResultType::value );
+	}];
+}
+
+- (void) testParallelPerformance1
+{
+	[self measureParallelWithThreads: 1];
+}
+
+- (void) testParallelPerformance2
+{
+	[self measureParallelWithThreads: 2];
+}
+
+- (void) testParallelPerformance4
+{
+	[self measureParallelWithThreads: 4];
+}
+
+- (void) testParallelPerformance8
+{
+	[self measureParallelWithThreads: 8];
+}
+
+- (void) testParallelPerformance16
+{
+	[self measureParallelWithThreads: 16];
+}
+
+- (void) testParallelPerformanceAllCores
+{
+	[self measureParallelWithThreads:
+		std::max( 1U, std::thread::hardware_concurrency() )];
+}
+
+// Check the reductions on a list of the given length, and measure them.
+// Short lists are reduced repeatedly, so that each measurement covers about
+// a million values.
+- (void) measureReductionsOfLength: (size_t) inLength
+{
+	const NaryFunc funcs[] =
+	{
+		Sum, Product, Min, Max, Average, HarmonicMean
+	};
+	std::vector<double> args( inLength );
+	for (size_t i = 0; i < inLength; ++i)
+	{
+		args[i] = 1.0 + 1.0e-6 * (i % 1000);
+	}
+	for (NaryFunc func : funcs)
+	{
+		XCTAssert( isfinite( func( args ) ) );
+	}
+	XCTAssertEqual( Min( args ), 1.0 );
+	XCTAssertEqual( Max( args ), 1.0 + 1.0e-6 * std::min<size_t>( inLength - 1, 999 ) );
+	
+	// Blocks can not capture arrays, so they capture spans of them.
+	std::span<const NaryFunc> funcList( funcs );
+	std::span<const double> argList( args );
+	const size_t repetitions = std::max<size_t>( 1, 1000000 / inLength );
+	[self measureBlock:^{
+		double total = 0.0;
+		for (size_t r = 0; r < repetitions; ++r)
+		{
+			for (NaryFunc func : funcList)
+			{
+				total += func( argList );
+			}
+		}
+		XCTAssert( isfinite( total ) );
+	}];
+}
+
+- (void) testReductionPerformance4
+{
+	[self measureReductionsOfLength: 4];
+}
+
+- (void) testReductionPerformance64
+{
+	[self measureReductionsOfLength: 64];
+}
+
+- (void) testReductionPerformance1024
+{
+	[self measureReductionsOfLength: 1024];
+}
+
+- (void) testReductionPerformance16384
+{
+	[self measureReductionsOfLength: 16384];
+}
+
+- (void) testReductionPerformance262144
+{
+	[self measureReductionsOfLength: 262144];
+}
+
+- (void) testReductionPerformance1000000
+{
+	[self measureReductionsOfLength: 1000000];
+}
+
 - (void)testPerformanceExample
 {
     // This is an example of a performance test case.
@@ -31,10 +31,14 @@
 #import "Average.hpp"
 #import "GeometricMean.hpp"
 #import "HarmonicMean.hpp"
+#import "InterquartileRange.hpp"
 #import "Max.hpp"
 #import "Median.hpp"
+#import "MedianAbsoluteDeviation.hpp"
 #import "Min.hpp"
+#import "Percentile.hpp"
 #import "Product.hpp"
+#import "Quantile.hpp"
 #import "StandardDeviation.hpp"
 #import "Sum.hpp"
 #import "Variance.hpp"
@@ -59,7 +63,8 @@ const std::map< std::string, double >&	BuiltInConstants()
 			{ "pi", M_PI },
 			{ "π", M_PI },		// the pi character in UTF-8
 			{ "%", 0.01 },
-			{ "e", exp( 1.0 ) }
+			{ "e", exp( 1.0 ) },
+			{ "∞", INFINITY }	// the infinity character in UTF-8
 	};
 	return constants;
 }
@@ -119,6 +124,10 @@ const symbolsJW< NaryFunc >&	BuiltInNarySyms()
 		{ "sum", Sum },
 		{ "Var", Variance },
 		{ "median", Median },
+		{ "quantile", Quantile },
+		{ "percentile", Percentile },
+		{ "IQR", InterquartileRange },
+		{ "MAD", MedianAbsoluteDeviation },
 	};
 	return funcs;
 }
@@ -131,7 +140,26 @@ const boost::parser::symbols< IterationKind >&	BuiltInIterationSyms()
 		{ "summation", IterationKind::summation },
 		{ "∑", IterationKind::summation },
 		{ "multiplication", IterationKind::multiplication },
-		{ "∏", IterationKind::multiplication }
+		{ "∏", IterationKind::multiplication },
+		{ "integrate", IterationKind::integration },
+		{ "∫", IterationKind::integration },
+		{ "solve", IterationKind::rootFinding }
 	};
 	return funcs;
 }
+
+
+bool	IsBuiltInKeyword( std::string_view inIdentifier )
+{
+	return (inIdentifier == "if") or (inIdentifier == "tabulate") or
+		(inIdentifier == "deriv") or (inIdentifier == "minimize") or
+		(inIdentifier == "table");
+}
+
+
+bool	IsShadowableBuiltIn( std::string_view inIdentifier )
+{
+	return (inIdentifier == "table") or (inIdentifier == "tabulate") or
+		(inIdentifier == "deriv") or (inIdentifier == "minimize") or
+		(inIdentifier == "integrate") or (inIdentifier == "solve");
+}
@@ -34,6 +34,7 @@
 #import <algorithm>
 #import <stdexcept>
 #import <optional>
+#import <span>
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdocumentation"
@@ -43,12 +44,16 @@
 
 using UnaryFunc	=	double (*)( double );
 using BinaryFunc =	double (*)( double, double );
-using NaryFunc =	double (*)( const std::vector<double>& );
+// N-ary functions take a span, so that callers can pass arguments from
+// any contiguous storage.
+using NaryFunc =	double (*)( std::span<const double> );
 
 enum class IterationKind : char
 {
 	summation,
-	multiplication
+	multiplication,
+	integration,
+	rootFinding
 };
 
 /*
@@ -121,4 +126,14 @@ const symbolsJW< NaryFunc >&	BuiltInNarySyms();
 
 const boost::parser::symbols< IterationKind >&	BuiltInIterationSyms();
 
+// Names such as "if" that are parsed as part of the grammar rather than
+// looked up in a symbol table.
+bool	IsBuiltInKeyword( std::string_view inIdentifier );
+
+// Built-in names, such as "table" and "solve", that were added after
+// documents could already use them for user functions and variables.  A user
+// definition of one of these names is allowed, and takes precedence over the
+// built-in meaning.
+bool	IsShadowableBuiltIn( std::string_view inIdentifier );
+
 #endif /* Built_ins_hpp */
@@ -28,10 +28,13 @@
 
 #import "Calculate.hpp"
 
+#import "AdaptivePrecision.hpp"
 #import "BasicMath.hpp"
 #import "Built-ins.hpp"
+#import "CompileUserFunctions.hpp"
 #import "DoAssign.hpp"
 #import "DoBinaryOperator.hpp"
+#import "DoDerivative.hpp"
 #import "DoCheckForUserFunc.hpp"
 #import "DoEvaluateBinary.hpp"
 #import "DoEvaluateIteration.hpp"
@@ -41,6 +44,7 @@
 #import "DoEvaluateUserFunc.hpp"
 #import "DoGetAssignableIdentifier.hpp"
 #import "DoIf.hpp"
+#import "DoMinimize.hpp"
 #import "DoUserFuncDefine.hpp"
 #import "DoGetIndexVariable.hpp"
 #import "DoGetUserFuncName.hpp"
@@ -48,6 +52,10 @@
 #import "DoNegate.hpp"
 #import "DoPushFuncName.hpp"
 #import "DoPushNumber.hpp"
+#import "DoTable.hpp"
+#import "DoTabulate.hpp"
+#import "EvaluateTable.hpp"
+#import "EvaluationThread.hpp"
 #import "FuncArgCount.hpp"
 #import "GetStackSize.hpp"
 #import "UTF8toUTF32.hpp"
@@ -119,6 +127,7 @@ bp::rule< struct factor, double > factor = "factor";
 // This is a rule just to give better error messages
 bp::rule< struct moreArgs, std::vector<double> > moreArgs = "more function arguments";
 bp::rule< struct indexVar > indexVar = "iteration index variable";
+bp::rule< struct literalArgs, std::vector<double> > literalArgs = "literal arguments";
 
 auto const expression_def =
 						(
@@ -152,6 +161,11 @@ auto const power_def = factor >>
 						('^' > power)[ DoBinaryOperator( ::pow ) ]
 					);
 
+// A list of numbers, possibly negative, with nothing else.  Leading plus
+// signs are excluded, since they are not allowed elsewhere.
+auto const literalArgs_def =
+						(bp::double_ - bp::lit('+')) % ',';
+
 auto const moreArgs_def =
 						bp::repeat( FuncArgCount() )[ ',' > expression ];
 
@@ -188,6 +202,16 @@ auto const factor_def =
 								')'
 							) [ DoEvaluateBinary() ]
 						
+						// n-ary function whose arguments are all literal
+						// numbers, as when a long list is pasted.  The numbers
+						// are collected directly into a vector, without
+						// making syntax nodes.  There are no expectation
+						// points or actions before the end, so if anything
+						// else turns up, we backtrack to the general case.
+						|	( bp::lexeme[ BuiltInNarySyms() >> '(' ] >>
+								literalArgs >> ')'
+							) [ DoEvaluateNaryLiterals() ]
+						
 						// n-ary function (2 or more arguments)
 						|	( bp::omit[ bp::lexeme[ BuiltInNarySyms() >> '(' ] ][ DoPushFuncName() ] >
 								expression > ',' >
@@ -201,13 +225,17 @@ auto const factor_def =
 								expression > moreArgs > ')'
 							) [ DoEvaluateUserFunc() ]
 						
-						// iteration function (∑ or ∏)
+						// iteration function (∑, ∏, or ∫)
 						|	(
 								bp::omit[ bp::lexeme[ BuiltInIterationSyms() >> '(' ] ][ DoPushFuncName() ] >
 								indexVar > ',' >	// index variable
 								expressionNA > ',' >	// start value
 								expressionNA > ',' >	// end value
 								expression >		// expression being summed/multiplied
+								-(
+									bp::lit(',') >
+									expressionNA >> bp::eps[ DoIterationTolerance() ]
+								) >				// optional tolerance
 								')'
 							) [ DoEvaluateIteration() ]
 						
@@ -228,18 +256,55 @@ auto const factor_def =
 								expressionNA >
 								bp::lit(')') >> bp::eps[ DoIfFinish() ]
 							)
+						
+						// Approximation of a user function on an interval,
+						// with optional tolerance.  The value is the
+						// estimated error.
+						|	(
+								bp::lit("tabulate(") >
+								identifier[ DoGetTabulatedFunc() ] >
+								bp::lit(',') >
+								expressionNA >	// start of interval
+								bp::lit(',') >
+								expressionNA >	// end of interval
+								(
+									(bp::lit(',') > expressionNA >
+										bp::lit(')') >> bp::eps[ DoTabulate(true) ])
+									|	(bp::lit(')') >> bp::eps[ DoTabulate(false) ])
+								)
+							)
+						
+						// Derivative of a user function of one variable.
+						|	(
+								bp::lit("deriv(") >
+								identifier[ DoGetDerivativeFunc() ] >
+								bp::lit(',') >
+								expressionNA >
+								bp::lit(')') >> bp::eps[ DoDerivative() ]
+							)
+						
+						// Minimum of a user function of n variables, from a
+						// starting point (n arguments) or over a box (n pairs
+						// of bounds).
+						|	(
+								bp::lit("minimize(") >
+								identifier[ DoGetMinimizeFunc() ] >
+								+( bp::lit(',') > expression ) >
+								bp::lit(')')
+							) [ DoMinimize() ]
 
 						// constant or variable
 						|	identifier[ DoEvaluateVariable() ];
 
 BOOST_PARSER_DEFINE_RULES( expression, expressionNA, term, factor, power,
-	moreArgs, indexVar );
+	moreArgs, indexVar, literalArgs );
 
 //MARK: top-level types of calculations
 
 bp::rule< struct assignment, double > assignment = "assignment";
 bp::rule< struct funcdef > funcdef = "function definition";
 bp::rule< struct expressionStatement, double > expressionStatement = "expression statement";
+bp::rule< struct tableStatement > tableStatement = "table statement";
 
 // These parts were made into rules to get better error messages.
 bp::rule< struct funcName > funcName = "function name";
@@ -272,19 +337,42 @@ auto const funcdef_def =
 							expression >> bp::eoi
 						)[ DoUserFuncDefine( true ) ];
 
+// Values of an expression as an index variable runs through a grid.
+auto const tableStatement_def =
+						bp::eps >
+						bp::lit("table(") >
+						indexVar > ',' >	// index variable
+						expressionNA > ',' >	// start value
+						expressionNA > ',' >	// end value
+						expressionNA > ',' >	// step
+						expressionNA >		// expression being tabulated
+						')' >> bp::eoi[ DoTable() ];
+
 BOOST_PARSER_DEFINE_RULES( assignment, funcdef, expressionStatement,
-	funcName, funcParams, varName );
+	tableStatement, funcName, funcParams, varName );
 
 //MARK: -
 
 // Figure out whether we are looking at a calculation, an assignment to a
-// variable, or a definition of a function.
-static CalcType DeduceCalcType( const std::string& inText )
+// variable, a definition of a function, or a table.  A table statement has no
+// equal sign, so that a line such as "table(x) = x^2" still defines a function,
+// and a user function or variable named "table" takes precedence over it.
+static CalcType DeduceCalcType( const std::string& inText,
+								const SCalcState& inState )
 {
 	CalcType theType = CalcType::expression;
 	
+	std::string::size_type firstNonSpace = inText.find_first_not_of( " \t" );
 	std::string::size_type equalOffset = inText.find( '=' );
-	if (equalOffset != std::string::npos)
+	if ( (firstNonSpace != std::string::npos) and
+		(inText.compare( firstNonSpace, 6, "table(" ) == 0) and
+		(equalOffset == std::string::npos) and
+		(not inState.userFunctions.contains( "table" )) and
+		(not inState.variables.contains( "table" )) )
+	{
+		theType = CalcType::table;
+	}
+	else if (equalOffset != std::string::npos)
 	{
 		std::string::size_type parenOffset = inText.find( '(' );
 		if (parenOffset < equalOffset)
@@ -308,25 +396,57 @@ static CalcType DeduceCalcType( const std::string& inText )
 	#define DEBUG_TRACING_OPTION
 #endif
 
-/*!
-	@function	Calculate
+// Report the statistics of the approximations made while evaluating.
+static void	CopyEvaluationStats( const SCalcState& inState, CalcResult& ioResult )
+{
+	ioResult.seriesTermCount = inState.seriesTermCount;
+	ioResult.seriesErrorEstimate = inState.seriesErrorEstimate;
+	ioResult.integrandEvaluationCount = inState.integrandEvaluationCount;
+	ioResult.integrationErrorEstimate = inState.integrationErrorEstimate;
+	ioResult.solverEvaluationCount = inState.solverEvaluationCount;
+	ioResult.minimizerEvaluationCount = inState.minimizerEvaluationCount;
+	ioResult.minimumLocation = inState.minimumLocation;
+}
+
+// Evaluate the syntax tree of an expression, or of the right hand side of an
+// assignment, with adaptive precision if the state asks for it.
+static std::optional<double>	EvaluateStatement( const ASTNode& inTree,
+												SCalcState& ioState,
+												CalcResult& ioResult )
+{
+	std::optional<double> resultVal;
 	
-	@abstract	Parse and execute a calculator statement.
+	if (ioState.precisionTolerance > 0.0)
+	{
+		std::optional<AdaptiveValue> adaptive( EvaluateAdaptively( inTree,
+			ioState.precisionTolerance, ioState ) );
+		if (adaptive.has_value())
+		{
+			resultVal = adaptive->value;
+			ioResult.roundingErrorBound = adaptive->errorBound;
+			ioResult.isExtendedPrecision = adaptive->isExtended;
+		}
+	}
+	else
+	{
+		resultVal = inTree.Evaluate( ioState );
+	}
 	
-	@param		inText		A line of input text.
-	@param		ioState		A state object that may be used and modified in the course
-							of the calculation.
-	@result		The result of the calculation.
-*/
-CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
+	return resultVal;
+}
+
+static CalcResult	CalculateOnCurrentThread( const std::string& inText,
+												SCalcState& ioState )
 {
 	SaveStackAddress();
 	CalcResult returnedVariant;
 	ioState.ClearTemporaries();
-	CalcType calcType = DeduceCalcType( inText );
-	std::u32string text32( UTF8toUTF32( inText ) );
+	RetireExpressionSpecializations( ioState );
+	CalcType calcType = DeduceCalcType( inText, ioState );
+	UTF8toUTF32( inText, ioState.inputText32 );
+	const std::u32string& text32( ioState.inputText32 );
 	
-	std::ostringstream errors;
+	std::ostringstream& errors( ioState.errorStream );
 	bp::stream_error_handler errorHandler( "", errors );
 	bool didParse = false;
 	
@@ -336,16 +456,19 @@ CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
 			break;
 			
 		case CalcType::expression:
+			ioState.deferFolding = (ioState.precisionTolerance > 0.0);
 			didParse = static_cast<bool>( bp::parse( text32,
 				bp::with_error_handler(
 				bp::with_globals(expressionStatement, ioState), errorHandler),
 				bp::ws
 				DEBUG_TRACING_OPTION
 				) );
+			ioState.deferFolding = false;
 			if (didParse)
 			{
 				autoASTNode resultNode( ioState.valStack.top() );
-				std::optional<double> resultVal = resultNode->Evaluate( ioState );
+				std::optional<double> resultVal = EvaluateStatement( *resultNode,
+					ioState, returnedVariant );
 				if (ioState.interruptCode != CalcInterruptCode::none)
 				{
 					returnedVariant.SetInterrupt( ioState.interruptCode );
@@ -353,21 +476,25 @@ CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
 				else if (resultVal.has_value())
 				{
 					returnedVariant.SetValue( resultVal.value() );
+					CopyEvaluationStats( ioState, returnedVariant );
 					ioState.variables["last"] = resultVal.value();
 				}
 			}
 			break;
 		
 		case CalcType::variableAssignment:
+			ioState.deferFolding = (ioState.precisionTolerance > 0.0);
 			didParse = static_cast<bool>( bp::parse( text32,
 				bp::with_error_handler( bp::with_globals(assignment, ioState),
 				errorHandler ), bp::ws
 				DEBUG_TRACING_OPTION
 				) );
+			ioState.deferFolding = false;
 			if (didParse)
 			{
 				autoASTNode resultNode( ioState.valStack.top() );
-				std::optional<double> resultVal = resultNode->Evaluate( ioState );
+				std::optional<double> resultVal = EvaluateStatement( *resultNode,
+					ioState, returnedVariant );
 				if (ioState.interruptCode != CalcInterruptCode::none)
 				{
 					returnedVariant.SetInterrupt( ioState.interruptCode );
@@ -375,6 +502,10 @@ CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
 				else if (resultVal.has_value())
 				{
 					returnedVariant.SetValue( resultVal.value() );
+					CopyEvaluationStats( ioState, returnedVariant );
+					// DoAssign stored the value as evaluated while parsing, which
+					// adaptive precision may have improved on.
+					ioState.variables[ ioState.leftIdentifier ] = resultVal.value();
 					ioState.variables["last"] = resultVal.value();
 				}
 			}
@@ -394,6 +525,29 @@ CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
 			else
 			{
 				ioState.userFunctions.erase( ioState.leftIdentifier );
+				CompileUserFunctions( ioState );
+			}
+			break;
+		
+		case CalcType::table:
+			didParse = static_cast<bool>( bp::parse( text32,
+				bp::with_error_handler( bp::with_globals(tableStatement, ioState),
+				errorHandler ), bp::ws
+				DEBUG_TRACING_OPTION
+				) );
+			if (didParse)
+			{
+				autoASTNode contentNode( ioState.valStack.top() );
+				std::vector< std::pair<double, double> > rows;
+				EvaluateTable( ioState.tableGrid, contentNode, ioState, rows );
+				if (ioState.interruptCode != CalcInterruptCode::none)
+				{
+					returnedVariant.SetInterrupt( ioState.interruptCode );
+				}
+				else
+				{
+					returnedVariant.SetTable( std::move( rows ) );
+				}
 			}
 			break;
 	}
@@ -405,3 +559,33 @@ CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
 	
 	return returnedVariant;
 }
+
+/*!
+	@function	Calculate
+	
+	@abstract	Parse and execute a calculator statement.
+	
+	@param		inText		A line of input text.
+	@param		ioState		A state object that may be used and modified in the course
+							of the calculation.
+	@result		The result of the calculation.
+*/
+CalcResult	Calculate( const std::string& inText, SCalcState& ioState )
+{
+	CalcResult result;
+	
+	if (ioState.evaluationThread != nullptr)
+	{
+		ioState.evaluationThread->Run(
+			[&]()
+			{
+				result = CalculateOnCurrentThread( inText, ioState );
+			} );
+	}
+	else
+	{
+		result = CalculateOnCurrentThread( inText, ioState );
+	}
+	
+	return result;
+}
@@ -32,6 +32,8 @@
 struct SCalcState;
 
 #import <string>
+#import <utility>
+#import <vector>
 
 
 enum class CalcInterruptCode : int
@@ -48,7 +50,8 @@ enum class CalcResultType : int
 	error,				// errorMessage is set
 	interrupt,			// interruptCode is set
 	definedFunc,		// funcName is set
-	redefinedFunc		// funcName is set
+	redefinedFunc,		// funcName is set
+	table				// tableRows is set
 };
 
 /*!
@@ -60,6 +63,31 @@ enum class CalcResultType : int
 				is either a number (double) or a parsing error message or an interrupt code.  The
 				result of calculating a function definition is the name of the function, in the successful
 				case, or a parsing error message.
+				
+				If the value involved infinite sums or products, which are
+				approximated, seriesTermCount is the total number of terms
+				that were evaluated and seriesErrorEstimate estimates the
+				error.  Likewise, if it involved integrals,
+				integrandEvaluationCount is the total number of evaluations
+				of the integrands and integrationErrorEstimate estimates the
+				error.  If it involved solving equations,
+				solverEvaluationCount is the total number of evaluations of
+				the expressions being solved.  If it involved minimizing
+				functions, minimizerEvaluationCount is the total number of
+				evaluations of those functions, and minimumLocation is where
+				the last minimum to be completed was found, which is the
+				outermost one.
+				
+				If adaptive precision is turned on in the state, see
+				EvaluateAdaptively, roundingErrorBound bounds the rounding
+				error of the value as computed in double precision, and
+				isExtendedPrecision tells whether the bound was too large, so
+				that the value was computed again in extended precision.
+				
+				The result of a table statement is a list of rows, each
+				holding a value of the index variable and the value of the
+				expression there, which is NaN where it could not be
+				evaluated.
 */
 struct CalcResult
 {
@@ -68,12 +96,34 @@ struct CalcResult
 	std::string			errorMessage;
 	CalcInterruptCode	interruptCode = CalcInterruptCode::none;
 	std::string			funcName;
+	size_t				seriesTermCount = 0;
+	double				seriesErrorEstimate = 0.0;
+	size_t				integrandEvaluationCount = 0;
+	double				integrationErrorEstimate = 0.0;
+	size_t				solverEvaluationCount = 0;
+	size_t				minimizerEvaluationCount = 0;
+	std::vector<double>	minimumLocation;
+	double				roundingErrorBound = 0.0;
+	bool				isExtendedPrecision = false;
+	std::vector< std::pair<double, double> >	tableRows;
 	
 	void				SetValue( double inValue )
 						{
 							calculatedValue = inValue;
 							type = CalcResultType::value;
 						}
+	void				SetTable( std::vector< std::pair<double, double> >&& ioRows )
+						{
+							tableRows.swap( ioRows );
+							type = CalcResultType::table;
+						}
+	bool				IsApproximate() const
+						{
+							return (seriesTermCount > 0) or
+								(integrandEvaluationCount > 0) or
+								(solverEvaluationCount > 0) or
+								(minimizerEvaluationCount > 0);
+						}
 	void				SetInterrupt( CalcInterruptCode code )
 						{
 							interruptCode = code;
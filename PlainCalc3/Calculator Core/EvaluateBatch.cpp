@@ -0,0 +1,312 @@
+//  EvaluateBatch.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "EvaluateBatch.hpp"
+
+#import "BasicMath.hpp"
+#import "BinaryFuncNode.hpp"
+#import "Built-ins.hpp"
+#import "IndexVariableNode.hpp"
+#import "NaryFuncNode.hpp"
+#import "NumberNode.hpp"
+#import "PolynomialNode.hpp"
+#import "UnaryFuncNode.hpp"
+#import "VectorMath.hpp"
+
+#import <algorithm>
+#import <map>
+#import <math.h>
+
+using UnaryBatchFunc = void (*)( const double*, double*, size_t );
+using BinaryBatchFunc = void (*)( const double*, const double*, double*, size_t );
+
+namespace
+{
+	// What the evaluation of each node of a batch needs to know.
+	struct BatchContext
+	{
+		const std::string&			variable;
+		IndexVariableScope&			binding;
+		std::span<const double>		points;
+		SCalcState&					state;
+	};
+}
+
+// Functions are looked up by name, as in Differentiation.cpp, since some of
+// them are not visible outside of Built-ins.cpp.
+template <typename Func, typename BatchFunc>
+static std::map< Func, BatchFunc > MakeBatchMap(
+	const symbolsJW< Func >& inSymbols,
+	const std::map< std::string, BatchFunc >& inByName )
+{
+	std::map< Func, BatchFunc > result;
+	
+	for (const auto& [name, func] : inSymbols.Pairs())
+	{
+		auto foundIt = inByName.find( name );
+		if (foundIt != inByName.end())
+		{
+			result[ func ] = foundIt->second;
+		}
+	}
+	
+	return result;
+}
+
+static const std::map< UnaryFunc, UnaryBatchFunc >&	FastUnaryFunctions()
+{
+	static const std::map< UnaryFunc, UnaryBatchFunc > sFunctions(
+		MakeBatchMap( BuiltInUnarySyms(), std::map< std::string, UnaryBatchFunc >
+		{
+			{ "sin", VectorSin },
+			{ "cos", VectorCos },
+			{ "exp", VectorExp },
+			{ "log", VectorLog },
+			{ "ln", VectorLog }
+		} ) );
+	
+	return sFunctions;
+}
+
+static const std::map< BinaryFunc, BinaryBatchFunc >&	FastBinaryFunctions()
+{
+	static const std::map< BinaryFunc, BinaryBatchFunc > sFunctions(
+		MakeBatchMap( BuiltInBinarySyms(), std::map< std::string, BinaryBatchFunc >
+		{
+			{ "pow", VectorPow }
+		} ) );
+	
+	return sFunctions;
+}
+
+static void	ApplyUnaryToBatch( UnaryFunc inFunc, const double* inX,
+								double* outY, size_t inCount, bool inFast )
+{
+	if (inFunc == Negate)
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			outY[i] = -inX[i];
+		}
+		return;
+	}
+	
+	if (inFast)
+	{
+		auto foundIt = FastUnaryFunctions().find( inFunc );
+		if (foundIt != FastUnaryFunctions().end())
+		{
+			foundIt->second( inX, outY, inCount );
+			return;
+		}
+	}
+	
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		outY[i] = inFunc( inX[i] );
+	}
+}
+
+// The arithmetic operators are written out, rather than called through
+// function pointers, so that the loops can be vectorized.  The results are
+// the same either way.
+static void	ApplyBinaryToBatch( BinaryFunc inFunc, const double* inX,
+								const double* inY, double* outResult,
+								size_t inCount, bool inFast )
+{
+	if (inFunc == Plus)
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			outResult[i] = inX[i] + inY[i];
+		}
+	}
+	else if (inFunc == Minus)
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			outResult[i] = inX[i] - inY[i];
+		}
+	}
+	else if (inFunc == Multiply)
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			outResult[i] = inX[i] * inY[i];
+		}
+	}
+	else if (inFunc == Divide)
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			outResult[i] = inX[i] / inY[i];
+		}
+	}
+	else
+	{
+		auto foundIt = FastBinaryFunctions().find( inFunc );
+		if ( inFast and (foundIt != FastBinaryFunctions().end()) )
+		{
+			foundIt->second( inX, inY, outResult, inCount );
+		}
+		else
+		{
+			for (size_t i = 0; i < inCount; ++i)
+			{
+				outResult[i] = inFunc( inX[i], inY[i] );
+			}
+		}
+	}
+}
+
+// Evaluate a node at every point of the batch.  Temporary arrays are
+// borrowed from the argument pool of the state, so that once it has warmed
+// up, evaluating a batch allocates no memory.
+static bool	EvaluateNodeBatch( const ASTNode& inNode, BatchContext& ioContext,
+								double* outValues )
+{
+	bool isDefined = true;
+	const size_t count = ioContext.points.size();
+	const bool isFast = ioContext.state.fastTranscendentals;
+	
+	if (ioContext.state.interruptCode != CalcInterruptCode::none)
+	{
+		isDefined = false;
+	}
+	else if (const NumberNode* numNode = dynamic_cast<const NumberNode*>( &inNode ))
+	{
+		std::fill_n( outValues, count, numNode->Value() );
+	}
+	else if (const IndexVariableNode* indexNode =
+		dynamic_cast<const IndexVariableNode*>( &inNode );
+		(indexNode != nullptr) and (indexNode->Name() == ioContext.variable))
+	{
+		std::copy( ioContext.points.begin(), ioContext.points.end(), outValues );
+	}
+	else if (const UnaryFuncNode* unNode =
+		dynamic_cast<const UnaryFuncNode*>( &inNode ))
+	{
+		ScratchArguments scratch( ioContext.state );
+		DoubleVec& arguments( scratch.Arguments() );
+		arguments.resize( count );
+		isDefined = EvaluateNodeBatch( *inNode.Children()[0], ioContext,
+			arguments.data() );
+		if (isDefined)
+		{
+			ApplyUnaryToBatch( unNode->GetFunc(), arguments.data(), outValues,
+				count, isFast );
+		}
+	}
+	else if (const BinaryFuncNode* binNode =
+		dynamic_cast<const BinaryFuncNode*>( &inNode ))
+	{
+		ScratchArguments scratch( ioContext.state );
+		DoubleVec& arguments( scratch.Arguments() );
+		arguments.resize( 2 * count );
+		isDefined = EvaluateNodeBatch( *inNode.Children()[0], ioContext,
+				arguments.data() ) and
+			EvaluateNodeBatch( *inNode.Children()[1], ioContext,
+				arguments.data() + count );
+		if (isDefined)
+		{
+			ApplyBinaryToBatch( binNode->GetFunc(), arguments.data(),
+				arguments.data() + count, outValues, count, isFast );
+		}
+	}
+	else if (const NaryFuncNode* naryNode =
+		dynamic_cast<const NaryFuncNode*>( &inNode ))
+	{
+		// Evaluate each argument for the whole batch, then call the function
+		// once per point with the arguments gathered from those columns.
+		const ASTNodeVec& children( inNode.Children() );
+		ScratchArguments columnScratch( ioContext.state );
+		DoubleVec& columns( columnScratch.Arguments() );
+		columns.resize( children.size() * count );
+		for (size_t j = 0; isDefined and (j < children.size()); ++j)
+		{
+			isDefined = EvaluateNodeBatch( *children[j], ioContext,
+				columns.data() + j * count );
+		}
+		if (isDefined)
+		{
+			ScratchArguments scratch( ioContext.state );
+			DoubleVec& arguments( scratch.Arguments() );
+			arguments.resize( children.size() );
+			const NaryFunc func = naryNode->GetFunc();
+			for (size_t i = 0; i < count; ++i)
+			{
+				for (size_t j = 0; j < children.size(); ++j)
+				{
+					arguments[j] = columns[ j * count + i ];
+				}
+				outValues[i] = func( arguments );
+			}
+		}
+	}
+	else if (const PolynomialNode* polyNode =
+		dynamic_cast<const PolynomialNode*>( &inNode ))
+	{
+		ScratchArguments scratch( ioContext.state );
+		DoubleVec& variableValues( scratch.Arguments() );
+		variableValues.resize( count );
+		isDefined = EvaluateNodeBatch( *inNode.Children()[0], ioContext,
+			variableValues.data() );
+		if (isDefined)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				outValues[i] = polyNode->EvaluateAt( variableValues[i] );
+			}
+		}
+	}
+	else
+	{
+		for (size_t i = 0; isDefined and (i < count); ++i)
+		{
+			ioContext.binding.Value() = ioContext.points[i];
+			std::optional<double> value( inNode.Evaluate( ioContext.state ) );
+			isDefined = value.has_value() and
+				(ioContext.state.interruptCode == CalcInterruptCode::none);
+			outValues[i] = value.value_or( NAN );
+		}
+	}
+	
+	return isDefined;
+}
+
+bool	EvaluateBatch( const ASTNode& inContent,
+						const std::string& inVariable,
+						IndexVariableScope& ioBinding,
+						std::span<const double> inPoints,
+						std::span<double> outValues,
+						SCalcState& ioState )
+{
+	BatchContext context{ inVariable, ioBinding, inPoints, ioState };
+	
+	return EvaluateNodeBatch( inContent, context, outValues.data() );
+}
@@ -0,0 +1,74 @@
+//  EvaluateBatch.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef EvaluateBatch_hpp
+#define EvaluateBatch_hpp
+
+#import "ASTNode.hpp"
+#import "IterationNode.hpp"
+#import "SCalcState.hpp"
+
+#import <span>
+#import <string>
+
+/*!
+	@function	EvaluateBatch
+	
+	@abstract	Evaluate an expression at many values of an index variable.
+	
+	@discussion	Numbers, the index variable, polynomials, and built-in
+				functions and operators are evaluated for all the values at
+				once, one node at a time, so that the loops over the values
+				can use vector instructions.  Other subtrees are evaluated at
+				one value at a time.
+				
+				If the fastTranscendentals member of the state is set, sin,
+				cos, exp, log, and pow are computed by the functions of
+				VectorMath.hpp.  Otherwise the results are the same as those
+				of evaluating the expression at each value in turn.
+	
+	@param		inContent	The expression.
+	@param		inVariable	The name of the index variable.
+	@param		ioBinding	The binding of the index variable, which is used
+							for subtrees evaluated one value at a time.
+	@param		inPoints	Values of the index variable.
+	@param		outValues	Receives the value of the expression at each
+							point.  It must be as long as inPoints.
+	@param		ioState		The state used for evaluation.
+	@result		False if the expression could not be evaluated at some
+				point, or evaluation was interrupted.  The values are then
+				not meaningful.
+*/
+bool	EvaluateBatch( const ASTNode& inContent,
+						const std::string& inVariable,
+						IndexVariableScope& ioBinding,
+						std::span<const double> inPoints,
+						std::span<double> outValues,
+						SCalcState& ioState );
+
+#endif /* EvaluateBatch_hpp */
@@ -0,0 +1,132 @@
+//  EvaluateTable.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "EvaluateTable.hpp"
+
+#import "EvaluateBatch.hpp"
+#import "IterationNode.hpp"
+#import "ParallelEvaluation.hpp"
+
+#import <algorithm>
+#import <cmath>
+#import <span>
+
+// Number of consecutive rows evaluated by one job, when a table is divided
+// among threads.  Blocks of rows, rather than single rows, keep the jobs
+// coarse enough to be worth spawning.
+static constexpr size_t kRowsPerJob = 256;
+
+// Allowance for rounding error when dividing the interval by the step.
+static constexpr double kRowCountSlop = 1.0e-9;
+
+std::optional<size_t>	TableRowCount( double inStart, double inEnd, double inStep )
+{
+	std::optional<size_t> result;
+	
+	if ( std::isfinite( inStart ) and std::isfinite( inEnd ) and
+		std::isfinite( inStep ) and (inStep != 0.0) )
+	{
+		const double steps = (inEnd - inStart) / inStep;
+		if (steps > -kRowCountSlop)
+		{
+			const double floorSteps = std::floor( steps + kRowCountSlop );
+			// Beyond the cap, the exact count does not matter.
+			result = static_cast<size_t>( std::min( floorSteps,
+				static_cast<double>( kMaxTableRows ) ) ) + 1;
+		}
+	}
+	
+	return result;
+}
+
+void	EvaluateTable( const TableGrid& inGrid,
+						const autoASTNode& inContent,
+						SCalcState& ioState,
+						std::vector< std::pair<double, double> >& outRows )
+{
+	outRows.resize( inGrid.rowCount );
+	
+	// Each job fills its own block of rows using only the state it is given,
+	// so that blocks can be evaluated on separate threads.  Computing each
+	// value of the index variable from the start avoids accumulating
+	// rounding error.  The block is first evaluated as a batch; if that
+	// fails somewhere, the rows are evaluated one at a time to find out
+	// which of them are undefined.
+	auto job = [&]( SCalcState& jobState, size_t inIndex )
+	{
+		IndexVariableScope index( jobState, inGrid.variable );
+		const size_t startRow = inIndex * kRowsPerJob;
+		const size_t endRow = std::min( startRow + kRowsPerJob,
+			inGrid.rowCount );
+		
+		ScratchArguments scratch( jobState );
+		DoubleVec& values( scratch.Arguments() );
+		values.resize( 2 * (endRow - startRow) );
+		const std::span<double> xs( values.data(), endRow - startRow );
+		const std::span<double> ys( values.data() + xs.size(), xs.size() );
+		for (size_t row = startRow; row < endRow; ++row)
+		{
+			xs[ row - startRow ] = inGrid.start + static_cast<double>( row ) * inGrid.step;
+		}
+		
+		if (EvaluateBatch( *inContent, inGrid.variable, index, xs, ys, jobState ))
+		{
+			for (size_t row = startRow; row < endRow; ++row)
+			{
+				outRows[ row ] = std::make_pair( xs[ row - startRow ],
+					ys[ row - startRow ] );
+			}
+			return;
+		}
+		
+		for (size_t row = startRow; row < endRow; ++row)
+		{
+			if (jobState.interruptCode != CalcInterruptCode::none)
+			{
+				break;
+			}
+			const double x = xs[ row - startRow ];
+			index.Value() = x;
+			std::optional<double> y( inContent->Evaluate( jobState ) );
+			outRows[ row ] = std::make_pair( x, y.value_or( NAN ) );
+		}
+	};
+	
+	const size_t jobCount = (inGrid.rowCount + kRowsPerJob - 1) / kRowsPerJob;
+	if ( (ioState.parallel != nullptr) and (jobCount > 1) )
+	{
+		ioState.parallel->RunAll( ioState, jobCount, job );
+	}
+	else
+	{
+		for (size_t i = 0; i < jobCount; ++i)
+		{
+			job( ioState, i );
+		}
+	}
+}
@@ -0,0 +1,85 @@
+//  EvaluateTable.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef EvaluateTable_hpp
+#define EvaluateTable_hpp
+
+#import "ASTNode.hpp"
+#import "SCalcState.hpp"
+
+#import <stddef.h>
+#import <optional>
+#import <utility>
+#import <vector>
+
+/// The largest number of rows that a table statement may produce.
+constexpr size_t kMaxTableRows = 100000;
+
+/*!
+	@function	TableRowCount
+	
+	@abstract	Count the values of the index variable of a table.
+	
+	@discussion	The values are start, start + step, ... as long as they do
+				not pass the end, allowing for a little rounding error so that
+				the end itself is included when the step divides the
+				interval.
+	
+	@param		inStart		The first value.
+	@param		inEnd		The limit of the values.
+	@param		inStep		The difference between consecutive values.
+	@result		The number of values, or nothing if the numbers are not
+				finite or the step is zero or leads away from the end.
+*/
+std::optional<size_t>	TableRowCount( double inStart, double inEnd, double inStep );
+
+/*!
+	@function	EvaluateTable
+	
+	@abstract	Evaluate an expression at each point of a grid.
+	
+	@discussion	The expression is evaluated at each value of the index
+				variable of the grid, using EvaluateBatch on blocks of rows.
+				If the state allows parallel evaluation, the blocks are
+				evaluated on several threads.  The caller should check the
+				interrupt code of the state afterwards.
+	
+	@param		inGrid		The index variable and its values.
+	@param		inContent	The expression, which should already be optimized.
+	@param		ioState		The state used for evaluation.
+	@param		outRows		Receives a pair of the value of the index variable
+							and the value of the expression for each row, the
+							latter being NaN where the expression could not be
+							evaluated.
+*/
+void	EvaluateTable( const TableGrid& inGrid,
+						const autoASTNode& inContent,
+						SCalcState& ioState,
+						std::vector< std::pair<double, double> >& outRows );
+
+#endif /* EvaluateTable_hpp */
@@ -0,0 +1,422 @@
+//  ParallelEvaluation.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "ParallelEvaluation.hpp"
+
+#import "TreeUtilities.hpp"
+
+#import <algorithm>
+#import <bit>
+#import <exception>
+#import <mutex>
+
+static constexpr size_t	kWorkerStackSize = 2U * 1024U * 1024U; 	// 2 megabytes
+
+// Spawning continues a few levels beyond what is needed to give every
+// thread a task, so that there is something to steal when tasks are
+// unequal.
+static constexpr unsigned int	kExtraSpawnDepth = 3;
+
+// A single call of a user function, or an iteration of a single node, is
+// enough to be worth a task.
+static constexpr double	kDefaultMinSpawnCost = std::min( kUserCallCost,
+	kIterationCostFactor );
+
+
+std::optional<double>	ConcurrentResultCache::Find( const UserFuncCacheKeyView& inKey ) const
+{
+	std::optional<double> result;
+	std::shared_lock<std::shared_mutex> guard( _lock );
+	
+	auto foundIt = _cache.find( inKey );
+	if (foundIt != _cache.end())
+	{
+		result = foundIt->second;
+	}
+	
+	return result;
+}
+
+void	ConcurrentResultCache::Insert( UserFuncCacheKey&& inKey, double inValue )
+{
+	std::unique_lock<std::shared_mutex> guard( _lock );
+	_cache.emplace( std::move( inKey ), inValue );
+}
+
+void	ConcurrentResultCache::Clear()
+{
+	std::unique_lock<std::shared_mutex> guard( _lock );
+	_cache.clear();
+}
+
+//MARK: -
+
+ParallelEvaluator::ParallelEvaluator( unsigned int inThreadCount,
+										size_t inStackSize )
+	: _pool( inThreadCount - 1, std::max( kWorkerStackSize, inStackSize ) )
+	, _rootState( nullptr )
+	, _maxSpawnDepth( std::bit_width( inThreadCount ) + kExtraSpawnDepth )
+	, _minSpawnCost( kDefaultMinSpawnCost )
+{
+	for (unsigned int i = 0; i < _pool.ThreadCount(); ++i)
+	{
+		_workerStates.push_back( std::make_unique<SCalcState>() );
+		_workerStates.back()->parallel = this;
+	}
+}
+
+ParallelEvaluator::~ParallelEvaluator()
+{
+}
+
+void	ParallelEvaluator::BeginCalculation( SCalcState& ioRootState )
+{
+	_rootState = &ioRootState;
+	_syncedVersion.reset();
+	_resultCache.Clear();
+}
+
+// The worker states need copies of the function definitions and of the
+// evaluation modes.  These can only change while parsing or between
+// calculations, when no tasks are running.
+void	ParallelEvaluator::SyncWorkerStates()
+{
+	if (_syncedVersion != _rootState->functionsVersion)
+	{
+		for (std::unique_ptr<SCalcState>& worker : _workerStates)
+		{
+			worker->userFunctions = _rootState->userFunctions;
+			worker->compiledFunctions = _rootState->compiledFunctions;
+			worker->tabulations = _rootState->tabulations;
+			worker->recursionTables.clear();
+			worker->prefixSums.clear();
+			worker->dualResultCache.clear();
+			worker->maxStack = 0;
+			worker->interruptCode = CalcInterruptCode::none;
+		}
+		_syncedVersion = _rootState->functionsVersion;
+	}
+	
+	// Modes can change without a change to the functions.
+	for (std::unique_ptr<SCalcState>& worker : _workerStates)
+	{
+		worker->fastTranscendentals = _rootState->fastTranscendentals;
+	}
+}
+
+SCalcState&	ParallelEvaluator::StateForCurrentThread()
+{
+	std::optional<unsigned int> workerIndex( _pool.WorkerIndex() );
+	
+	return workerIndex.has_value()? *_workerStates[ *workerIndex ] : *_rootState;
+}
+
+namespace
+{
+	// Statistics of the approximations made by a task.
+	struct ApproximationStats
+	{
+		size_t	seriesTermCount = 0;
+		double	seriesErrorEstimate = 0.0;
+		size_t	integrandEvaluationCount = 0;
+		double	integrationErrorEstimate = 0.0;
+		size_t	solverEvaluationCount = 0;
+		size_t	minimizerEvaluationCount = 0;
+		std::vector<double>	minimumLocation;
+	};
+}
+
+static void SwapStats( SCalcState& ioState, ApproximationStats& ioStats )
+{
+	std::swap( ioState.seriesTermCount, ioStats.seriesTermCount );
+	std::swap( ioState.seriesErrorEstimate, ioStats.seriesErrorEstimate );
+	std::swap( ioState.integrandEvaluationCount, ioStats.integrandEvaluationCount );
+	std::swap( ioState.integrationErrorEstimate, ioStats.integrationErrorEstimate );
+	std::swap( ioState.solverEvaluationCount, ioStats.solverEvaluationCount );
+	std::swap( ioState.minimizerEvaluationCount, ioStats.minimizerEvaluationCount );
+	std::swap( ioState.minimumLocation, ioStats.minimumLocation );
+}
+
+static void AddStats( SCalcState& ioState, ApproximationStats& ioStats )
+{
+	ioState.seriesTermCount += ioStats.seriesTermCount;
+	ioState.seriesErrorEstimate += ioStats.seriesErrorEstimate;
+	ioState.integrandEvaluationCount += ioStats.integrandEvaluationCount;
+	ioState.integrationErrorEstimate += ioStats.integrationErrorEstimate;
+	ioState.solverEvaluationCount += ioStats.solverEvaluationCount;
+	ioState.minimizerEvaluationCount += ioStats.minimizerEvaluationCount;
+	if (not ioStats.minimumLocation.empty())
+	{
+		ioState.minimumLocation.swap( ioStats.minimumLocation );
+	}
+}
+
+bool	ParallelEvaluator::IsExpensive( const autoASTNode& inNode ) const
+{
+	return EstimateCost( *inNode ) >= _minSpawnCost;
+}
+
+bool	ParallelEvaluator::ShouldSpawn( const SCalcState& inState,
+										const ASTNodeVec& inNodes ) const
+{
+	bool shouldSpawn = false;
+	
+	// A recursion table is filled one step at a time, so there is nothing to
+	// gain there.
+	if ( (inState.spawnDepth < _maxSpawnDepth) and
+		(inState.tableFuncName == nullptr) )
+	{
+		shouldSpawn = std::count_if( inNodes.begin(), inNodes.end(),
+			[this]( const autoASTNode& inNode )
+			{
+				return IsExpensive( inNode );
+			} ) >= 2;
+	}
+	
+	return shouldSpawn;
+}
+
+void	ParallelEvaluator::PropagateInterrupt( SCalcState& ioState )
+{
+	CalcInterruptCode code = ioState.interruptCode;
+	if ( (code != CalcInterruptCode::none) and (&ioState != _rootState) )
+	{
+		CalcInterruptCode expected = CalcInterruptCode::none;
+		_rootState->interruptCode.compare_exchange_strong( expected, code );
+	}
+}
+
+bool	ParallelEvaluator::IsInterrupted( SCalcState& ioState )
+{
+	if (ioState.interruptCode == CalcInterruptCode::none)
+	{
+		ioState.interruptCode = _rootState->interruptCode.load();
+	}
+	
+	return ioState.interruptCode != CalcInterruptCode::none;
+}
+
+void	ParallelEvaluator::EvaluateAll( SCalcState& ioState,
+										const ASTNodeVec& inNodes,
+										std::optional<double>* outValues )
+{
+	if (&ioState == _rootState)
+	{
+		SyncWorkerStates();
+	}
+	
+	// Spawn all the expensive nodes but the last, which we evaluate
+	// ourselves along with the cheap ones.
+	std::vector<bool> isExpensive( inNodes.size() );
+	std::transform( inNodes.begin(), inNodes.end(), isExpensive.begin(),
+		[this]( const autoASTNode& inNode )
+		{
+			return IsExpensive( inNode );
+		} );
+	auto lastExpensive = std::find( isExpensive.rbegin(), isExpensive.rend(),
+		true );
+	const size_t inlineIndex = isExpensive.rend() - lastExpensive - 1;
+	std::vector< WorkStealingPool::autoTask > tasks;
+	
+	// Infinite series, integrals, and equations solved by tasks report their
+	// statistics here.
+	std::vector< ApproximationStats > stats( inNodes.size() );
+	
+	for (size_t i = 0; i < inNodes.size(); ++i)
+	{
+		if ( (i != inlineIndex) and isExpensive[i] )
+		{
+			tasks.push_back( _pool.Spawn(
+				[this, node = inNodes[i], outValue = &outValues[i],
+				outStats = &stats[i],
+				arguments = ioState.functionArguments,
+				indexValues = ioState.indexVariableValues,
+				depth = ioState.spawnDepth + 1]() mutable
+				{
+					SCalcState& state( StateForCurrentThread() );
+					
+					// Install the argument frame of the task.
+					state.functionArguments.swap( arguments );
+					state.indexVariableValues.swap( indexValues );
+					std::swap( state.spawnDepth, depth );
+					SwapStats( state, *outStats );
+					
+					// The worker state must be restored even if evaluation
+					// throws, before the pool passes the exception on.
+					std::exception_ptr failure;
+					try
+					{
+						if (not IsInterrupted( state ))
+						{
+							*outValue = node->Evaluate( state );
+						}
+						PropagateInterrupt( state );
+					}
+					catch (...)
+					{
+						failure = std::current_exception();
+					}
+					
+					state.functionArguments.swap( arguments );
+					state.indexVariableValues.swap( indexValues );
+					std::swap( state.spawnDepth, depth );
+					SwapStats( state, *outStats );
+					
+					if (failure)
+					{
+						std::rethrow_exception( failure );
+					}
+				} ) );
+		}
+	}
+	
+	// The tasks refer to our locals, so they must finish before an
+	// exception thrown here can leave this function.
+	std::exception_ptr failure;
+	ioState.spawnDepth += 1;
+	try
+	{
+		for (size_t i = 0; i < inNodes.size(); ++i)
+		{
+			if ( (i == inlineIndex) or (not isExpensive[i]) )
+			{
+				outValues[i] = inNodes[i]->Evaluate( ioState );
+			}
+		}
+	}
+	catch (...)
+	{
+		failure = std::current_exception();
+	}
+	ioState.spawnDepth -= 1;
+	PropagateInterrupt( ioState );
+	
+	_pool.WaitAll( tasks );
+	if (failure)
+	{
+		std::rethrow_exception( failure );
+	}
+	for (ApproximationStats& taskStats : stats)
+	{
+		AddStats( ioState, taskStats );
+	}
+	
+	IsInterrupted( ioState );
+}
+
+void	ParallelEvaluator::RunAll( SCalcState& ioState, size_t inCount,
+									const std::function< void( SCalcState&, size_t ) >& inJob )
+{
+	if ( (ioState.spawnDepth >= _maxSpawnDepth) or
+		(ioState.tableFuncName != nullptr) )
+	{
+		for (size_t i = 0; i < inCount; ++i)
+		{
+			inJob( ioState, i );
+		}
+		return;
+	}
+	
+	if (&ioState == _rootState)
+	{
+		SyncWorkerStates();
+	}
+	
+	// Spawn all the jobs but the last, which we run ourselves.
+	std::vector< WorkStealingPool::autoTask > tasks;
+	std::vector< ApproximationStats > stats( inCount );
+	
+	for (size_t i = 0; i + 1 < inCount; ++i)
+	{
+		tasks.push_back( _pool.Spawn(
+			[this, &inJob, i, outStats = &stats[i],
+			arguments = ioState.functionArguments,
+			indexValues = ioState.indexVariableValues,
+			depth = ioState.spawnDepth + 1]() mutable
+			{
+				SCalcState& state( StateForCurrentThread() );
+				
+				state.functionArguments.swap( arguments );
+				state.indexVariableValues.swap( indexValues );
+				std::swap( state.spawnDepth, depth );
+				SwapStats( state, *outStats );
+				
+				std::exception_ptr failure;
+				try
+				{
+					if (not IsInterrupted( state ))
+					{
+						inJob( state, i );
+					}
+					PropagateInterrupt( state );
+				}
+				catch (...)
+				{
+					failure = std::current_exception();
+				}
+				
+				state.functionArguments.swap( arguments );
+				state.indexVariableValues.swap( indexValues );
+				std::swap( state.spawnDepth, depth );
+				SwapStats( state, *outStats );
+				
+				if (failure)
+				{
+					std::rethrow_exception( failure );
+				}
+			} ) );
+	}
+	
+	std::exception_ptr failure;
+	if (inCount > 0)
+	{
+		ioState.spawnDepth += 1;
+		try
+		{
+			inJob( ioState, inCount - 1 );
+		}
+		catch (...)
+		{
+			failure = std::current_exception();
+		}
+		ioState.spawnDepth -= 1;
+		PropagateInterrupt( ioState );
+	}
+	
+	_pool.WaitAll( tasks );
+	if (failure)
+	{
+		std::rethrow_exception( failure );
+	}
+	for (ApproximationStats& taskStats : stats)
+	{
+		AddStats( ioState, taskStats );
+	}
+	
+	IsInterrupted( ioState );
+}
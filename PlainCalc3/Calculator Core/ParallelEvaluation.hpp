@@ -0,0 +1,186 @@
+//  ParallelEvaluation.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef ParallelEvaluation_hpp
+#define ParallelEvaluation_hpp
+
+#import "SCalcState.hpp"
+#import "WorkStealingPool.hpp"
+
+#import <functional>
+#import <memory>
+#import <optional>
+#import <shared_mutex>
+#import <vector>
+
+/*!
+	@class		ConcurrentResultCache
+	
+	@abstract	A cache of user function results that can be shared by several
+				threads.
+*/
+class ConcurrentResultCache
+{
+public:
+	std::optional<double>	Find( const UserFuncCacheKeyView& inKey ) const;
+	void					Insert( UserFuncCacheKey&& inKey, double inValue );
+	void					Clear();
+
+private:
+	mutable std::shared_mutex	_lock;
+	UserFuncResultCache			_cache;
+};
+
+
+/*!
+	@class		ParallelEvaluator
+	
+	@abstract	Evaluates independent subtrees on several threads.
+	
+	@discussion	A node whose children include at least two expensive
+				subtrees, that is, ones whose EstimateCost reaches the
+				minimum spawn cost, may evaluate them on a work-stealing pool.
+				By default, any subtree containing user function calls or
+				iterations is expensive.  Each
+				spawned task carries a copy of the function arguments and index
+				variable values of the evaluation that spawned it, and is
+				evaluated using a calculator state belonging to the thread that
+				runs it.  Results of user functions are shared by all threads
+				through a concurrent cache.
+				
+				In order to keep tasks coarse, spawning stops beyond a certain
+				depth of nested spawns.
+*/
+class ParallelEvaluator
+{
+public:
+	/*!
+		@function	ParallelEvaluator
+		@param		inThreadCount	Number of threads to use, including the
+									thread that starts the calculation.
+		@param		inStackSize		Minimum stack size of the worker threads,
+									or 0 for the default.
+	*/
+	explicit				ParallelEvaluator( unsigned int inThreadCount,
+												size_t inStackSize = 0 );
+							ParallelEvaluator( const ParallelEvaluator& ) = delete;
+							~ParallelEvaluator();
+	
+	unsigned int			ThreadCount() const noexcept
+							{
+								return _pool.ThreadCount() + 1;
+							}
+	
+	/*!
+		@function	BeginCalculation
+		@abstract	Prepare for a new calculation, discarding cached results.
+		@param		ioRootState		The state of the thread performing the
+									calculation.
+	*/
+	void					BeginCalculation( SCalcState& ioRootState );
+	
+	ConcurrentResultCache&	ResultCache() noexcept { return _resultCache; }
+	
+	/*!
+		@function	SetMinSpawnCost
+		@abstract	Set the estimated cost, see EstimateCost, at which a
+					subtree is worth evaluating as a separate task.
+	*/
+	void					SetMinSpawnCost( double inCost ) noexcept
+							{
+								_minSpawnCost = inCost;
+							}
+	
+	double					MinSpawnCost() const noexcept
+							{
+								return _minSpawnCost;
+							}
+	
+	/*!
+		@function	ShouldSpawn
+		@abstract	Decide whether some nodes are worth evaluating in parallel.
+		@param		inState		The state being used for evaluation.
+		@param		inNodes		Nodes whose values will all be needed.
+	*/
+	bool					ShouldSpawn( const SCalcState& inState,
+										const ASTNodeVec& inNodes ) const;
+	
+	/*!
+		@function	EvaluateAll
+		@abstract	Evaluate several nodes, in parallel where worthwhile.
+		@discussion	An exception thrown while evaluating a node on another
+					thread is rethrown here once all the nodes are done.
+		@param		ioState		The state being used for evaluation.
+		@param		inNodes		Nodes to evaluate.
+		@param		outValues	Receives inNodes.size() values.
+	*/
+	void					EvaluateAll( SCalcState& ioState,
+										const ASTNodeVec& inNodes,
+										std::optional<double>* outValues );
+	
+	/*!
+		@function	RunAll
+		@abstract	Run several independent jobs, in parallel if possible.
+		@discussion	Each job is passed the state of the thread that runs it,
+					with the function arguments and index variable values of
+					ioState, and the index of the job.  Jobs must not use any
+					other state.  If spawning is not possible at this depth,
+					the jobs run one after another using ioState.  An
+					exception thrown by a job is rethrown here once all the
+					jobs are done.
+		@param		ioState		The state being used for evaluation.
+		@param		inCount		Number of jobs.
+		@param		inJob		The job to run.
+	*/
+	void					RunAll( SCalcState& ioState, size_t inCount,
+									const std::function< void( SCalcState&, size_t ) >& inJob );
+	
+	/*!
+		@function	IsInterrupted
+		@abstract	Check whether the calculation has been interrupted on any
+					thread, and if so, record that in the given state.
+		@param		ioState		The state being used for evaluation.
+	*/
+	bool					IsInterrupted( SCalcState& ioState );
+
+private:
+	SCalcState&				StateForCurrentThread();
+	void					SyncWorkerStates();
+	void					PropagateInterrupt( SCalcState& ioState );
+	bool					IsExpensive( const autoASTNode& inNode ) const;
+	
+	WorkStealingPool							_pool;
+	ConcurrentResultCache						_resultCache;
+	std::vector< std::unique_ptr<SCalcState> >	_workerStates;
+	SCalcState*									_rootState;
+	std::optional<unsigned int>					_syncedVersion;
+	unsigned int								_maxSpawnDepth;
+	double										_minSpawnCost;
+};
+
+#endif /* ParallelEvaluation_hpp */
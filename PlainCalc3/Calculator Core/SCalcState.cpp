@@ -28,27 +28,136 @@
 
 #import "SCalcState.hpp"
 
+#import "EvaluationThread.hpp"
+#import "ParallelEvaluation.hpp"
+#import "RecursionTable.hpp"
+
 SCalcState::SCalcState()
-	: definedUserFunc( false )
+	: specializationSerial( 0 )
+	, functionsVersion( 0 )
+	, precisionTolerance( 0.0 )
+	, fastTranscendentals( false )
+	, deferFolding( false )
+	, optimizingExpression( false )
+	, iterationHasTolerance( false )
+	, dualIndexVariable( nullptr )
+	, definedUserFunc( false )
 	, suppressUserFuncEvaluation( 0 )
 	, interruptCode( CalcInterruptCode::none )
+	, parallel( nullptr )
+	, spawnDepth( 0 )
+	, seriesTermCount( 0 )
+	, seriesErrorEstimate( 0.0 )
+	, integrandEvaluationCount( 0 )
+	, integrationErrorEstimate( 0.0 )
+	, solverEvaluationCount( 0 )
+	, minimizerEvaluationCount( 0 )
+	, tableFuncName( nullptr )
+	, tableBeingFilled( nullptr )
+	, tableLookupFailed( false )
+{
+}
+
+
+void	SCalcState::SetEvaluationThreadCount( unsigned int inCount )
+{
+	parallel = nullptr;
+	
+	if (inCount > 1)
+	{
+		const size_t stackSize = (evaluationThread == nullptr)? 0 :
+			evaluationThread->StackSize();
+		parallelEvaluator = std::make_shared<ParallelEvaluator>( inCount,
+			stackSize );
+	}
+	else
+	{
+		parallelEvaluator.reset();
+	}
+}
+
+
+void	SCalcState::SetEvaluationStackSize( size_t inSize )
+{
+	if (inSize > 0)
+	{
+		evaluationThread = std::make_shared<EvaluationThread>( inSize );
+	}
+	else
+	{
+		evaluationThread.reset();
+	}
+	
+	// The worker threads of parallel evaluation need matching stacks.
+	if (parallelEvaluator != nullptr)
+	{
+		SetEvaluationThreadCount( parallelEvaluator->ThreadCount() );
+	}
+}
+
+
+std::optional<double>	SCalcState::FoldedValue( const ASTNode& inNode )
 {
+	std::optional<double> result;
+	
+	if (not deferFolding)
+	{
+		result = inNode.Evaluate( *this );
+	}
+	
+	return result;
 }
 
 
 void	SCalcState::ClearTemporaries()
 {
-	valStack = std::stack< autoASTNode >();
-	funcNameStack = std::stack< std::string >();
+	// Pop the stacks rather than replacing them, so that their storage
+	// can be reused.
+	while (not valStack.empty())
+	{
+		valStack.pop();
+	}
+	while (not funcNameStack.empty())
+	{
+		funcNameStack.pop();
+	}
 	leftIdentifier.clear();
+	deferFolding = false;
+	optimizingExpression = false;
 	definedUserFunc = false;
 	preexistingUserFunc = false;
 	iterationIndexVariables.clear();
+	iterationHasTolerance = false;
 	indexVariableValues.clear();
 	paramsOfFuncBeingDefined.clear();
 	functionArguments.clear();
+	dualArguments.clear();
+	dualIndexVariable = nullptr;
 	suppressUserFuncEvaluation = 0;
 	maxStack = 0;
 	interruptCode = CalcInterruptCode::none;
 	resultCache.clear();
+	dualResultCache.clear();
+	spawnDepth = 0;
+	seriesTermCount = 0;
+	seriesErrorEstimate = 0.0;
+	integrandEvaluationCount = 0;
+	integrationErrorEstimate = 0.0;
+	solverEvaluationCount = 0;
+	minimizerEvaluationCount = 0;
+	minimumLocation.clear();
+	tableGrid.variable.clear();
+	tableGrid.rowCount = 0;
+	tableFuncName = nullptr;
+	tableBeingFilled = nullptr;
+	tableLookupFailed = false;
+	TrimRecursionTables( *this );
+	parallel = parallelEvaluator.get();
+	if (parallel != nullptr)
+	{
+		parallel->BeginCalculation( *this );
+	}
+	inputText32.clear();
+	errorStream.str( std::string() );
+	errorStream.clear();
 }
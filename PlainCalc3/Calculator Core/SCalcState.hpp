@@ -33,16 +33,31 @@
 #import "Built-ins.hpp"
 #import "Calculate.hpp"
 
+#import <algorithm>
 #import <stack>
 #import <map>
+#import <span>
 #import <string>
+#import <string_view>
 #import <vector>
 #import <utility>
 #import <atomic>
+#import <sstream>
+#import <optional>
+#import <memory>
+#import <unordered_map>
+
+class ParallelEvaluator;
+class EvaluationThread;
+class ChebyshevApproximant;
 
 using StringVec = std::vector< std::string >;
 using DoubleVec = std::vector<double>;
 
+// Stacks use vector storage, so that emptying them keeps their capacity.
+using ASTNodeStack =		std::stack< autoASTNode, ASTNodeVec >;
+using StringStack =			std::stack< std::string, StringVec >;
+
 // This is everything but the function name in a function definition:
 // A list of formal parameters, the right hand side as a string, and the
 // right hand side as a syntax tree.
@@ -54,15 +69,124 @@ using BinaryFunctionMap =	std::map< std::string, BinaryFunc >;
 using NaryFunctionMap =		std::map< std::string, NaryFunc >;
 using UserFunctionMap =		std::map< std::string, FuncDef >;
 
+struct LinearRecurrence;
+
+// A compiled function body, and the number of arguments it expects.
+// If the function can be evaluated by EvaluateByRecursionTable,
+// maxRecursionOffset is the largest c in its recursive calls f(n - c).
+// If it can be evaluated by EvaluateLinearRecurrence, recurrence
+// describes it.
+struct CompiledFunc
+{
+	autoASTNode				body;
+	size_t					paramCount;
+	unsigned int			maxRecursionOffset = 0;
+	std::shared_ptr< const LinearRecurrence >	recurrence;
+};
+using CompiledFunctionMap =	std::map< std::string, CompiledFunc >;
+
+// A specialization of a user function is identified by the name of the
+// function and, for each parameter, either a constant value or nothing.
+using SpecializationKey =	std::pair< std::string, std::vector< std::optional<double> > >;
+using SpecializationMap =	std::map< SpecializationKey, std::string >;
+
+// Values of a function of one variable at start, start + 1, start + 2, ...
+struct RecursionTable
+{
+	double					start = 0.0;
+	std::vector<double>		values;
+};
+using RecursionTableMap =	std::map< std::string, RecursionTable >;
+
+// Partial sums or products of the content of an iteration with the index
+// variable running through start, start + 1, start + 2, ...  Such content
+// can only depend on the index variable and on function arguments, whose
+// values are recorded in argumentValues.  The map is keyed by the
+// StructuralHash of the content.
+struct PrefixSums
+{
+	autoASTNode				content;
+	IterationKind			kind;
+	std::string				variable;
+	double					start = 0.0;
+	std::vector<double>		argumentValues;
+	std::vector<double>		partials;
+};
+using PrefixSumCache =		std::unordered_multimap< size_t, PrefixSums >;
+
+// An approximation of a user function of one variable, made by tabulate.
+// It stays valid as long as the function and the functions that it calls
+// keep their definitions, so we record the parameters and right hand side
+// of each, or nothing for a function that was undefined.
+using FuncSource =			std::pair< StringVec, std::string >;
+struct Tabulation
+{
+	std::shared_ptr< const ChebyshevApproximant >		approximant;
+	std::map< std::string, std::optional<FuncSource> >	dependencies;
+};
+using TabulationMap =		std::map< std::string, Tabulation >;
+
 using UserFuncCacheKey =	std::pair< std::string, DoubleVec >;
-using UserFuncResultCache = std::map< UserFuncCacheKey, double >;
+
+// A cache key that refers to the name and arguments of a call rather than
+// owning copies of them, so that looking up a result needs no allocation.
+struct UserFuncCacheKeyView
+{
+	std::string_view			name;
+	std::span<const double>		arguments;
+};
+
+// Orders keys and key views as std::pair orders keys.
+struct UserFuncCacheKeyLess
+{
+	using is_transparent = void;
+	
+	static UserFuncCacheKeyView	View( const UserFuncCacheKey& inKey )
+								{
+									return { inKey.first, inKey.second };
+								}
+	static UserFuncCacheKeyView	View( const UserFuncCacheKeyView& inKey )
+								{
+									return inKey;
+								}
+	
+	bool	operator()( const auto& inLeft, const auto& inRight ) const
+			{
+				UserFuncCacheKeyView left( View( inLeft ) );
+				UserFuncCacheKeyView right( View( inRight ) );
+				if (left.name != right.name)
+				{
+					return left.name < right.name;
+				}
+				return std::lexicographical_compare(
+					left.arguments.begin(), left.arguments.end(),
+					right.arguments.begin(), right.arguments.end() );
+			}
+};
+
+using UserFuncResultCache = std::map< UserFuncCacheKey, double, UserFuncCacheKeyLess >;
+
+// Results of user functions evaluated on dual numbers.  The key lists the
+// value and derivative of each argument.
+using DualResultCache =		std::map< UserFuncCacheKey, Dual, UserFuncCacheKeyLess >;
 
 enum class CalcType : int
 {
 	unknown,
 	expression,
 	variableAssignment,
-	functionDefinition
+	functionDefinition,
+	table
+};
+
+// The grid of a table statement: the index variable takes rowCount values
+// start, start + step, start + 2 step, ...
+struct TableGrid
+{
+	std::string				variable;
+	double					start = 0.0;
+	double					step = 0.0;
+	size_t					rowCount = 0;
 };
 
 struct SCalcState
@@ -72,28 +196,172 @@ struct SCalcState
 
 	void					ClearTemporaries();
 	
+	/*!
+		@function	SetEvaluationThreadCount
+		@abstract	Opt in to evaluating independent subtrees on several threads.
+		@param		inCount		Number of threads to use.  A value of 1 or less
+								means that evaluation happens entirely on the
+								calling thread, which is the default.
+	*/
+	void					SetEvaluationThreadCount( unsigned int inCount );
+	
+	/*!
+		@function	SetEvaluationStackSize
+		@abstract	Opt in to calculating on a thread with a stack of a given
+					size.
+		@discussion	How deeply user functions can recurse depends on the stack
+					of the thread doing the calculation.  With a nonzero size,
+					Calculate does its work on a thread belonging to this
+					state, and threads used for parallel evaluation get stacks
+					at least as large.
+		@param		inSize		Stack size in bytes, or 0 to calculate on the
+								calling thread, which is the default.
+	*/
+	void					SetEvaluationStackSize( size_t inSize );
+	
+	/*!
+		@function	FoldedValue
+		@abstract	The value that a semantic action may put in place of a
+					subtree it has just built, or nothing if the subtree must
+					be kept.
+		@discussion	Constant subtrees are normally folded into numbers while
+					parsing.  While deferFolding is set, arithmetic on built-in
+					functions and operators is kept, so that adaptive-precision
+					evaluation can see the whole statement.
+	*/
+	std::optional<double>	FoldedValue( const ASTNode& inNode );
+	
 	// This is the data that needs to persist from one calculation to the next.
 	ScalarMap					variables;
 	UserFunctionMap				userFunctions;
 	
+	// Optimized function bodies derived from userFunctions, maintained by
+	// CompileUserFunctions.  Besides the user functions themselves, this
+	// holds specializations of user functions on constant arguments, whose
+	// names are recorded in the specializations map.
+	CompiledFunctionMap			compiledFunctions;
+	SpecializationMap			specializations;
+	unsigned int				specializationSerial;	// numbers the names
+	
+	// Specializations made by OptimizeExpression rather than while compiling
+	// user functions, see RetireExpressionSpecializations.
+	std::vector< SpecializationKey >	expressionSpecializations;
+	unsigned int				functionsVersion;	// incremented on changes
+	RecursionTableMap			recursionTables;
+	
+	// Partial sums and products of outermost iterations, so that a later
+	// iteration over a longer range can continue where an earlier one left
+	// off.  Since they may involve user functions, CompileUserFunctions
+	// discards them.  Variables are captured by value in syntax trees, so a
+	// changed variable simply leads to a different key.
+	PrefixSumCache				prefixSums;
+	
+	// Approximations of user functions, which are used in place of the
+	// functions where they apply.  CompileUserFunctions discards those whose
+	// dependencies have changed.
+	TabulationMap				tabulations;
+	
+	// A positive value opts in to adaptive-precision evaluation of
+	// expressions and assignments, see EvaluateAdaptively.  It is the
+	// largest acceptable bound on the relative rounding error of a result
+	// computed in double precision.  The default is 0, which turns it off.
+	double						precisionTolerance;
+	
+	// Opts in to computing sin, cos, exp, log, and pow with the functions of
+	// VectorMath.hpp when tables and integrals are evaluated in batches, see
+	// EvaluateBatch.  They are faster than the C library but may differ from
+	// it in the last place.  The default is false.
+	bool						fastTranscendentals;
+	
+	std::shared_ptr<ParallelEvaluator>	parallelEvaluator;
+	std::shared_ptr<EvaluationThread>	evaluationThread;
+	
 	// The remaining members are used temporarily during parsing or
 	// evaluation, and are reset by the ClearTemporaries method at the start
-	// of a new calculation.
-	std::stack< autoASTNode >	valStack;
-	std::stack< std::string >	funcNameStack;
+	// of a new calculation.  Where possible they keep their storage, so
+	// that repeated short calculations do not allocate memory.
+	ASTNodeStack				valStack;
+	StringStack					funcNameStack;
 	std::string					leftIdentifier;
+	bool						deferFolding;	// see FoldedValue
+	bool						optimizingExpression;	// see OptimizeExpression
 	
 	StringVec					iterationIndexVariables;
+	bool						iterationHasTolerance;
 	ScalarMap					indexVariableValues;
 	StringVec					paramsOfFuncBeingDefined;
 	std::vector<double>			functionArguments;
+	std::vector< DoubleVec >	argumentPool;	// see ScratchArguments
+	std::vector<Dual>			dualArguments;
+	const std::string*			dualIndexVariable;	// non-null while differentiating by an index variable
 	bool						definedUserFunc;
 	bool						preexistingUserFunc;
 	int							suppressUserFuncEvaluation;
 	UserFuncResultCache			resultCache;
+	DualResultCache				dualResultCache;
 	size_t						maxStack;
 	std::atomic< CalcInterruptCode >	interruptCode;
+	ParallelEvaluator*			parallel;		// non-null if evaluating in parallel
+	unsigned int				spawnDepth;
+	
+	// Statistics of infinite sums and products, of integrals, of equations
+	// solved, and of minimizations, reported in CalcResult.
+	size_t						seriesTermCount;
+	double						seriesErrorEstimate;
+	size_t						integrandEvaluationCount;
+	double						integrationErrorEstimate;
+	size_t						solverEvaluationCount;
+	size_t						minimizerEvaluationCount;
+	std::vector<double>			minimumLocation;
+	
+	// Set by DoTable while parsing a table statement.
+	TableGrid					tableGrid;
+	
+	// Used by EvaluateByRecursionTable.
+	const std::string*			tableFuncName;
+	const RecursionTable*		tableBeingFilled;
+	bool						tableLookupFailed;
+	
+	// Scratch buffers used by Calculate.
+	std::u32string				inputText32;
+	std::ostringstream			errorStream;
 };
 
 
+/*!
+	@class		ScratchArguments
+	
+	@abstract	Lends out a vector for the arguments of a function call.
+	
+	@discussion	Vectors are taken from the argumentPool of the state and
+				returned to it afterwards, so they keep their capacity.  Once
+				the pool holds as many vectors as calls are nested, evaluating
+				arguments allocates no memory.
+*/
+class ScratchArguments
+{
+public:
+	explicit	ScratchArguments( SCalcState& ioState )
+					: _state( ioState )
+				{
+					if (not _state.argumentPool.empty())
+					{
+						_arguments.swap( _state.argumentPool.back() );
+						_state.argumentPool.pop_back();
+					}
+				}
+				ScratchArguments( const ScratchArguments& ) = delete;
+				~ScratchArguments()
+				{
+					_arguments.clear();
+					_state.argumentPool.push_back( std::move( _arguments ) );
+				}
+	
+	DoubleVec&	Arguments() { return _arguments; }
+
+private:
+	SCalcState&	_state;
+	DoubleVec	_arguments;
+};
+
 #endif /* SCalcState_hpp */
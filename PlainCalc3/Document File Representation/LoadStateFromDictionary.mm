@@ -30,6 +30,7 @@
 
 #import "BuildTreeFromDictionary.hpp"
 #import "Calculate.hpp"
+#import "CompileUserFunctions.hpp"
 #import "SCalcState.hpp"
 
 #import <iostream>
@@ -185,4 +186,6 @@ void	LoadStateFromDictionary( SCalcState& ioState, NSDictionary* _Nonnull inDict
 	{
 		LoadFunctionsV2( ioState, funcsV2 );
 	}
+	
+	CompileUserFunctions( ioState );
 }
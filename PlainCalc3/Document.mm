@@ -31,6 +31,7 @@
 #import <WebKit/WebKit.h>
 
 #import "Calculate.hpp"
+#import "CompileUserFunctions.hpp"
 #import "ConvertErrorOffset.hpp"
 #import "LoadStateFromDictionary.h"
 #import "PerformBlockOnWorkThread.h"
@@ -64,6 +65,10 @@
 	NSRange					_lastCalculatedLineRange;
 }
 
+// The bound on the relative rounding error of a result that the Check
+// Rounding Error menu command puts in the calculator state.
+static const double kRoundingErrorTolerance = 1.0e-12;
+
 - (instancetype) init
 {
     self = [super init];
@@ -346,6 +351,85 @@
 		withAttributes: AppDelegate.normalTextAtts ];
 }
 
+- (void) showApproximateAnswer: (NSArray<NSNumber*>*) resultInfo
+{
+	[self restoreEditability];
+	double value = resultInfo[0].doubleValue;
+	[self insertString: [self formatCalculatedResult: value]
+			withAttributes: AppDelegate.successTextAtts ];
+	
+	if (resultInfo[1].unsignedLongValue > 0)
+	{
+		NSString* msgFormat = NSLocalizedString( @"SeriesInfo", nil );
+		NSString* msg = [NSString stringWithFormat: msgFormat,
+			resultInfo[1], resultInfo[2].doubleValue ];
+		[self insertString: msg
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	
+	if (resultInfo[3].unsignedLongValue > 0)
+	{
+		NSString* msgFormat = NSLocalizedString( @"IntegralInfo", nil );
+		NSString* msg = [NSString stringWithFormat: msgFormat,
+			resultInfo[3], resultInfo[4].doubleValue ];
+		[self insertString: msg
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	
+	if (resultInfo[5].unsignedLongValue > 0)
+	{
+		NSString* msgFormat = NSLocalizedString( @"SolverInfo", nil );
+		NSString* msg = [NSString stringWithFormat: msgFormat, resultInfo[5] ];
+		[self insertString: msg
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	
+	// The rounding error bound is that of the double precision value, so it
+	// does not apply to a value computed again in extended precision.
+	if (resultInfo[8].boolValue)
+	{
+		[self insertString: NSLocalizedString( @"ExtendedPrecisionInfo", nil )
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	else if (resultInfo[7].doubleValue > 0.0)
+	{
+		NSString* msgFormat = NSLocalizedString( @"PrecisionInfo", nil );
+		NSString* msg = [NSString stringWithFormat: msgFormat,
+			resultInfo[7].doubleValue ];
+		[self insertString: msg
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	
+	// The coordinates of the minimum follow the count of evaluations.
+	if (resultInfo[6].unsignedLongValue > 0)
+	{
+		NSMutableArray<NSString*>* coords = [NSMutableArray array];
+		for (NSUInteger i = 9; i < resultInfo.count; ++i)
+		{
+			[coords addObject: [self formatCalculatedResult:
+				resultInfo[i].doubleValue ]];
+		}
+		NSString* msgFormat = NSLocalizedString( @"MinimumInfo", nil );
+		NSString* msg = [NSString stringWithFormat: msgFormat,
+			[coords componentsJoinedByString: @", "], resultInfo[6] ];
+		[self insertString: msg
+			withAttributes: AppDelegate.normalTextAtts ];
+	}
+	
+	[self insertString: @"\n"
+		withAttributes: AppDelegate.normalTextAtts ];
+}
+
+// The rows of a table arrive already formatted, one per line, with the
+// value of the index variable and the value of the expression separated by a
+// tab.
+- (void) showTable: (NSString*) rowsText
+{
+	[self restoreEditability];
+	[self insertString: rowsText
+			withAttributes: AppDelegate.successTextAtts ];
+}
+
 - (void) sayDefinedFunc: (NSString*) funcName
 {
 	[self restoreEditability];
@@ -472,13 +556,53 @@
 			
 			CalcResult result = Calculate( theLine.UTF8String, me->_calcState );
 			
-			if (result.type == CalcResultType::value)
+			if ( (result.type == CalcResultType::value) and
+				( result.IsApproximate() or
+				(result.roundingErrorBound > 0.0) or
+				result.isExtendedPrecision ) )
+			{
+				NSMutableArray<NSNumber*>* resultInfo = [NSMutableArray arrayWithArray: @[
+					@(result.calculatedValue),
+					@(result.seriesTermCount),
+					@(result.seriesErrorEstimate),
+					@(result.integrandEvaluationCount),
+					@(result.integrationErrorEstimate),
+					@(result.solverEvaluationCount),
+					@(result.minimizerEvaluationCount),
+					@(result.roundingErrorBound),
+					@(result.isExtendedPrecision)
+				]];
+				for (double coord : result.minimumLocation)
+				{
+					[resultInfo addObject: @(coord)];
+				}
+				[me performSelectorOnMainThread: @selector(showApproximateAnswer:)
+					withObject: resultInfo
+					waitUntilDone: NO];
+			}
+			else if (result.type == CalcResultType::value)
 			{
 				double answer = result.calculatedValue;
 				[me performSelectorOnMainThread: @selector(showAnswer:)
 					withObject: @(answer)
 					waitUntilDone: NO];
 			}
+			else if (result.type == CalcResultType::table)
+			{
+				// Format the rows here, so that a long table does not keep
+				// the main thread busy.
+				NSMutableString* rowsText = [NSMutableString
+					stringWithCapacity: 32 * result.tableRows.size() ];
+				for (const auto& [x, y] : result.tableRows)
+				{
+					[rowsText appendFormat: @"%@\t%@\n",
+						[me formatCalculatedResult: x],
+						[me formatCalculatedResult: y] ];
+				}
+				[me performSelectorOnMainThread: @selector(showTable:)
+					withObject: rowsText
+					waitUntilDone: NO];
+			}
 			else if ( (result.type == CalcResultType::definedFunc) or
 				(result.type == CalcResultType::redefinedFunc) )
 			{
@@ -890,6 +1014,11 @@
 		menuItem.state = _formatIntegersAsHex? NSControlStateValueOn :
 			NSControlStateValueOff;
 	}
+	else if (menuItem.action == @selector(checkRoundingError:))
+	{
+		menuItem.state = (_calcState.precisionTolerance > 0.0)?
+			NSControlStateValueOn : NSControlStateValueOff;
+	}
 	else if (menuItem.action == @selector(revertDocumentToSaved:))
 	{
 		isEnabled = self.isDocumentEdited and (self.fileURL != nil);
@@ -915,6 +1044,12 @@
 	_formatIntegersAsHex = YES;
 }
 
+- (IBAction) checkRoundingError:(id)sender
+{
+	_calcState.precisionTolerance = (_calcState.precisionTolerance > 0.0)?
+		0.0 : kRoundingErrorTolerance;
+}
+
 - (IBAction) showVariables:(id)sender
 {
 	NSMutableString* theStr = [[NSMutableString alloc] initWithCapacity:100];
@@ -1017,6 +1152,7 @@
 			{
 				NSString* symbolName = [self->_deleteSymbolPopup titleOfSelectedItem];
 				self->_calcState.userFunctions.erase( symbolName.UTF8String );
+				CompileUserFunctions( self->_calcState );
 			}
 		}];
 }
@@ -28,9 +28,9 @@
 
 #import "Average.hpp"
 
-#import "Sum.hpp"
+#import "Reductions.hpp"
 
-double Average( const std::vector<double>& args )
+double Average( std::span<const double> args )
 {
-	return Sum( args ) / args.size();
+	return ReduceSum( args.data(), args.size() ) / args.size();
 }
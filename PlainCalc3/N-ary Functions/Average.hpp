@@ -29,8 +29,8 @@
 #ifndef Average_hpp
 #define Average_hpp
 
-#import <vector>
+#import <span>
 
-double Average( const std::vector<double>& args );
+double Average( std::span<const double> args );
 
 #endif /* Average_hpp */
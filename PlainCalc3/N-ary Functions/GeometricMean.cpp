@@ -28,11 +28,11 @@
 
 #import "GeometricMean.hpp"
 
-#import "Product.hpp"
+#import "ScaledProduct.hpp"
 
-#import <math.h>
-
-double GeometricMean( const std::vector<double>& args )
+double GeometricMean( std::span<const double> args )
 {
-	return pow( Product( args ), 1.0/args.size() );
+	// Taking the root of the scaled product, rather than of the product,
+	// avoids overflow and underflow when the mean itself is in range.
+	return ComputeScaledProduct( args.data(), args.size() ).Root( args.size() );
 }
@@ -29,8 +29,8 @@
 #ifndef GeometricMean_hpp
 #define GeometricMean_hpp
 
-#import <vector>
+#import <span>
 
-double GeometricMean( const std::vector<double>& args );
+double GeometricMean( std::span<const double> args );
 
 #endif /* GeometricMean_hpp */
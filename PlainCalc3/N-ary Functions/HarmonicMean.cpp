@@ -28,15 +28,9 @@
 
 #import "HarmonicMean.hpp"
 
-#import <numeric>
+#import "Reductions.hpp"
 
-double HarmonicMean( const std::vector<double>& args )
+double HarmonicMean( std::span<const double> args )
 {
-	double sumOfReciprocals = std::accumulate( args.cbegin(), args.cend(), 0.0,
-		[]( double sum, double x )->double
-		{
-			return sum + 1.0 / x;
-		} );
-	
-	return args.size() / sumOfReciprocals;
+	return args.size() / ReduceReciprocalSum( args.data(), args.size() );
 }
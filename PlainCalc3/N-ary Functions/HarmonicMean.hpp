@@ -29,8 +29,8 @@
 #ifndef HarmonicMean_hpp
 #define HarmonicMean_hpp
 
-#import <vector>
+#import <span>
 
-double HarmonicMean( const std::vector<double>& args );
+double HarmonicMean( std::span<const double> args );
 
 #endif /* HarmonicMean_hpp */
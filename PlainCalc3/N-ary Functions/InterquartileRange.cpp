@@ -0,0 +1,42 @@
+//  InterquartileRange.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "InterquartileRange.hpp"
+
+#import "Selection.hpp"
+
+double InterquartileRange( std::span<const double> args )
+{
+	std::vector<double>& values( SelectionBuffer( args.data(), args.size() ) );
+	
+	// The second selection starts from the partial order left by the first.
+	const double lowerQuartile = SelectQuantile( values, 0.25 );
+	const double upperQuartile = SelectQuantile( values, 0.75 );
+	
+	return upperQuartile - lowerQuartile;
+}
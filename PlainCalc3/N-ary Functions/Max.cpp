@@ -28,16 +28,9 @@
 
 #import "Max.hpp"
 
-#import <math.h>
+#import "Reductions.hpp"
 
-double Max( const std::vector<double>& args )
+double Max( std::span<const double> args )
 {
-	double theMax = - INFINITY;
-	
-	for (double val : args)
-	{
-		theMax = fmax( theMax, val );
-	}
-	
-	return theMax;
+	return ReduceMax( args.data(), args.size() );
 }
@@ -29,8 +29,8 @@
 #ifndef Max_hpp
 #define Max_hpp
 
-#import <vector>
+#import <span>
 
-double Max( const std::vector<double>& args );
+double Max( std::span<const double> args );
 
 #endif /* Max_hpp */
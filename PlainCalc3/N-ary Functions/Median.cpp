@@ -28,22 +28,11 @@
 
 #import "Median.hpp"
 
-#import <algorithm>
+#import "Selection.hpp"
 
-double Median( const std::vector<double>& args )
+double Median( std::span<const double> args )
 {
-	std::vector<double> mutableCopy( args );
+	std::vector<double>& values( SelectionBuffer( args.data(), args.size() ) );
 	
-	std::sort( mutableCopy.begin(), mutableCopy.end() );
-	
-	size_t n = args.size();
-	
-	if ( (n % 2) == 0 ) // even size
-	{
-		return 0.5 * (mutableCopy[ n/2 - 1 ] + mutableCopy[ n/2 ] );
-	}
-	else // odd
-	{
-		return mutableCopy[ n/2 ];
-	}
+	return SelectQuantile( values, 0.5 );
 }
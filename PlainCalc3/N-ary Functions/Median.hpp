@@ -29,8 +29,8 @@
 #ifndef Median_hpp
 #define Median_hpp
 
-#import <vector>
+#import <span>
 
-double Median( const std::vector<double>& args );
+double Median( std::span<const double> args );
 
 #endif /* Median_hpp */
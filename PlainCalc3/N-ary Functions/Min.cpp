@@ -28,16 +28,9 @@
 
 #import "Min.hpp"
 
-#import <math.h>
+#import "Reductions.hpp"
 
-double Min( const std::vector<double>& args )
+double Min( std::span<const double> args )
 {
-	double theMin = INFINITY;
-	
-	for (double val : args)
-	{
-		theMin = fmin( theMin, val );
-	}
-	
-	return theMin;
+	return ReduceMin( args.data(), args.size() );
 }
@@ -29,8 +29,8 @@
 #ifndef Min_hpp
 #define Min_hpp
 
-#import <vector>
+#import <span>
 
-double Min( const std::vector<double>& args );
+double Min( std::span<const double> args );
 
 #endif /* Min_hpp */
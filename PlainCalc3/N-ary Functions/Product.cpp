@@ -28,15 +28,11 @@
 
 #import "Product.hpp"
 
-#import <numeric>
+#import "ScaledProduct.hpp"
 
-double Product( const std::vector<double>& args )
+double Product( std::span<const double> args )
 {
-	double theProd = std::accumulate( args.cbegin(), args.cend(), 1.0,
-		[]( double a, double b )-> double
-		{
-			return a * b;
-		} );
-	
-	return theProd;
+	// Overflow or underflow of partial products does not matter unless the
+	// whole product is out of range.
+	return ComputeScaledProduct( args.data(), args.size() ).Value();
 }
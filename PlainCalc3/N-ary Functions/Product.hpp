@@ -29,8 +29,8 @@
 #ifndef Product_hpp
 #define Product_hpp
 
-#import <vector>
+#import <span>
 
-double Product( const std::vector<double>& args );
+double Product( std::span<const double> args );
 
 #endif /* Product_hpp */
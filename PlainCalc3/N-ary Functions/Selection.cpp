@@ -0,0 +1,80 @@
+//  Selection.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "Selection.hpp"
+
+#import <algorithm>
+#import <math.h>
+
+std::vector<double>&	SelectionBuffer( const double* inValues, size_t inCount )
+{
+	thread_local std::vector<double> sBuffer;
+	
+	sBuffer.assign( inValues, inValues + inCount );
+	
+	return sBuffer;
+}
+
+double	SelectQuantile( std::vector<double>& ioValues, double inProbability )
+{
+	// NaN would break the ordering that selection depends on.
+	if ( ioValues.empty() or not (inProbability >= 0.0) or
+		(inProbability > 1.0) or
+		std::any_of( ioValues.cbegin(), ioValues.cend(),
+			[]( double x ) { return isnan( x ); } ) )
+	{
+		return NAN;
+	}
+	
+	const double h = (ioValues.size() - 1) * inProbability;
+	const double lowIndex = floor( h );
+	const double fraction = h - lowIndex;
+	auto lowIt = ioValues.begin() + static_cast<ptrdiff_t>( lowIndex );
+	
+	std::nth_element( ioValues.begin(), lowIt, ioValues.end() );
+	double result = *lowIt;
+	
+	// Everything after the selected element is at least as large, so the
+	// next order statistic is the smallest of those.
+	if (fraction > 0.0)
+	{
+		const double high = *std::min_element( lowIt + 1, ioValues.end() );
+		
+		// The difference is infinite or NaN if either value is infinite, and
+		// then only the weighted average of the two gives the limit.  Equal
+		// values need no interpolation, even if they are infinite.
+		if (high != result)
+		{
+			result = isfinite( high - result )?
+				result + fraction * (high - result) :
+				(1.0 - fraction) * result + fraction * high;
+		}
+	}
+	
+	return result;
+}
@@ -0,0 +1,72 @@
+//  Selection.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef Selection_hpp
+#define Selection_hpp
+
+#import <stddef.h>
+#import <vector>
+
+/*!
+	@function	SelectionBuffer
+	
+	@abstract	Copy numbers into a scratch buffer that can be reordered.
+	
+	@discussion	The buffer belongs to the current thread and keeps its
+				storage from one call to the next, so that repeated
+				selections do not allocate memory.  Its contents are only
+				valid until the next call on the same thread.
+	
+	@param		inValues	The numbers.
+	@param		inCount		The number of numbers.
+	@result		The buffer, holding a copy of the numbers.
+*/
+std::vector<double>&	SelectionBuffer( const double* inValues, size_t inCount );
+
+/*!
+	@function	SelectQuantile
+	
+	@abstract	Find a quantile of some numbers by selection rather than by
+				sorting.
+	
+	@discussion	The quantile is interpolated linearly between order
+				statistics, as in the default method of R and the
+				PERCENTILE.INC function of spreadsheets: if the numbers in
+				increasing order are x[0], ..., x[n-1], and h = (n - 1) p, the
+				result is x[floor(h)] + (h - floor(h)) (x[floor(h)+1] -
+				x[floor(h)]).  Selection takes linear time on average.
+	
+	@param		ioValues		The numbers, which are reordered.  Must not be
+								empty.
+	@param		inProbability	A number from 0 to 1.
+	@result		The quantile, or NaN if the probability is out of range or
+				any of the numbers is NaN.
+*/
+double	SelectQuantile( std::vector<double>& ioValues, double inProbability );
+
+#endif /* Selection_hpp */
@@ -32,7 +32,7 @@
 
 #import <math.h>
 
-double StandardDeviation( const std::vector<double>& args )
+double StandardDeviation( std::span<const double> args )
 {
 	return sqrt( Variance( args ) );
 }
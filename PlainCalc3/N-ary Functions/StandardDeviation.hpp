@@ -29,8 +29,8 @@
 #ifndef StandardDeviation_hpp
 #define StandardDeviation_hpp
 
-#import <vector>
+#import <span>
 
-double StandardDeviation( const std::vector<double>& args );
+double StandardDeviation( std::span<const double> args );
 
 #endif /* StandardDeviation_hpp */
@@ -28,15 +28,9 @@
 
 #import "Sum.hpp"
 
-#import <numeric>
+#import "Reductions.hpp"
 
-double Sum( const std::vector<double>& args )
+double Sum( std::span<const double> args )
 {
-	double theSum = std::accumulate( args.cbegin(), args.cend(), 0.0,
-		[]( double a, double b )-> double
-		{
-			return a + b;
-		} );
-	
-	return theSum;
+	return ReduceSum( args.data(), args.size() );
 }
@@ -29,8 +29,8 @@
 #ifndef Sum_hpp
 #define Sum_hpp
 
-#import <vector>
+#import <span>
 
-double Sum( const std::vector<double>& args );
+double Sum( std::span<const double> args );
 
 #endif /* Sum_hpp */
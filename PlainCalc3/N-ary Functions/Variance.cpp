@@ -28,20 +28,9 @@
 
 #import "Variance.hpp"
 
-#import "Average.hpp"
+#import "Moments.hpp"
 
-#import <numeric>
-
-double Variance( const std::vector<double>& args )
+double Variance( std::span<const double> args )
 {
-	double mean = Average( args );
-	
-	double sumOfSquaredDiffs = std::accumulate( args.cbegin(), args.cend(), 0.0,
-		[mean]( double a, double b )->double
-		{
-			double diff = b - mean;
-			return a + diff * diff;
-		} );
-	
-	return sumOfSquaredDiffs / args.size();
+	return ComputeMoments( args.data(), args.size() ).Variance();
 }
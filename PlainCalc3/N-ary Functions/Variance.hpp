@@ -29,8 +29,8 @@
 #ifndef Variance_hpp
 #define Variance_hpp
 
-#import <vector>
+#import <span>
 
-double Variance( const std::vector<double>& args );
+double Variance( std::span<const double> args );
 
 #endif /* Variance_hpp */
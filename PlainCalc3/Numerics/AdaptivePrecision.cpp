@@ -0,0 +1,573 @@
+//  AdaptivePrecision.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "AdaptivePrecision.hpp"
+
+#import "Average.hpp"
+#import "BasicMath.hpp"
+#import "BinaryFuncNode.hpp"
+#import "Built-ins.hpp"
+#import "Differentiation.hpp"
+#import "Max.hpp"
+#import "Min.hpp"
+#import "NaryFuncNode.hpp"
+#import "NumberNode.hpp"
+#import "SCalcState.hpp"
+#import "Sum.hpp"
+#import "UnaryFuncNode.hpp"
+
+#import <boost/math/constants/constants.hpp>
+#import <boost/multiprecision/cpp_bin_float.hpp>
+
+#import <algorithm>
+#import <map>
+#import <math.h>
+#import <numeric>
+#import <set>
+#import <string>
+#import <vector>
+
+using Extended = boost::multiprecision::cpp_bin_float_50;
+
+using ExtendedUnary = Extended (*)( const Extended& );
+using ExtendedBinary = Extended (*)( const Extended&, const Extended& );
+using ExtendedNary = Extended (*)( const std::vector<Extended>& );
+
+// Bound on the relative error of a correctly rounded operation.
+static constexpr double kUnitRoundoff = 0x1p-53;
+
+// Library functions such as sin and exp are not always correctly rounded,
+// but they are accurate to within an ulp.
+static constexpr double kLibraryRoundoff = 2.0 * kUnitRoundoff;
+
+// A value computed in double precision, and a bound on its absolute error.
+struct BoundedValue
+{
+	double	value;
+	double	error;
+};
+
+// Values of the subtrees that are not arithmetic on built-in functions, in
+// the order in which they were met, so that the extended precision pass can
+// use them without evaluating those subtrees again.
+using LeafValues = std::vector<double>;
+
+// Functions are looked up by name, as in Differentiation.cpp, since some of
+// them are not visible outside of Built-ins.cpp.
+template <typename Func, typename Counterpart>
+static std::map< Func, Counterpart > MakeCounterpartMap(
+	const symbolsJW< Func >& inSymbols,
+	const std::map< std::string, Counterpart >& inByName )
+{
+	std::map< Func, Counterpart > result;
+	
+	for (const auto& [name, func] : inSymbols.Pairs())
+	{
+		auto foundIt = inByName.find( name );
+		if (foundIt != inByName.end())
+		{
+			result[ func ] = foundIt->second;
+		}
+	}
+	
+	return result;
+}
+
+static const std::map< UnaryFunc, ExtendedUnary >&	UnaryCounterparts()
+{
+	static const std::map< UnaryFunc, ExtendedUnary > sCounterparts(
+		[]()
+		{
+			std::map< std::string, ExtendedUnary > byName
+			{
+				{ "atan", []( const Extended& x ) -> Extended { return atan( x ); } },
+				{ "acos", []( const Extended& x ) -> Extended { return acos( x ); } },
+				{ "asin", []( const Extended& x ) -> Extended { return asin( x ); } },
+				{ "sin", []( const Extended& x ) -> Extended { return sin( x ); } },
+				{ "cos", []( const Extended& x ) -> Extended { return cos( x ); } },
+				{ "tan", []( const Extended& x ) -> Extended { return tan( x ); } },
+				{ "ceil", []( const Extended& x ) -> Extended { return ceil( x ); } },
+				{ "floor", []( const Extended& x ) -> Extended { return floor( x ); } },
+				{ "round", []( const Extended& x ) -> Extended { return round( x ); } },
+				{ "fabs", []( const Extended& x ) -> Extended { return abs( x ); } },
+				{ "abs", []( const Extended& x ) -> Extended { return abs( x ); } },
+				{ "log", []( const Extended& x ) -> Extended { return log( x ); } },
+				{ "ln", []( const Extended& x ) -> Extended { return log( x ); } },
+				{ "log10", []( const Extended& x ) -> Extended { return log10( x ); } },
+				{ "log2", []( const Extended& x ) -> Extended
+					{ return log( x ) / boost::math::constants::ln_two<Extended>(); } },
+				{ "exp", []( const Extended& x ) -> Extended { return exp( x ); } },
+				{ "rad", []( const Extended& x ) -> Extended
+					{ return x * boost::math::constants::pi<Extended>() / 180; } },
+				{ "deg", []( const Extended& x ) -> Extended
+					{ return x * 180 / boost::math::constants::pi<Extended>(); } },
+				{ "sqrt", []( const Extended& x ) -> Extended { return sqrt( x ); } },
+				{ "√", []( const Extended& x ) -> Extended { return sqrt( x ); } }
+			};
+			std::map< UnaryFunc, ExtendedUnary > result( MakeCounterpartMap(
+				BuiltInUnarySyms(), byName ) );
+			result[ Negate ] = []( const Extended& x ) -> Extended { return -x; };
+			return result;
+		}() );
+	
+	return sCounterparts;
+}
+
+static const std::map< BinaryFunc, ExtendedBinary >&	BinaryCounterparts()
+{
+	static const std::map< BinaryFunc, ExtendedBinary > sCounterparts(
+		[]()
+		{
+			std::map< std::string, ExtendedBinary > byName
+			{
+				{ "atan2", []( const Extended& y, const Extended& x ) -> Extended
+					{ return atan2( y, x ); } },
+				{ "hypot", []( const Extended& x, const Extended& y ) -> Extended
+					{ return sqrt( x * x + y * y ); } },
+				{ "pow", []( const Extended& x, const Extended& y ) -> Extended
+					{ return pow( x, y ); } }
+			};
+			std::map< BinaryFunc, ExtendedBinary > result( MakeCounterpartMap(
+				BuiltInBinarySyms(), byName ) );
+			result[ Plus ] = []( const Extended& x, const Extended& y ) -> Extended
+				{ return x + y; };
+			result[ Minus ] = []( const Extended& x, const Extended& y ) -> Extended
+				{ return x - y; };
+			result[ Multiply ] = []( const Extended& x, const Extended& y ) -> Extended
+				{ return x * y; };
+			result[ Divide ] = []( const Extended& x, const Extended& y ) -> Extended
+				{ return x / y; };
+			return result;
+		}() );
+	
+	return sCounterparts;
+}
+
+static Extended	ExtendedSum( const std::vector<Extended>& inArgs )
+{
+	Extended sum = 0;
+	for (const Extended& x : inArgs)
+	{
+		sum += x;
+	}
+	return sum;
+}
+
+static const std::map< NaryFunc, ExtendedNary >&	NaryCounterparts()
+{
+	static const std::map< NaryFunc, ExtendedNary > sCounterparts(
+		[]()
+		{
+			std::map< std::string, ExtendedNary > byName
+			{
+				{ "sum", ExtendedSum },
+				{ "average", []( const std::vector<Extended>& args ) -> Extended
+					{ return ExtendedSum( args ) / args.size(); } },
+				{ "mean", []( const std::vector<Extended>& args ) -> Extended
+					{ return ExtendedSum( args ) / args.size(); } },
+				{ "product", []( const std::vector<Extended>& args ) -> Extended
+					{
+						Extended product = 1;
+						for (const Extended& x : args)
+						{
+							product *= x;
+						}
+						return product;
+					} },
+				{ "min", []( const std::vector<Extended>& args ) -> Extended
+					{ return *std::min_element( args.begin(), args.end() ); } },
+				{ "max", []( const std::vector<Extended>& args ) -> Extended
+					{ return *std::max_element( args.begin(), args.end() ); } }
+			};
+			return MakeCounterpartMap( BuiltInNarySyms(), byName );
+		}() );
+	
+	return sCounterparts;
+}
+
+// Functions whose values are exact but jump at integers or half integers.
+static bool	IsStepFunction( UnaryFunc inFunc )
+{
+	static const std::set< UnaryFunc > sStepFuncs
+	{
+		BuiltInUnarySyms().at( "ceil" ),
+		BuiltInUnarySyms().at( "floor" ),
+		BuiltInUnarySyms().at( "round" )
+	};
+	return sStepFuncs.contains( inFunc );
+}
+
+static std::optional<BoundedValue>	EvaluateBounded( const ASTNode& inNode,
+												SCalcState& ioState,
+												LeafValues& ioLeaves );
+
+static std::optional<BoundedValue>	EvaluateBoundedUnary(
+												const UnaryFuncNode& inNode,
+												SCalcState& ioState,
+												LeafValues& ioLeaves )
+{
+	std::optional<BoundedValue> result;
+	std::optional<BoundedValue> arg( EvaluateBounded( *inNode.Children()[0],
+		ioState, ioLeaves ) );
+	
+	if (arg.has_value())
+	{
+		const UnaryFunc func = inNode.GetFunc();
+		const double x = arg->value, ex = arg->error;
+		const double fx = func( x );
+		double error = 0.0;
+		
+		if (func == Negate)
+		{
+			error = ex;
+		}
+		else if (IsStepFunction( func ))
+		{
+			// The derivative is 0, but an error in the argument may move
+			// it past a jump.
+			if (ex > 0.0)
+			{
+				error = std::max( fabs( func( x + ex ) - fx ),
+					fabs( func( x - ex ) - fx ) );
+			}
+		}
+		else
+		{
+			error = kLibraryRoundoff * fabs( fx );
+			if (ex > 0.0)
+			{
+				std::optional<Dual> slope( ApplyUnary( func, Dual{ x, 1.0 } ) );
+				error += slope.has_value()? fabs( slope->derivative ) * ex :
+					INFINITY;
+			}
+		}
+		
+		result = BoundedValue{ fx, error };
+	}
+	
+	return result;
+}
+
+static std::optional<BoundedValue>	EvaluateBoundedBinary(
+												const BinaryFuncNode& inNode,
+												SCalcState& ioState,
+												LeafValues& ioLeaves )
+{
+	std::optional<BoundedValue> result;
+	std::optional<BoundedValue> arg1( EvaluateBounded( *inNode.Children()[0],
+		ioState, ioLeaves ) );
+	std::optional<BoundedValue> arg2;
+	if (arg1.has_value())
+	{
+		arg2 = EvaluateBounded( *inNode.Children()[1], ioState, ioLeaves );
+	}
+	
+	if (arg2.has_value())
+	{
+		const BinaryFunc func = inNode.GetFunc();
+		const double x = arg1->value, ex = arg1->error;
+		const double y = arg2->value, ey = arg2->error;
+		const double fxy = func( x, y );
+		double error = 0.0;
+		
+		if ( (func == Plus) or (func == Minus) )
+		{
+			error = ex + ey + kUnitRoundoff * fabs( fxy );
+		}
+		else if (func == Multiply)
+		{
+			error = fabs( y ) * ex + fabs( x ) * ey + ex * ey +
+				kUnitRoundoff * fabs( fxy );
+		}
+		else if (func == Divide)
+		{
+			// If the error of the divisor could make it 0, there is no bound.
+			if (ey == 0.0)
+			{
+				error = ex / fabs( y ) + kUnitRoundoff * fabs( fxy );
+			}
+			else if (fabs( y ) > ey)
+			{
+				error = (ex + fabs( fxy ) * ey) / (fabs( y ) - ey) +
+					kUnitRoundoff * fabs( fxy );
+			}
+			else
+			{
+				error = INFINITY;
+			}
+		}
+		else
+		{
+			error = kLibraryRoundoff * fabs( fxy );
+			if (ex > 0.0)
+			{
+				std::optional<Dual> slope( ApplyBinary( func, Dual{ x, 1.0 },
+					Dual{ y, 0.0 } ) );
+				error += slope.has_value()? fabs( slope->derivative ) * ex :
+					INFINITY;
+			}
+			if (ey > 0.0)
+			{
+				std::optional<Dual> slope( ApplyBinary( func, Dual{ x, 0.0 },
+					Dual{ y, 1.0 } ) );
+				error += slope.has_value()? fabs( slope->derivative ) * ey :
+					INFINITY;
+			}
+		}
+		
+		result = BoundedValue{ fxy, error };
+	}
+	
+	return result;
+}
+
+static std::optional<BoundedValue>	EvaluateBoundedNary(
+												const NaryFuncNode& inNode,
+												SCalcState& ioState,
+												LeafValues& ioLeaves )
+{
+	std::optional<BoundedValue> result;
+	const size_t argCount = inNode.Children().size();
+	std::vector<double> values, errors;
+	values.reserve( argCount );
+	errors.reserve( argCount );
+	
+	for (const autoASTNode& child : inNode.Children())
+	{
+		std::optional<BoundedValue> arg( EvaluateBounded( *child, ioState,
+			ioLeaves ) );
+		if (not arg.has_value())
+		{
+			return result;
+		}
+		values.push_back( arg->value );
+		errors.push_back( arg->error );
+	}
+	
+	const NaryFunc func = inNode.GetFunc();
+	const double fx = func( values );
+	const double propagated = std::accumulate( errors.begin(), errors.end(),
+		0.0 );
+	double error = 0.0;
+	
+	if ( (func == Sum) or (func == Average) )
+	{
+		// The rounding errors of a sum are bounded relative to the sum of
+		// the magnitudes, not to the result, which may be much smaller.
+		double magnitudes = 0.0;
+		for (double x : values)
+		{
+			magnitudes += fabs( x );
+		}
+		error = propagated + (argCount - 1) * kUnitRoundoff * magnitudes;
+		if (func == Average)
+		{
+			error = error / argCount + kUnitRoundoff * fabs( fx );
+		}
+	}
+	else if ( (func == Min) or (func == Max) )
+	{
+		error = *std::max_element( errors.begin(), errors.end() );
+	}
+	else
+	{
+		error = argCount * kLibraryRoundoff * fabs( fx );
+		if (propagated > 0.0)
+		{
+			std::vector<Dual> duals( argCount );
+			for (size_t i = 0; i < argCount; ++i)
+			{
+				duals[i].value = values[i];
+			}
+			for (size_t i = 0; (i < argCount) and isfinite( error ); ++i)
+			{
+				if (errors[i] > 0.0)
+				{
+					duals[i].derivative = 1.0;
+					std::optional<Dual> slope( ApplyNary( func, duals ) );
+					duals[i].derivative = 0.0;
+					error += slope.has_value()?
+						fabs( slope->derivative ) * errors[i] : INFINITY;
+				}
+			}
+		}
+	}
+	
+	result = BoundedValue{ fx, error };
+	
+	return result;
+}
+
+static std::optional<BoundedValue>	EvaluateBounded( const ASTNode& inNode,
+												SCalcState& ioState,
+												LeafValues& ioLeaves )
+{
+	std::optional<BoundedValue> result;
+	
+	if (const NumberNode* numNode = dynamic_cast<const NumberNode*>( &inNode ))
+	{
+		result = BoundedValue{ numNode->Value(), 0.0 };
+	}
+	else if (const UnaryFuncNode* unNode =
+		dynamic_cast<const UnaryFuncNode*>( &inNode ))
+	{
+		result = EvaluateBoundedUnary( *unNode, ioState, ioLeaves );
+	}
+	else if (const BinaryFuncNode* binNode =
+		dynamic_cast<const BinaryFuncNode*>( &inNode ))
+	{
+		result = EvaluateBoundedBinary( *binNode, ioState, ioLeaves );
+	}
+	else if (const NaryFuncNode* naryNode =
+		dynamic_cast<const NaryFuncNode*>( &inNode ))
+	{
+		result = EvaluateBoundedNary( *naryNode, ioState, ioLeaves );
+	}
+	else
+	{
+		std::optional<double> leafValue( inNode.Evaluate( ioState ) );
+		if (leafValue.has_value())
+		{
+			ioLeaves.push_back( leafValue.value() );
+			result = BoundedValue{ leafValue.value(), 0.0 };
+		}
+	}
+	
+	return result;
+}
+
+// Evaluate in extended precision, visiting nodes in the same order as
+// EvaluateBounded, or return nothing if some function has no extended
+// precision counterpart.
+static std::optional<Extended>	EvaluateExtended( const ASTNode& inNode,
+												const LeafValues& inLeaves,
+												size_t& ioLeafIndex )
+{
+	std::optional<Extended> result;
+	
+	if (const NumberNode* numNode = dynamic_cast<const NumberNode*>( &inNode ))
+	{
+		result = Extended( numNode->Value() );
+	}
+	else if (const UnaryFuncNode* unNode =
+		dynamic_cast<const UnaryFuncNode*>( &inNode ))
+	{
+		auto foundIt = UnaryCounterparts().find( unNode->GetFunc() );
+		if (foundIt != UnaryCounterparts().end())
+		{
+			std::optional<Extended> arg( EvaluateExtended(
+				*unNode->Children()[0], inLeaves, ioLeafIndex ) );
+			if (arg.has_value())
+			{
+				result = foundIt->second( *arg );
+			}
+		}
+	}
+	else if (const BinaryFuncNode* binNode =
+		dynamic_cast<const BinaryFuncNode*>( &inNode ))
+	{
+		auto foundIt = BinaryCounterparts().find( binNode->GetFunc() );
+		if (foundIt != BinaryCounterparts().end())
+		{
+			std::optional<Extended> arg1( EvaluateExtended(
+				*binNode->Children()[0], inLeaves, ioLeafIndex ) );
+			std::optional<Extended> arg2;
+			if (arg1.has_value())
+			{
+				arg2 = EvaluateExtended( *binNode->Children()[1], inLeaves,
+					ioLeafIndex );
+			}
+			if (arg2.has_value())
+			{
+				result = foundIt->second( *arg1, *arg2 );
+			}
+		}
+	}
+	else if (const NaryFuncNode* naryNode =
+		dynamic_cast<const NaryFuncNode*>( &inNode ))
+	{
+		auto foundIt = NaryCounterparts().find( naryNode->GetFunc() );
+		if (foundIt != NaryCounterparts().end())
+		{
+			std::vector<Extended> args;
+			args.reserve( naryNode->Children().size() );
+			for (const autoASTNode& child : naryNode->Children())
+			{
+				std::optional<Extended> arg( EvaluateExtended( *child,
+					inLeaves, ioLeafIndex ) );
+				if (not arg.has_value())
+				{
+					return result;
+				}
+				args.push_back( std::move( *arg ) );
+			}
+			result = foundIt->second( args );
+		}
+	}
+	else if (ioLeafIndex < inLeaves.size())
+	{
+		result = Extended( inLeaves[ ioLeafIndex ] );
+		++ioLeafIndex;
+	}
+	
+	return result;
+}
+
+std::optional<AdaptiveValue>	EvaluateAdaptively( const ASTNode& inTree,
+									double inTolerance, SCalcState& ioState )
+{
+	std::optional<AdaptiveValue> result;
+	LeafValues leaves;
+	
+	std::optional<BoundedValue> fast( EvaluateBounded( inTree, ioState,
+		leaves ) );
+	
+	if (fast.has_value())
+	{
+		result = AdaptiveValue{ fast->value, fast->error, false };
+		
+		// The comparison is false if the bound is NaN.
+		const bool isAccurate = isfinite( fast->value ) and
+			(fast->error <= inTolerance * fabs( fast->value ));
+		
+		if ( (not isAccurate) and
+			(ioState.interruptCode == CalcInterruptCode::none) )
+		{
+			size_t leafIndex = 0;
+			std::optional<Extended> precise( EvaluateExtended( inTree, leaves,
+				leafIndex ) );
+			if (precise.has_value())
+			{
+				result->value = precise->convert_to<double>();
+				result->isExtended = true;
+			}
+		}
+	}
+	
+	return result;
+}
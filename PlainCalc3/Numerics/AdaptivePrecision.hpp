@@ -0,0 +1,84 @@
+//  AdaptivePrecision.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef AdaptivePrecision_hpp
+#define AdaptivePrecision_hpp
+
+#import <optional>
+
+class ASTNode;
+struct SCalcState;
+
+/*!
+	@struct		AdaptiveValue
+	@abstract	The result of EvaluateAdaptively.
+*/
+struct AdaptiveValue
+{
+	double		value = 0.0;
+	double		errorBound = 0.0;	// of the double precision value, or infinite
+	bool		isExtended = false;	// whether value was recomputed
+};
+
+/*!
+	@function	EvaluateAdaptively
+	
+	@abstract	Evaluate a syntax tree in double precision, falling back to
+				extended precision if rounding errors may have spoiled the
+				result.
+	
+	@discussion	The double precision evaluation carries a bound on the
+				absolute error of each intermediate value, which is updated
+				at each operation by running error analysis: the errors of
+				the operands are propagated to first order using the
+				derivatives of the operation, and the rounding error of the
+				operation itself is added.  Subtracting nearly equal numbers
+				is the typical way for the relative error to grow.
+				
+				If the bound exceeds the tolerance relative to the result, or
+				the result is infinite or NaN, the tree is evaluated again with
+				50 significant decimal digits, provided that it only involves
+				numbers, arithmetic operators, and built-in functions that
+				have extended precision counterparts.  Subtrees of other
+				kinds, such as calls of user functions, iterations, and
+				integrals, are evaluated only once, in double precision, and
+				their values are treated as exact.
+				
+				The syntax tree should be built with constant folding
+				deferred, see SCalcState::FoldedValue, since a folded tree
+				has already done its arithmetic in double precision.
+	
+	@param		inTree			A syntax tree.
+	@param		inTolerance		The largest acceptable relative error bound.
+	@param		ioState			A calculator state.
+	@result		The value, or nothing if the tree could not be evaluated.
+*/
+std::optional<AdaptiveValue>	EvaluateAdaptively( const ASTNode& inTree,
+									double inTolerance, SCalcState& ioState );
+
+#endif /* AdaptivePrecision_hpp */
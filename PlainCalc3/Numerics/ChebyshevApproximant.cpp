@@ -0,0 +1,210 @@
+//  ChebyshevApproximant.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "ChebyshevApproximant.hpp"
+
+#import <algorithm>
+#import <array>
+#import <float.h>
+#import <math.h>
+#import <utility>
+
+// Number of Chebyshev coefficients of each piece, i.e., one more than the
+// degree of the interpolating polynomial.
+static constexpr size_t kPointCount = 17;
+
+// The error of a piece is measured at every kTestPointStride-th extremum of
+// the Chebyshev polynomial of degree kPointCount, which include the ends of
+// the piece.
+static constexpr size_t kTestPointStride = 2;
+
+// Limit on the number of pieces, so that a function that can not be
+// approximated (e.g., one with a jump) does not take forever.
+static constexpr size_t kMaxPieces = 1024;
+
+// Tolerances smaller than this many rounding errors in the function values
+// can not be met reliably, so they are treated as this.
+static constexpr double kRoundingErrorFactor = 64.0;
+
+using Coefficients = std::array< double, kPointCount >;
+
+namespace
+{
+	struct Piece
+	{
+		double			start;
+		double			end;
+		Coefficients	coeffs;
+		double			error;
+		double			scale;	// largest absolute function value
+	};
+}
+
+// Sum of the Chebyshev series at a point of [-1, 1], by Clenshaw's method.
+static double SumSeries( const double* inCoeffs, double inT )
+{
+	const double twoT = 2.0 * inT;
+	double b1 = 0.0, b2 = 0.0;
+	
+	for (size_t k = kPointCount - 1; k > 0; --k)
+	{
+		const double b0 = fma( twoT, b1, inCoeffs[k] - b2 );
+		b2 = b1;
+		b1 = b0;
+	}
+	
+	return fma( inT, b1, inCoeffs[0] - b2 );
+}
+
+static std::optional<Piece> FitPiece(
+	const std::function< std::optional<double>(double) >& inFunc,
+	double inStart, double inEnd )
+{
+	const double mid = 0.5 * (inStart + inEnd);
+	const double halfWidth = 0.5 * (inEnd - inStart);
+	Piece piece{ inStart, inEnd, {}, 0.0, 0.0 };
+	
+	// Values at the Chebyshev nodes cos( π (k + 1/2) / N ).
+	std::array< double, kPointCount > values;
+	for (size_t k = 0; k < kPointCount; ++k)
+	{
+		const double t = cos( M_PI * (k + 0.5) / kPointCount );
+		std::optional<double> value( inFunc( fma( halfWidth, t, mid ) ) );
+		if ( (not value.has_value()) or (not isfinite( *value )) )
+		{
+			return std::nullopt;
+		}
+		values[k] = *value;
+		piece.scale = std::max( piece.scale, fabs( *value ) );
+	}
+	
+	for (size_t j = 0; j < kPointCount; ++j)
+	{
+		double sum = 0.0;
+		for (size_t k = 0; k < kPointCount; ++k)
+		{
+			sum += values[k] * cos( M_PI * j * (k + 0.5) / kPointCount );
+		}
+		piece.coeffs[j] = sum * 2.0 / kPointCount;
+	}
+	piece.coeffs[0] *= 0.5;
+	
+	// The last coefficients indicate how fast the series converges, but can
+	// be small by accident, so we also compare with actual function values
+	// between the nodes.
+	piece.error = fabs( piece.coeffs[kPointCount - 1] ) +
+		fabs( piece.coeffs[kPointCount - 2] );
+	for (size_t i = 0; i <= kPointCount; i += kTestPointStride)
+	{
+		const double t = cos( M_PI * i / kPointCount );
+		std::optional<double> value( inFunc( fma( halfWidth, t, mid ) ) );
+		if ( (not value.has_value()) or (not isfinite( *value )) )
+		{
+			return std::nullopt;
+		}
+		piece.error = std::max( piece.error,
+			fabs( *value - SumSeries( piece.coeffs.data(), t ) ) );
+		piece.scale = std::max( piece.scale, fabs( *value ) );
+	}
+	
+	return piece;
+}
+
+std::shared_ptr<const ChebyshevApproximant>
+ChebyshevApproximant::Build( const std::function< std::optional<double>(double) >& inFunc,
+							double inStart, double inEnd, double inTolerance )
+{
+	if ( (not isfinite( inStart )) or (not isfinite( inEnd )) or
+		(inStart >= inEnd) or (not (inTolerance > 0.0)) )
+	{
+		return nullptr;
+	}
+	
+	std::vector<Piece> pieces;
+	
+	// Intervals yet to be fitted, with the leftmost one on top.
+	std::vector< std::pair<double, double> > pending{ { inStart, inEnd } };
+	
+	while (not pending.empty())
+	{
+		auto [ start, end ] = pending.back();
+		pending.pop_back();
+		
+		std::optional<Piece> piece( FitPiece( inFunc, start, end ) );
+		if (not piece.has_value())
+		{
+			return nullptr;
+		}
+		
+		const double allowed = std::max( inTolerance * std::max( 1.0, piece->scale ),
+			kRoundingErrorFactor * DBL_EPSILON * piece->scale );
+		
+		if (piece->error <= allowed)
+		{
+			pieces.push_back( *piece );
+		}
+		else
+		{
+			const double mid = 0.5 * (start + end);
+			if ( (mid <= start) or (mid >= end) or
+				(pieces.size() + pending.size() + 2 > kMaxPieces) )
+			{
+				return nullptr;
+			}
+			pending.emplace_back( mid, end );
+			pending.emplace_back( start, mid );
+		}
+	}
+	
+	std::shared_ptr<ChebyshevApproximant> result( new ChebyshevApproximant );
+	result->_breaks.reserve( pieces.size() + 1 );
+	result->_coefficients.reserve( pieces.size() * kPointCount );
+	result->_breaks.push_back( inStart );
+	for (const Piece& piece : pieces)
+	{
+		result->_breaks.push_back( piece.end );
+		result->_coefficients.insert( result->_coefficients.end(),
+			piece.coeffs.begin(), piece.coeffs.end() );
+		result->_errorBound = std::max( result->_errorBound, piece.error );
+	}
+	
+	return result;
+}
+
+double	ChebyshevApproximant::Evaluate( double inX ) const noexcept
+{
+	// Find the piece containing inX among the interior breaks.
+	const size_t pieceIndex = std::upper_bound( _breaks.begin() + 1,
+		_breaks.end() - 1, inX ) - (_breaks.begin() + 1);
+	const double start = _breaks[ pieceIndex ];
+	const double end = _breaks[ pieceIndex + 1 ];
+	const double t = (2.0 * inX - start - end) / (end - start);
+	
+	return SumSeries( &_coefficients[ pieceIndex * kPointCount ], t );
+}
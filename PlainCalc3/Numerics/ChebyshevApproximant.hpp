@@ -0,0 +1,109 @@
+//  ChebyshevApproximant.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef ChebyshevApproximant_hpp
+#define ChebyshevApproximant_hpp
+
+#import <stddef.h>
+#import <functional>
+#import <memory>
+#import <optional>
+#import <vector>
+
+/*!
+	@class		ChebyshevApproximant
+	
+	@abstract	A piecewise polynomial approximation of a function of one
+				variable on a closed interval.
+	
+	@discussion	On each piece, the function is represented by its Chebyshev
+				interpolant of fixed degree.  Pieces are found by bisecting the
+				interval until each interpolant is accurate to the requested
+				tolerance, so that pieces are small where the function varies
+				rapidly and large where it is smooth.
+*/
+class ChebyshevApproximant
+{
+public:
+	/*!
+		@function	Build
+		@abstract	Approximate a function on an interval.
+		@param		inFunc			The function being approximated.  If it
+									fails to produce a value, so does Build.
+		@param		inStart			Start of the interval.
+		@param		inEnd			End of the interval, greater than inStart.
+		@param		inTolerance		Requested accuracy, relative to the size
+									of the function values if they exceed 1.
+		@result		An approximant, or nullptr if the function could not be
+					evaluated or approximated to the tolerance.
+	*/
+	static std::shared_ptr<const ChebyshevApproximant>
+					Build( const std::function< std::optional<double>(double) >& inFunc,
+						double inStart, double inEnd, double inTolerance );
+	
+	/*!
+		@function	Contains
+		@abstract	Test whether a number is within the interval of approximation.
+	*/
+	bool			Contains( double inX ) const noexcept
+					{
+						return (inX >= _breaks.front()) and (inX <= _breaks.back());
+					}
+	
+	/*!
+		@function	Evaluate
+		@abstract	Evaluate the approximant at a point where Contains is true.
+	*/
+	double			Evaluate( double inX ) const noexcept;
+	
+	/*!
+		@function	ErrorBound
+		@abstract	Get an estimate of the largest error of the approximant.
+	*/
+	double			ErrorBound() const noexcept { return _errorBound; }
+	
+	/*!
+		@function	PieceCount
+		@abstract	Get the number of polynomial pieces.
+	*/
+	size_t			PieceCount() const noexcept { return _breaks.size() - 1; }
+
+private:
+					ChebyshevApproximant() = default;
+	
+	// Ends of the pieces, in increasing order.
+	std::vector<double>		_breaks;
+	
+	// Chebyshev coefficients of all the pieces, one piece after another.
+	std::vector<double>		_coefficients;
+	
+	double					_errorBound = 0.0;
+};
+
+#endif /* ChebyshevApproximant_hpp */
@@ -0,0 +1,412 @@
+//  Differentiation.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "Differentiation.hpp"
+
+#import "BasicMath.hpp"
+
+#import <algorithm>
+#import <map>
+#import <math.h>
+#import <numeric>
+#import <string>
+
+// The derivative of a function of one variable at x, given f(x).
+using UnaryDerivative = double (*)( double x, double fx );
+
+// The derivative of a function of two or more variables, given the value of
+// the function.
+using NaryDerivative = double (*)( const std::vector<Dual>& args, double fx );
+
+// Functions are looked up by name when building the tables of derivatives,
+// since some of them are not visible outside of Built-ins.cpp.
+template <typename Func, typename Derivative>
+static std::map< Func, Derivative > MakeDerivativeMap(
+	const symbolsJW< Func >& inSymbols,
+	const std::map< std::string, Derivative >& inByName )
+{
+	std::map< Func, Derivative > result;
+	
+	for (const auto& [name, func] : inSymbols.Pairs())
+	{
+		auto foundIt = inByName.find( name );
+		if (foundIt != inByName.end())
+		{
+			result[ func ] = foundIt->second;
+		}
+	}
+	
+	return result;
+}
+
+static const std::map< UnaryFunc, UnaryDerivative >&	UnaryDerivatives()
+{
+	static const std::map< UnaryFunc, UnaryDerivative > sDerivatives(
+		[]()
+		{
+			std::map< std::string, UnaryDerivative > byName
+			{
+				{ "atan", []( double x, double ) { return 1.0 / fma( x, x, 1.0 ); } },
+				{ "acos", []( double x, double ) { return -1.0 / sqrt( fma( -x, x, 1.0 ) ); } },
+				{ "asin", []( double x, double ) { return 1.0 / sqrt( fma( -x, x, 1.0 ) ); } },
+				{ "sin", []( double x, double ) { return cos( x ); } },
+				{ "cos", []( double x, double ) { return - sin( x ); } },
+				{ "tan", []( double, double fx ) { return fma( fx, fx, 1.0 ); } },
+				{ "ceil", []( double, double ) { return 0.0; } },
+				{ "floor", []( double, double ) { return 0.0; } },
+				{ "round", []( double, double ) { return 0.0; } },
+				{ "fabs", []( double x, double ) { return (x > 0.0)? 1.0 : ((x < 0.0)? -1.0 : 0.0); } },
+				{ "abs", []( double x, double ) { return (x > 0.0)? 1.0 : ((x < 0.0)? -1.0 : 0.0); } },
+				{ "log", []( double x, double ) { return 1.0 / x; } },
+				{ "ln", []( double x, double ) { return 1.0 / x; } },
+				{ "log10", []( double x, double ) { return 1.0 / (x * M_LN10); } },
+				{ "log2", []( double x, double ) { return 1.0 / (x * M_LN2); } },
+				{ "exp", []( double, double fx ) { return fx; } },
+				{ "rad", []( double, double ) { return M_PI / 180.0; } },
+				{ "deg", []( double, double ) { return 180.0 / M_PI; } },
+				{ "sqrt", []( double, double fx ) { return 0.5 / fx; } },
+				{ "√", []( double, double fx ) { return 0.5 / fx; } }
+			};
+			std::map< UnaryFunc, UnaryDerivative > result( MakeDerivativeMap(
+				BuiltInUnarySyms(), byName ) );
+			result[ Negate ] = []( double, double ) { return -1.0; };
+			return result;
+		}() );
+	
+	return sDerivatives;
+}
+
+std::optional<Dual>	ApplyUnary( UnaryFunc inFunc, const Dual& inArg )
+{
+	std::optional<Dual> result;
+	const double fx = inFunc( inArg.value );
+	
+	if (inArg.derivative == 0.0)
+	{
+		result = Dual{ fx, 0.0 };
+	}
+	else
+	{
+		auto foundIt = UnaryDerivatives().find( inFunc );
+		if (foundIt != UnaryDerivatives().end())
+		{
+			result = Dual{ fx,
+				foundIt->second( inArg.value, fx ) * inArg.derivative };
+		}
+	}
+	
+	return result;
+}
+
+std::optional<Dual>	ApplyBinary( BinaryFunc inFunc, const Dual& inArg1,
+								const Dual& inArg2 )
+{
+	std::optional<Dual> result;
+	const double x = inArg1.value, y = inArg2.value;
+	const double dx = inArg1.derivative, dy = inArg2.derivative;
+	const double fxy = inFunc( x, y );
+	
+	if ( (dx == 0.0) and (dy == 0.0) )
+	{
+		result = Dual{ fxy, 0.0 };
+	}
+	else if (inFunc == Plus)
+	{
+		result = Dual{ fxy, dx + dy };
+	}
+	else if (inFunc == Minus)
+	{
+		result = Dual{ fxy, dx - dy };
+	}
+	else if (inFunc == Multiply)
+	{
+		result = Dual{ fxy, fma( dx, y, x * dy ) };
+	}
+	else if (inFunc == Divide)
+	{
+		result = Dual{ fxy, (dx - fxy * dy) / y };
+	}
+	else if (inFunc == static_cast<BinaryFunc>( ::pow ))
+	{
+		// Leave out terms with zero derivatives, so that, e.g., the
+		// derivative of x^2 is defined for negative x.
+		double derivative = 0.0;
+		if (dx != 0.0)
+		{
+			derivative = y * pow( x, y - 1.0 ) * dx;
+		}
+		if (dy != 0.0)
+		{
+			derivative += fxy * log( x ) * dy;
+		}
+		result = Dual{ fxy, derivative };
+	}
+	else if (inFunc == BuiltInBinarySyms().at( "atan2" ))
+	{
+		// atan2( y, x ) is the angle of the point (x, y), so here x is the
+		// ordinate.
+		result = Dual{ fxy, (y * dx - x * dy) / fma( x, x, y * y ) };
+	}
+	else if (inFunc == BuiltInBinarySyms().at( "hypot" ))
+	{
+		result = Dual{ fxy, fma( x, dx, y * dy ) / fxy };
+	}
+	
+	return result;
+}
+
+//MARK: n-ary functions
+
+static double SumDerivative( const std::vector<Dual>& args, double )
+{
+	return std::accumulate( args.cbegin(), args.cend(), 0.0,
+		[]( double sum, const Dual& arg ) { return sum + arg.derivative; } );
+}
+
+static double AverageDerivative( const std::vector<Dual>& args, double fx )
+{
+	return SumDerivative( args, fx ) / args.size();
+}
+
+// Sum over i of the derivative of argument i times the product of the other
+// arguments, which works even if some arguments are zero.
+static double ProductDerivative( const std::vector<Dual>& args, double )
+{
+	const size_t n = args.size();
+	std::vector<double> suffixProducts( n + 1, 1.0 );
+	for (size_t i = n; i > 0; --i)
+	{
+		suffixProducts[ i - 1 ] = suffixProducts[ i ] * args[ i - 1 ].value;
+	}
+	
+	double derivative = 0.0;
+	double prefixProduct = 1.0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		derivative += args[i].derivative * prefixProduct * suffixProducts[ i + 1 ];
+		prefixProduct *= args[i].value;
+	}
+	
+	return derivative;
+}
+
+static double GeometricMeanDerivative( const std::vector<Dual>& args, double fx )
+{
+	double sum = 0.0;
+	for (const Dual& arg : args)
+	{
+		sum += arg.derivative / arg.value;
+	}
+	
+	return fx * sum / args.size();
+}
+
+static double HarmonicMeanDerivative( const std::vector<Dual>& args, double fx )
+{
+	double sum = 0.0;
+	for (const Dual& arg : args)
+	{
+		sum += arg.derivative / (arg.value * arg.value);
+	}
+	
+	return fx * fx * sum / args.size();
+}
+
+// The derivative of the population variance is 2/n times the sum of
+// (x_i - mean) dx_i, since the terms involving the derivative of the mean
+// add up to zero.
+static double CenteredSum( const std::vector<Dual>& args )
+{
+	double mean = 0.0;
+	for (const Dual& arg : args)
+	{
+		mean += arg.value;
+	}
+	mean /= args.size();
+	
+	double sum = 0.0;
+	for (const Dual& arg : args)
+	{
+		sum += (arg.value - mean) * arg.derivative;
+	}
+	
+	return sum;
+}
+
+static double VarianceDerivative( const std::vector<Dual>& args, double )
+{
+	return 2.0 * CenteredSum( args ) / args.size();
+}
+
+static double StandardDeviationDerivative( const std::vector<Dual>& args, double fx )
+{
+	return CenteredSum( args ) / (args.size() * fx);
+}
+
+// The derivative of the argument whose value is the result.
+static double SelectedDerivative( const std::vector<Dual>& args, double fx )
+{
+	auto foundIt = std::find_if( args.cbegin(), args.cend(),
+		[fx]( const Dual& arg ) { return arg.value == fx; } );
+	
+	return (foundIt == args.cend())? NAN : foundIt->derivative;
+}
+
+// A quantile of the values, for a probability p with derivative dp, as
+// computed by SelectQuantile.  It interpolates linearly between two order
+// statistics, so its derivative interpolates theirs, plus the slope with
+// respect to p times dp.  Where p is exactly at an order statistic, the
+// slope is taken from the right.
+static Dual InterpolatedQuantile( std::vector<Dual> ioArgs, double p, double dp )
+{
+	std::stable_sort( ioArgs.begin(), ioArgs.end(),
+		[]( const Dual& a, const Dual& b ) { return a.value < b.value; } );
+	
+	const size_t n = ioArgs.size();
+	const double h = (n - 1) * p;
+	if ( (n == 0) or not (h >= 0.0) or (h > n - 1) )
+	{
+		return Dual{ NAN, NAN };
+	}
+	const size_t lowIndex = static_cast<size_t>( floor( h ) );
+	const double fraction = h - lowIndex;
+	const Dual& low( ioArgs[ lowIndex ] );
+	const Dual& high( ioArgs[ std::min( lowIndex + 1, n - 1 ) ] );
+	
+	Dual result{ low.value, (1.0 - fraction) * low.derivative +
+		fraction * high.derivative };
+	if ( (fraction > 0.0) and (high.value != low.value) )
+	{
+		result.value += fraction * (high.value - low.value);
+	}
+	if (dp != 0.0)
+	{
+		result.derivative += (n - 1) * (high.value - low.value) * dp;
+	}
+	
+	return result;
+}
+
+static double MedianDerivative( const std::vector<Dual>& args, double )
+{
+	return InterpolatedQuantile( args, 0.5, 0.0 ).derivative;
+}
+
+static double QuantileDerivative( const std::vector<Dual>& args, double )
+{
+	return InterpolatedQuantile( std::vector<Dual>( args.cbegin() + 1, args.cend() ),
+		args[0].value, args[0].derivative ).derivative;
+}
+
+static double PercentileDerivative( const std::vector<Dual>& args, double )
+{
+	return InterpolatedQuantile( std::vector<Dual>( args.cbegin() + 1, args.cend() ),
+		args[0].value / 100.0, args[0].derivative / 100.0 ).derivative;
+}
+
+static double InterquartileRangeDerivative( const std::vector<Dual>& args, double )
+{
+	return InterpolatedQuantile( args, 0.75, 0.0 ).derivative -
+		InterpolatedQuantile( args, 0.25, 0.0 ).derivative;
+}
+
+// The median of the absolute deviations from the median.  A deviation of
+// zero is treated as having derivative zero.
+static double MedianAbsoluteDeviationDerivative( const std::vector<Dual>& args, double )
+{
+	const Dual median( InterpolatedQuantile( args, 0.5, 0.0 ) );
+	std::vector<Dual> deviations;
+	deviations.reserve( args.size() );
+	for (const Dual& arg : args)
+	{
+		const double difference = arg.value - median.value;
+		const double sign = (difference > 0.0)? 1.0 : ((difference < 0.0)? -1.0 : 0.0);
+		deviations.push_back( Dual{ fabs( difference ),
+			sign * (arg.derivative - median.derivative) } );
+	}
+	
+	return InterpolatedQuantile( deviations, 0.5, 0.0 ).derivative;
+}
+
+static const std::map< NaryFunc, NaryDerivative >&	NaryDerivatives()
+{
+	static const std::map< NaryFunc, NaryDerivative > sDerivatives(
+		MakeDerivativeMap( BuiltInNarySyms(),
+			std::map< std::string, NaryDerivative >
+			{
+				{ "average", AverageDerivative },
+				{ "mean", AverageDerivative },
+				{ "GM", GeometricMeanDerivative },
+				{ "HM", HarmonicMeanDerivative },
+				{ "max", SelectedDerivative },
+				{ "min", SelectedDerivative },
+				{ "product", ProductDerivative },
+				{ "SD", StandardDeviationDerivative },
+				{ "σ", StandardDeviationDerivative },
+				{ "sum", SumDerivative },
+				{ "Var", VarianceDerivative },
+				{ "median", MedianDerivative },
+				{ "quantile", QuantileDerivative },
+				{ "percentile", PercentileDerivative },
+				{ "IQR", InterquartileRangeDerivative },
+				{ "MAD", MedianAbsoluteDeviationDerivative }
+			} ) );
+	
+	return sDerivatives;
+}
+
+std::optional<Dual>	ApplyNary( NaryFunc inFunc, const std::vector<Dual>& inArgs )
+{
+	std::optional<Dual> result;
+	
+	std::vector<double> values;
+	values.reserve( inArgs.size() );
+	bool isConstant = true;
+	for (const Dual& arg : inArgs)
+	{
+		values.push_back( arg.value );
+		isConstant = isConstant and (arg.derivative == 0.0);
+	}
+	const double fx = inFunc( values );
+	
+	if (isConstant)
+	{
+		result = Dual{ fx, 0.0 };
+	}
+	else
+	{
+		auto foundIt = NaryDerivatives().find( inFunc );
+		if (foundIt != NaryDerivatives().end())
+		{
+			result = Dual{ fx, foundIt->second( inArgs, fx ) };
+		}
+	}
+	
+	return result;
+}
@@ -0,0 +1,71 @@
+//  Differentiation.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef Differentiation_hpp
+#define Differentiation_hpp
+
+#import "Built-ins.hpp"
+#import "Dual.hpp"
+
+#import <optional>
+#import <vector>
+
+/*!
+	@function	ApplyUnary
+	@abstract	Apply a built-in function of one variable, or negation, to a
+				dual number.
+	@result		The dual result, or nothing if the function has no known
+				derivative.
+*/
+std::optional<Dual>	ApplyUnary( UnaryFunc inFunc, const Dual& inArg );
+
+/*!
+	@function	ApplyBinary
+	@abstract	Apply a built-in function of two variables, or an arithmetic
+				operator, to dual numbers.
+	@result		The dual result, or nothing if the function has no known
+				derivative.
+*/
+std::optional<Dual>	ApplyBinary( BinaryFunc inFunc, const Dual& inArg1,
+								const Dual& inArg2 );
+
+/*!
+	@function	ApplyNary
+	@abstract	Apply a built-in function of two or more variables to dual
+				numbers.
+	@discussion	The value is computed by the function itself, so it agrees
+				exactly with ordinary evaluation.  The derivative is the sum
+				of the partial derivatives times the derivatives of the
+				arguments.
+	@result		The dual result, or nothing if the function has no known
+				derivative.
+*/
+std::optional<Dual>	ApplyNary( NaryFunc inFunc, const std::vector<Dual>& inArgs );
+
+#endif /* Differentiation_hpp */
@@ -0,0 +1,415 @@
+//  Minimizer.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "Minimizer.hpp"
+
+#import <algorithm>
+#import <float.h>
+#import <math.h>
+#import <numeric>
+
+// Locations of minima are found to about this relative precision.
+static const double kSqrtEpsilon = sqrt( DBL_EPSILON );
+
+// Limit on the evaluations of Brent's method, which only matters if the
+// function is behaving badly.
+static constexpr size_t kMaxIntervalEvaluations = 1000;
+
+// Limit on the evaluations of the Nelder-Mead method, per variable.
+static constexpr size_t kMaxEvaluationsPerVariable = 2000;
+
+namespace
+{
+	/*
+		Counts evaluations of the function, and treats NaN as larger than
+		any number.
+	*/
+	class CountedObjective
+	{
+	public:
+		explicit		CountedObjective( const ObjectiveFunction& inFunc )
+							: _func( inFunc ) {}
+		
+		std::optional<double>	operator()( const std::vector<double>& inX )
+								{
+									++_count;
+									std::optional<double> result( _func( inX ) );
+									if (result.has_value() and isnan( *result ))
+									{
+										result = INFINITY;
+									}
+									return result;
+								}
+		
+		size_t			Count() const { return _count; }
+	
+	private:
+		const ObjectiveFunction&	_func;
+		size_t						_count = 0;
+	};
+	
+	struct Vertex
+	{
+		std::vector<double>	x;
+		double				f;
+	};
+}
+
+std::optional<MinimumResult>	MinimizeOnInterval( const ObjectiveFunction& inFunc,
+												double inLow, double inHigh )
+{
+	std::optional<MinimumResult> result;
+	if ( (not isfinite( inLow )) or (not isfinite( inHigh )) )
+	{
+		return result;
+	}
+	CountedObjective func( inFunc );
+	const double kGolden = 0.5 * (3.0 - sqrt( 5.0 ));
+	double a = std::min( inLow, inHigh );
+	double b = std::max( inLow, inHigh );
+	const double absTolerance = kSqrtEpsilon * (b - a) + DBL_MIN;
+	std::vector<double> point{ a + kGolden * (b - a) };
+	
+	// x is the best point so far, w the second best, and v the previous
+	// value of w.  d is the latest step and e the one before it.
+	double x = point[0];
+	std::optional<double> fx( func( point ) );
+	if (not fx.has_value())
+	{
+		return result;
+	}
+	double w = x, v = x, fw = *fx, fv = *fx;
+	double d = 0.0, e = 0.0;
+	
+	while (func.Count() < kMaxIntervalEvaluations)
+	{
+		const double m = 0.5 * (a + b);
+		const double tol = kSqrtEpsilon * fabs( x ) + absTolerance / 3.0;
+		if (fabs( x - m ) <= 2.0 * tol - 0.5 * (b - a))
+		{
+			break;
+		}
+		
+		bool useGolden = true;
+		if (fabs( e ) > tol)
+		{
+			// Fit a parabola through x, w, and v.
+			double r = (x - w) * (*fx - fv);
+			double q = (x - v) * (*fx - fw);
+			double p = (x - v) * q - (x - w) * r;
+			q = 2.0 * (q - r);
+			if (q > 0.0)
+			{
+				p = -p;
+			}
+			q = fabs( q );
+			r = e;
+			e = d;
+			if ( (fabs( p ) < fabs( 0.5 * q * r )) and (p > q * (a - x)) and
+				(p < q * (b - x)) )
+			{
+				d = p / q;
+				const double u = x + d;
+				if ( (u - a < 2.0 * tol) or (b - u < 2.0 * tol) )
+				{
+					d = copysign( tol, m - x );
+				}
+				useGolden = false;
+			}
+		}
+		if (useGolden)
+		{
+			e = (x < m)? b - x : a - x;
+			d = kGolden * e;
+		}
+		
+		const double u = (fabs( d ) >= tol)? x + d : x + copysign( tol, d );
+		point[0] = u;
+		std::optional<double> fu( func( point ) );
+		if (not fu.has_value())
+		{
+			return result;
+		}
+		
+		if (*fu <= *fx)
+		{
+			((u < x)? b : a) = x;
+			v = w; fv = fw;
+			w = x; fw = *fx;
+			x = u; fx = fu;
+		}
+		else
+		{
+			((u < x)? a : b) = u;
+			if ( (*fu <= fw) or (w == x) )
+			{
+				v = w; fv = fw;
+				w = u; fw = *fu;
+			}
+			else if ( (*fu <= fv) or (v == x) or (v == w) )
+			{
+				v = u; fv = *fu;
+			}
+		}
+	}
+	
+	result = MinimumResult{ { x }, *fx, func.Count() };
+	return result;
+}
+
+static bool	IsCollapsed( const std::vector<Vertex>& inSimplex,
+						const std::vector<double>& inSteps )
+{
+	const std::vector<double>& best( inSimplex.front().x );
+	for (size_t i = 1; i < inSimplex.size(); ++i)
+	{
+		for (size_t j = 0; j < best.size(); ++j)
+		{
+			const double tol = kSqrtEpsilon * std::max( fabs( best[j] ),
+				fabs( inSteps[j] ) );
+			if (fabs( inSimplex[i].x[j] - best[j] ) > tol)
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// One run of Nelder-Mead, with the adaptive parameters of Gao and Han, which
+// reduce to the standard ones in one or two dimensions.  Returns false if
+// the function could not be evaluated.
+static bool	NelderMead( CountedObjective& ioFunc,
+						const std::vector<double>& inSteps,
+						size_t inMaxEvaluations,
+						Vertex& ioBest )
+{
+	const size_t n = ioBest.x.size();
+	const double dim = static_cast<double>( std::max<size_t>( n, 2 ) );
+	const double kReflect = 1.0;
+	const double kExpand = 1.0 + 2.0 / dim;
+	const double kContract = 0.75 - 0.5 / dim;
+	const double kShrink = 1.0 - 1.0 / dim;
+	
+	std::vector<Vertex> simplex{ ioBest };
+	for (size_t i = 0; i < n; ++i)
+	{
+		Vertex vert{ ioBest.x, 0.0 };
+		vert.x[i] += inSteps[i];
+		std::optional<double> f( ioFunc( vert.x ) );
+		if (not f.has_value())
+		{
+			return false;
+		}
+		vert.f = *f;
+		simplex.push_back( std::move( vert ) );
+	}
+	
+	auto byValue = []( const Vertex& a, const Vertex& b ) { return a.f < b.f; };
+	std::vector<double> centroid( n );
+	
+	// Makes the point centroid + t * (worst - centroid).
+	auto along = [&]( double t ) -> std::optional<Vertex>
+	{
+		std::optional<Vertex> vert( Vertex{ centroid, 0.0 } );
+		for (size_t j = 0; j < n; ++j)
+		{
+			vert->x[j] += t * (simplex.back().x[j] - centroid[j]);
+		}
+		std::optional<double> f( ioFunc( vert->x ) );
+		if (f.has_value())
+		{
+			vert->f = *f;
+		}
+		else
+		{
+			vert.reset();
+		}
+		return vert;
+	};
+	
+	while (ioFunc.Count() < inMaxEvaluations)
+	{
+		std::sort( simplex.begin(), simplex.end(), byValue );
+		if (IsCollapsed( simplex, inSteps ))
+		{
+			break;
+		}
+		
+		std::fill( centroid.begin(), centroid.end(), 0.0 );
+		for (size_t i = 0; i < n; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				centroid[j] += simplex[i].x[j] / n;
+			}
+		}
+		
+		std::optional<Vertex> reflected( along( - kReflect ) );
+		if (not reflected.has_value())
+		{
+			return false;
+		}
+		
+		std::optional<Vertex> replacement;
+		if (reflected->f < simplex.front().f)
+		{
+			std::optional<Vertex> expanded( along( - kReflect * kExpand ) );
+			if (not expanded.has_value())
+			{
+				return false;
+			}
+			replacement = (expanded->f < reflected->f)? expanded : reflected;
+		}
+		else if (reflected->f < simplex[n-1].f)
+		{
+			replacement = reflected;
+		}
+		else
+		{
+			const bool isOutside = reflected->f < simplex.back().f;
+			std::optional<Vertex> contracted( along( isOutside?
+				- kReflect * kContract : kContract ) );
+			if (not contracted.has_value())
+			{
+				return false;
+			}
+			if (contracted->f < (isOutside? reflected->f : simplex.back().f))
+			{
+				replacement = contracted;
+			}
+		}
+		
+		if (replacement.has_value())
+		{
+			simplex.back() = std::move( *replacement );
+		}
+		else
+		{
+			// Shrink toward the best vertex.
+			for (size_t i = 1; i <= n; ++i)
+			{
+				for (size_t j = 0; j < n; ++j)
+				{
+					simplex[i].x[j] = simplex[0].x[j] +
+						kShrink * (simplex[i].x[j] - simplex[0].x[j]);
+				}
+				std::optional<double> f( ioFunc( simplex[i].x ) );
+				if (not f.has_value())
+				{
+					return false;
+				}
+				simplex[i].f = *f;
+			}
+		}
+	}
+	
+	ioBest = *std::min_element( simplex.begin(), simplex.end(), byValue );
+	return true;
+}
+
+std::optional<MinimumResult>	MinimizeFromPoint( const ObjectiveFunction& inFunc,
+												const std::vector<double>& inStart,
+												const std::vector<double>& inSteps )
+{
+	std::optional<MinimumResult> result;
+	CountedObjective func( inFunc );
+	const size_t maxEvaluations = kMaxEvaluationsPerVariable *
+		std::max<size_t>( inStart.size(), 1 );
+	
+	std::optional<double> f( func( inStart ) );
+	if (not f.has_value())
+	{
+		return result;
+	}
+	Vertex best{ inStart, *f };
+	if ( NelderMead( func, inSteps, maxEvaluations, best ) and
+		NelderMead( func, inSteps, maxEvaluations, best ) )
+	{
+		result = MinimumResult{ best.x, best.f, func.Count() };
+	}
+	
+	return result;
+}
+
+std::vector<double>	DefaultSimplexSteps( const std::vector<double>& inStart )
+{
+	std::vector<double> steps;
+	steps.reserve( inStart.size() );
+	for (double coord : inStart)
+	{
+		steps.push_back( (coord == 0.0)? 0.00025 : 0.05 * coord );
+	}
+	return steps;
+}
+
+// The radical inverse of the index in the given base, in [0, 1).
+static double RadicalInverse( size_t inIndex, unsigned int inBase )
+{
+	double result = 0.0;
+	double scale = 1.0 / inBase;
+	while (inIndex > 0)
+	{
+		result += (inIndex % inBase) * scale;
+		inIndex /= inBase;
+		scale /= inBase;
+	}
+	return result;
+}
+
+static bool IsPrime( unsigned int inNum )
+{
+	for (unsigned int d = 2; d * d <= inNum; ++d)
+	{
+		if (inNum % d == 0)
+		{
+			return false;
+		}
+	}
+	return inNum >= 2;
+}
+
+std::vector<double>	HaltonPoint( size_t inIndex,
+								const std::vector<double>& inLow,
+								const std::vector<double>& inHigh )
+{
+	std::vector<double> point;
+	point.reserve( inLow.size() );
+	unsigned int base = 1;
+	for (size_t j = 0; j < inLow.size(); ++j)
+	{
+		do
+		{
+			++base;
+		} while (not IsPrime( base ));
+		point.push_back( inLow[j] + (inHigh[j] - inLow[j]) *
+			RadicalInverse( inIndex, base ) );
+	}
+	return point;
+}
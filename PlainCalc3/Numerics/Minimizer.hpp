@@ -0,0 +1,124 @@
+//  Minimizer.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef Minimizer_hpp
+#define Minimizer_hpp
+
+#import <stddef.h>
+#import <functional>
+#import <optional>
+#import <vector>
+
+/*!
+	@typedef	ObjectiveFunction
+	@abstract	A function of several variables to be minimized.
+	@discussion	The function returns nothing if it cannot be evaluated, which
+				ends the search.  A NaN value is treated as larger than any
+				number, so that the search moves away from it.
+*/
+using ObjectiveFunction = std::function< std::optional<double>(
+	const std::vector<double>& ) >;
+
+/*!
+	@struct		MinimumResult
+	@abstract	A local minimum of a function, with the number of times the
+				function was evaluated to find it.
+*/
+struct MinimumResult
+{
+	std::vector<double>	location;
+	double				value = 0.0;
+	size_t				evaluationCount = 0;
+};
+
+/*!
+	@function	MinimizeOnInterval
+	
+	@abstract	Find a local minimum of a function of one variable within an
+				interval, by Brent's method.
+	
+	@discussion	Golden section search is combined with parabolic
+				interpolation.  The location is found to about half of full
+				precision, which is the most that can be expected since a
+				smooth function is flat near its minimum.  If the function
+				decreases toward an end of the interval, the result is near
+				that end.
+	
+	@param		inFunc		The function, which receives vectors of size 1.
+	@param		inLow		The lower end of the interval.
+	@param		inHigh		The upper end of the interval.
+	@result		The minimum, or nothing if the function could not be evaluated.
+*/
+std::optional<MinimumResult>	MinimizeOnInterval( const ObjectiveFunction& inFunc,
+												double inLow, double inHigh );
+
+/*!
+	@function	MinimizeFromPoint
+	
+	@abstract	Find a local minimum of a function of several variables, by the
+				Nelder-Mead simplex method.
+	
+	@discussion	The initial simplex consists of the starting point and points
+				displaced from it along each axis by the given steps.  When
+				the simplex has shrunk to about half of full precision, the
+				method is restarted once from the best point, which guards
+				against a simplex that has collapsed short of a minimum.  If
+				the number of evaluations reaches a limit proportional to the
+				number of variables, the best point so far is returned.
+	
+	@param		inFunc		The function.
+	@param		inStart		The starting point.
+	@param		inSteps		Sizes of the initial simplex along each axis, the
+							same size as inStart.
+	@result		The minimum, or nothing if the function could not be evaluated.
+*/
+std::optional<MinimumResult>	MinimizeFromPoint( const ObjectiveFunction& inFunc,
+												const std::vector<double>& inStart,
+												const std::vector<double>& inSteps );
+
+/*!
+	@function	DefaultSimplexSteps
+	@abstract	Sizes of an initial simplex suited to a starting point, 5% of
+				each nonzero coordinate, or 0.00025 for a zero coordinate.
+*/
+std::vector<double>	DefaultSimplexSteps( const std::vector<double>& inStart );
+
+/*!
+	@function	HaltonPoint
+	@abstract	A point of the Halton low-discrepancy sequence in a box, which
+				spreads starting points evenly over the box.
+	@param		inIndex		Index of the point in the sequence, starting at 1.
+	@param		inLow		Lower bounds of the box.
+	@param		inHigh		Upper bounds of the box.
+*/
+std::vector<double>	HaltonPoint( size_t inIndex,
+								const std::vector<double>& inLow,
+								const std::vector<double>& inHigh );
+
+#endif /* Minimizer_hpp */
@@ -0,0 +1,116 @@
+//  Moments.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "Moments.hpp"
+
+#import "Reductions.hpp"
+
+#import <algorithm>
+
+// Numbers per block in ComputeMoments.
+static constexpr size_t kBlockSize = 256;
+
+// Independent partial sums per block.  Floating point addition is not
+// associative, so the compiler may only use vector instructions for a sum
+// if the code already keeps separate sums for the lanes.
+static constexpr size_t kLanes = 4;
+static_assert( kLanes == 4, "the lane sums are combined for 4 lanes" );
+
+void	Moments::Add( double inValue )
+{
+	count += 1;
+	const double delta = inValue - mean;
+	mean += delta / static_cast<double>( count );
+	sumSquaredDeviations += delta * (inValue - mean);
+}
+
+// Chan, Golub, and LeVeque's formula for combining the moments of two
+// samples.
+void	Moments::Merge( const Moments& inOther )
+{
+	if (inOther.count == 0)
+	{
+		return;
+	}
+	if (count == 0)
+	{
+		*this = inOther;
+		return;
+	}
+	
+	const double n1 = static_cast<double>( count );
+	const double n2 = static_cast<double>( inOther.count );
+	const double n = n1 + n2;
+	const double delta = inOther.mean - mean;
+	
+	mean += delta * (n2 / n);
+	sumSquaredDeviations += inOther.sumSquaredDeviations +
+		delta * delta * (n1 * n2 / n);
+	count += inOther.count;
+}
+
+static double	LaneSumSquaredDeviations( const double* inValues,
+										size_t inCount, double inMean )
+{
+	double lanes[ kLanes ] = {};
+	size_t i = 0;
+	for (; i + kLanes <= inCount; i += kLanes)
+	{
+		for (size_t j = 0; j < kLanes; ++j)
+		{
+			const double deviation = inValues[ i + j ] - inMean;
+			lanes[j] += deviation * deviation;
+		}
+	}
+	for (; i < inCount; ++i)
+	{
+		const double deviation = inValues[i] - inMean;
+		lanes[0] += deviation * deviation;
+	}
+	return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+Moments	ComputeMoments( const double* inValues, size_t inCount )
+{
+	Moments result;
+	
+	for (size_t start = 0; start < inCount; start += kBlockSize)
+	{
+		// The block is read twice, but the second time it is in cache.
+		Moments block;
+		block.count = std::min( kBlockSize, inCount - start );
+		block.mean = ReduceSum( inValues + start, block.count ) /
+			static_cast<double>( block.count );
+		block.sumSquaredDeviations = LaneSumSquaredDeviations(
+			inValues + start, block.count, block.mean );
+		
+		result.Merge( block );
+	}
+	
+	return result;
+}
@@ -0,0 +1,94 @@
+//  Moments.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef Moments_hpp
+#define Moments_hpp
+
+#import <stddef.h>
+
+/*!
+	@struct		Moments
+	
+	@abstract	The count, mean, and sum of squared deviations from the mean
+				of some numbers.
+	
+	@discussion	Moments can be accumulated one number at a time, by Welford's
+				method, or computed for an array in one pass, and the moments
+				of two sets of numbers can be merged into the moments of their
+				union.  So the same kernel can serve numbers that arrive one at
+				a time, numbers processed in chunks on separate threads, and
+				ordinary argument lists.  Since deviations are always taken
+				from a mean, the variance does not suffer from the cancellation
+				of subtracting the square of the mean from the mean of the
+				squares.
+*/
+struct Moments
+{
+	size_t	count = 0;
+	double	mean = 0.0;
+	double	sumSquaredDeviations = 0.0;
+	
+	/*!
+		@function	Add
+		@abstract	Include one more number.
+	*/
+	void	Add( double inValue );
+	
+	/*!
+		@function	Merge
+		@abstract	Include the numbers described by other moments.
+	*/
+	void	Merge( const Moments& inOther );
+	
+	/*!
+		@function	Variance
+		@abstract	The population variance, or NaN if there are no numbers.
+	*/
+	double	Variance() const
+			{
+				return sumSquaredDeviations / static_cast<double>( count );
+			}
+};
+
+/*!
+	@function	ComputeMoments
+	
+	@abstract	Compute the moments of an array of numbers in one pass.
+	
+	@discussion	The array is processed in blocks small enough to stay in
+				cache.  The mean of a block and the squared deviations from
+				it are computed by simple loops that the compiler can
+				vectorize, and the blocks are merged as by Moments::Merge.
+	
+	@param		inValues	The numbers.
+	@param		inCount		The number of numbers.
+	@result		The moments of the numbers.
+*/
+Moments	ComputeMoments( const double* inValues, size_t inCount );
+
+#endif /* Moments_hpp */
@@ -0,0 +1,582 @@
+//  Quadrature.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "Quadrature.hpp"
+
+#import <algorithm>
+#import <float.h>
+#import <math.h>
+#import <utility>
+
+// Limit on the number of subintervals of Gauss-Kronrod quadrature, so that
+// an integral that does not converge does not take forever.
+static constexpr size_t kMaxIntervals = 1000;
+
+// Double exponential quadrature halves its step size from 1 down to 2^-kMaxLevel,
+// and does not test for convergence before reaching step 2^-kMinLevel.
+static constexpr int kMaxLevel = 8;
+static constexpr int kMinLevel = 2;
+
+// Double exponential nodes are looked for at multiples of this step out to
+// the point where they merge with the ends of the interval.
+static constexpr double kRangeStep = 0.125;
+
+// Tolerances smaller than this many rounding errors in the sum of the
+// absolute values can not be met reliably, so they are treated as this.
+static constexpr double kRoundingErrorFactor = 100.0;
+
+// Abscissae of the 15-point Kronrod rule on [-1, 1], the odd-numbered ones
+// being those of the 7-point Gauss rule, and the corresponding weights.
+static constexpr double kKronrodNodes[8] =
+{
+	0.991455371120812639206854697526329,
+	0.949107912342758524526189684047851,
+	0.864864423359769072789712788640926,
+	0.741531185599394439863864773280788,
+	0.586087235467691130294144845693013,
+	0.405845151377397166906606412076961,
+	0.207784955007898467600689403773245,
+	0.0
+};
+static constexpr double kKronrodWeights[8] =
+{
+	0.022935322010529224963732008058970,
+	0.063092092629978553290700663189204,
+	0.104790010322250183839876322541518,
+	0.140653259715525918745189590510238,
+	0.169004726639267902826583426598550,
+	0.190350578064785409913256402421014,
+	0.204432940075298892414161999234649,
+	0.209482141084727828012999174891714
+};
+static constexpr double kGaussWeights[4] =
+{
+	0.129484966168869693270611432679082,
+	0.279705391489276667901467771423780,
+	0.381830050505118944950369775488975,
+	0.417959183673469387755102040816327
+};
+static constexpr size_t kRulePoints = 15;
+
+namespace
+{
+	enum class QuadratureStatus
+	{
+		converged,
+		roughlyConverged,	// only to about the square root of the tolerance
+		notConverged,		// the other method may do better
+		notEvaluated		// the integrand failed, so give up
+	};
+	
+	struct Interval
+	{
+		double	start;
+		double	end;
+		double	value;
+		double	error;
+		double	absValue;	// integral of the absolute value
+	};
+	
+	struct DoubleExponentialNode
+	{
+		double	t;
+		double	x;
+		double	weight;
+	};
+}
+
+static double Target( double inTolerance, double inValue, double inAbsValue )
+{
+	return std::max( inTolerance * fabs( inValue ),
+		kRoundingErrorFactor * DBL_EPSILON * inAbsValue );
+}
+
+//MARK: Gauss-Kronrod
+
+static void AppendKronrodNodes( double inStart, double inEnd,
+								std::vector<double>& ioPoints )
+{
+	const double center = 0.5 * (inStart + inEnd);
+	const double halfWidth = 0.5 * (inEnd - inStart);
+	
+	for (size_t j = 0; j < 7; ++j)
+	{
+		ioPoints.push_back( center - halfWidth * kKronrodNodes[j] );
+		ioPoints.push_back( center + halfWidth * kKronrodNodes[j] );
+	}
+	ioPoints.push_back( center );
+}
+
+// Apply the rule to the values at the points made by AppendKronrodNodes,
+// estimating the error in the same way as QUADPACK.
+static Interval ApplyKronrodRule( double inStart, double inEnd,
+								const double* inValues )
+{
+	const double halfWidth = 0.5 * (inEnd - inStart);
+	const double centerValue = inValues[ 2 * 7 ];
+	double kronrod = kKronrodWeights[7] * centerValue;
+	double gauss = kGaussWeights[3] * centerValue;
+	double absSum = fabs( kronrod );
+	
+	for (size_t j = 0; j < 7; ++j)
+	{
+		const double pairSum = inValues[ 2 * j ] + inValues[ 2 * j + 1 ];
+		kronrod += kKronrodWeights[j] * pairSum;
+		absSum += kKronrodWeights[j] *
+			(fabs( inValues[ 2 * j ] ) + fabs( inValues[ 2 * j + 1 ] ));
+		if (j % 2 == 1)
+		{
+			gauss += kGaussWeights[ j / 2 ] * pairSum;
+		}
+	}
+	
+	// Integral of the deviation from the mean value
+	const double mean = 0.5 * kronrod;
+	double deviation = kKronrodWeights[7] * fabs( centerValue - mean );
+	for (size_t j = 0; j < 7; ++j)
+	{
+		deviation += kKronrodWeights[j] * (fabs( inValues[ 2 * j ] - mean ) +
+			fabs( inValues[ 2 * j + 1 ] - mean ));
+	}
+	deviation *= fabs( halfWidth );
+	
+	Interval result{ inStart, inEnd, kronrod * halfWidth,
+		fabs( (kronrod - gauss) * halfWidth ), absSum * fabs( halfWidth ) };
+	
+	if ( (deviation != 0.0) and (result.error != 0.0) )
+	{
+		result.error = deviation *
+			std::min( 1.0, pow( 200.0 * result.error / deviation, 1.5 ) );
+	}
+	if (result.absValue > DBL_MIN / (50.0 * DBL_EPSILON))
+	{
+		result.error = std::max( 50.0 * DBL_EPSILON * result.absValue,
+			result.error );
+	}
+	
+	return result;
+}
+
+// Integration over an infinite interval is turned into integration over
+// [0, 1] or [-1, 1] by a change of variable.
+static BatchIntegrand MapToFiniteInterval( const BatchIntegrand& inIntegrand,
+										double inStart, double inEnd,
+										double& outStart, double& outEnd )
+{
+	outStart = isinf( inStart )? (isinf( inEnd )? -1.0 : 0.0) : 0.0;
+	outEnd = 1.0;
+	
+	return [&inIntegrand, inStart, inEnd, points = std::vector<double>()]
+		( const std::vector<double>& inT, std::vector<double>& outValues ) mutable
+		{
+			points.resize( inT.size() );
+			for (size_t i = 0; i < inT.size(); ++i)
+			{
+				const double t = inT[i];
+				if (isinf( inStart ) and isinf( inEnd ))
+				{
+					points[i] = t / (1.0 - t * t);
+				}
+				else if (isinf( inEnd ))
+				{
+					points[i] = inStart + t / (1.0 - t);
+				}
+				else
+				{
+					points[i] = inEnd - t / (1.0 - t);
+				}
+			}
+			
+			if (not inIntegrand( points, outValues ))
+			{
+				return false;
+			}
+			
+			for (size_t i = 0; i < inT.size(); ++i)
+			{
+				const double t = inT[i];
+				const double jacobian = (isinf( inStart ) and isinf( inEnd ))?
+					(1.0 + t * t) / ((1.0 - t * t) * (1.0 - t * t)) :
+					1.0 / ((1.0 - t) * (1.0 - t));
+				outValues[i] *= jacobian;
+			}
+			return true;
+		};
+}
+
+static QuadratureStatus IntegrateGaussKronrod( const BatchIntegrand& inIntegrand,
+												double inStart, double inEnd,
+												double inTolerance,
+												QuadratureResult& ioResult )
+{
+	if (isinf( inStart ) or isinf( inEnd ))
+	{
+		double start, end;
+		BatchIntegrand mapped( MapToFiniteInterval( inIntegrand, inStart, inEnd,
+			start, end ) );
+		return IntegrateGaussKronrod( mapped, start, end, inTolerance, ioResult );
+	}
+	
+	std::vector< std::pair< double, double > > toEvaluate{ { inStart, inEnd } };
+	std::vector<Interval> intervals;
+	std::vector<double> points, values;
+	
+	for (;;)
+	{
+		points.clear();
+		for (const auto& [ start, end ] : toEvaluate)
+		{
+			AppendKronrodNodes( start, end, points );
+		}
+		values.resize( points.size() );
+		if (not inIntegrand( points, values ))
+		{
+			return QuadratureStatus::notEvaluated;
+		}
+		ioResult.evaluationCount += points.size();
+		if (not std::all_of( values.begin(), values.end(),
+			[]( double value ) { return isfinite( value ); } ))
+		{
+			return QuadratureStatus::notConverged;
+		}
+		for (size_t i = 0; i < toEvaluate.size(); ++i)
+		{
+			intervals.push_back( ApplyKronrodRule( toEvaluate[i].first,
+				toEvaluate[i].second, &values[ i * kRulePoints ] ) );
+		}
+		
+		double total = 0.0, totalError = 0.0, absTotal = 0.0;
+		for (const Interval& interval : intervals)
+		{
+			total += interval.value;
+			totalError += interval.error;
+			absTotal += interval.absValue;
+		}
+		const double target = Target( inTolerance, total, absTotal );
+		if (totalError <= target)
+		{
+			ioResult.value = total;
+			ioResult.errorEstimate = totalError;
+			return QuadratureStatus::converged;
+		}
+		
+		// Bisect the interval with the largest error, and any others whose
+		// errors exceed an equal share of the target, so that the next batch
+		// has plenty of points.
+		std::sort( intervals.begin(), intervals.end(),
+			[]( const Interval& a, const Interval& b ) { return a.error > b.error; } );
+		const double share = target / intervals.size();
+		toEvaluate.clear();
+		auto splitEnd = intervals.begin();
+		while ( (splitEnd != intervals.end()) and
+			((splitEnd == intervals.begin()) or (splitEnd->error > share)) and
+			(intervals.size() + toEvaluate.size() / 2 < kMaxIntervals) )
+		{
+			const double mid = 0.5 * (splitEnd->start + splitEnd->end);
+			if ( (mid <= splitEnd->start) or (mid >= splitEnd->end) )
+			{
+				break;
+			}
+			toEvaluate.emplace_back( splitEnd->start, mid );
+			toEvaluate.emplace_back( mid, splitEnd->end );
+			++splitEnd;
+		}
+		if (toEvaluate.empty())
+		{
+			return QuadratureStatus::notConverged;
+		}
+		intervals.erase( intervals.begin(), splitEnd );
+	}
+}
+
+//MARK: Double exponential
+
+// The substitution is x = tanh( π/2 sinh t ) on a finite interval,
+// x = exp( π/2 sinh t ) on a half-infinite one, and x = sinh( π/2 sinh t )
+// on the whole line, with suitable scaling and shifting.  Returns nothing if
+// the node can not be told apart from the end of the interval.
+static std::optional<DoubleExponentialNode> MakeNode( double t,
+													double inStart, double inEnd )
+{
+	const double u = M_PI_2 * sinh( t );
+	const double du = M_PI_2 * cosh( t );
+	DoubleExponentialNode node{ t, 0.0, 0.0 };
+	
+	if (isfinite( inStart ) and isfinite( inEnd ))
+	{
+		// Compute the distance to the nearer end directly, rather than by
+		// subtracting from 1, to keep accuracy near the ends.
+		const double radius = 0.5 * (inEnd - inStart);
+		const double e = exp( -2.0 * fabs( u ) );
+		const double gap = radius * 2.0 * e / (1.0 + e);
+		node.x = (t < 0.0)? inStart + gap : inEnd - gap;
+		node.weight = radius * du * 4.0 * e / ((1.0 + e) * (1.0 + e));
+		if ( not ((node.x > inStart) and (node.x < inEnd)) )
+		{
+			return std::nullopt;
+		}
+	}
+	else if (isfinite( inStart ))
+	{
+		const double g = exp( u );
+		node.x = inStart + g;
+		node.weight = du * g;
+		if (not (node.x > inStart))
+		{
+			return std::nullopt;
+		}
+	}
+	else if (isfinite( inEnd ))
+	{
+		const double g = exp( -u );
+		node.x = inEnd - g;
+		node.weight = du * g;
+		if (not (node.x < inEnd))
+		{
+			return std::nullopt;
+		}
+	}
+	else
+	{
+		node.x = sinh( u );
+		node.weight = du * cosh( u );
+	}
+	
+	if ( (not isfinite( node.x )) or (not isfinite( node.weight )) )
+	{
+		return std::nullopt;
+	}
+	
+	return node;
+}
+
+// Find how far the nodes extend in the direction of inDirection (±1).
+static double FindRangeEnd( double inDirection, double inStart, double inEnd )
+{
+	double rangeEnd = 0.0;
+	
+	while (MakeNode( inDirection * (rangeEnd + kRangeStep), inStart, inEnd ))
+	{
+		rangeEnd += kRangeStep;
+	}
+	
+	return rangeEnd;
+}
+
+static QuadratureStatus IntegrateDoubleExponential( const BatchIntegrand& inIntegrand,
+												double inStart, double inEnd,
+												double inTolerance,
+												QuadratureResult& ioResult )
+{
+	const double leftEnd = -FindRangeEnd( -1.0, inStart, inEnd );
+	const double rightEnd = FindRangeEnd( 1.0, inStart, inEnd );
+	
+	std::vector<DoubleExponentialNode> nodes;
+	std::vector<double> points, values;
+	double sum = 0.0, absSum = 0.0, estimate = 0.0;
+	double recentErrors[2] = { INFINITY, INFINITY };
+	
+	// The terms at the outermost nodes so far, which indicate the error made
+	// by truncating the range of t.
+	DoubleExponentialNode leftmost{ 0.0, 0.0, 0.0 }, rightmost{ 0.0, 0.0, 0.0 };
+	double leftTerm = 0.0, rightTerm = 0.0;
+	
+	for (int level = 0; level <= kMaxLevel; ++level)
+	{
+		const double step = ldexp( 1.0, -level );
+		
+		// At each level after the first, the new nodes are halfway between
+		// the old ones.
+		nodes.clear();
+		const long firstIndex = static_cast<long>( ceil( leftEnd / step ) );
+		const long lastIndex = static_cast<long>( floor( rightEnd / step ) );
+		for (long j = firstIndex; j <= lastIndex; ++j)
+		{
+			if ( (level == 0) or (j % 2 != 0) )
+			{
+				std::optional<DoubleExponentialNode> node( MakeNode( j * step,
+					inStart, inEnd ) );
+				if (node.has_value())
+				{
+					nodes.push_back( *node );
+				}
+			}
+		}
+		
+		points.clear();
+		for (const DoubleExponentialNode& node : nodes)
+		{
+			points.push_back( node.x );
+		}
+		values.resize( points.size() );
+		if (not inIntegrand( points, values ))
+		{
+			return QuadratureStatus::notEvaluated;
+		}
+		ioResult.evaluationCount += points.size();
+		
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			const double term = nodes[i].weight * values[i];
+			if (not isfinite( term ))
+			{
+				return QuadratureStatus::notConverged;
+			}
+			sum += term;
+			absSum += fabs( term );
+			if (nodes[i].t <= leftmost.t)
+			{
+				leftmost = nodes[i];
+				leftTerm = term;
+			}
+			if (nodes[i].t >= rightmost.t)
+			{
+				rightmost = nodes[i];
+				rightTerm = term;
+			}
+		}
+		
+		const double previousEstimate = estimate;
+		estimate = step * sum;
+		if (level < kMinLevel)
+		{
+			continue;
+		}
+		
+		const double error = fabs( estimate - previousEstimate );
+		const double target = Target( inTolerance, estimate, step * absSum );
+		
+		// The range of t may be cut short by how closely floating point
+		// numbers can approach a finite end of the interval.  For an
+		// integrable function, the terms beyond the cut decay at least about
+		// as fast as exp( -π/2 sinh |t| ), which bounds the rest of the sum.
+		const double truncationError =
+			fabs( leftTerm ) / (M_PI_2 * cosh( leftmost.t )) +
+			fabs( rightTerm ) / (M_PI_2 * cosh( rightmost.t ));
+		const double roughTarget = std::max( target,
+			sqrt( inTolerance ) * fabs( estimate ) );
+		if (truncationError > roughTarget)
+		{
+			return QuadratureStatus::notConverged;
+		}
+		
+		ioResult.value = estimate;
+		if (error + truncationError <= target)
+		{
+			ioResult.errorEstimate = error + truncationError;
+			return QuadratureStatus::converged;
+		}
+		
+		// Rounding errors in the integrand near a singularity can keep the
+		// estimates from settling down beyond a certain accuracy.
+		ioResult.errorEstimate = std::max( { error, recentErrors[0],
+			recentErrors[1] } ) + truncationError;
+		recentErrors[1] = recentErrors[0];
+		recentErrors[0] = error;
+	}
+	
+	return (ioResult.errorEstimate <= sqrt( inTolerance ) * fabs( ioResult.value ))?
+		QuadratureStatus::roughlyConverged : QuadratureStatus::notConverged;
+}
+
+//MARK: -
+
+std::optional<QuadratureResult>	Integrate( const BatchIntegrand& inIntegrand,
+											double inStart, double inEnd,
+											double inTolerance )
+{
+	if ( isnan( inStart ) or isnan( inEnd ) or (not (inTolerance > 0.0)) )
+	{
+		return std::nullopt;
+	}
+	if (inStart == inEnd)
+	{
+		return QuadratureResult();
+	}
+	if (inStart > inEnd)
+	{
+		std::optional<QuadratureResult> result( Integrate( inIntegrand,
+			inEnd, inStart, inTolerance ) );
+		if (result.has_value())
+		{
+			result->value = -result->value;
+		}
+		return result;
+	}
+	
+	QuadratureResult result;
+	
+	// Look for trouble at the ends of the interval.
+	bool isEndSingular = isinf( inStart ) or isinf( inEnd );
+	if (not isEndSingular)
+	{
+		std::vector<double> ends{ inStart, inEnd }, endValues( 2 );
+		isEndSingular = (not inIntegrand( ends, endValues )) or
+			(not isfinite( endValues[0] )) or (not isfinite( endValues[1] ));
+		result.evaluationCount += 2;
+	}
+	
+	using Method = QuadratureStatus (*)( const BatchIntegrand&, double, double,
+		double, QuadratureResult& );
+	Method methods[2] = { IntegrateGaussKronrod, IntegrateDoubleExponential };
+	if (isEndSingular)
+	{
+		std::swap( methods[0], methods[1] );
+	}
+	
+	QuadratureStatus status = methods[0]( inIntegrand, inStart, inEnd,
+		inTolerance, result );
+	if ( (status == QuadratureStatus::notConverged) or
+		(status == QuadratureStatus::roughlyConverged) )
+	{
+		// If the other method does not do better, a rough result is better
+		// than none.
+		QuadratureResult otherResult;
+		otherResult.evaluationCount = result.evaluationCount;
+		QuadratureStatus otherStatus = methods[1]( inIntegrand, inStart, inEnd,
+			inTolerance, otherResult );
+		if ( (otherStatus == QuadratureStatus::notEvaluated) or
+			(otherStatus == QuadratureStatus::converged) or
+			(status == QuadratureStatus::notConverged) )
+		{
+			status = otherStatus;
+			result.value = otherResult.value;
+			result.errorEstimate = otherResult.errorEstimate;
+		}
+		result.evaluationCount = otherResult.evaluationCount;
+	}
+	
+	if ( (status != QuadratureStatus::converged) and
+		(status != QuadratureStatus::roughlyConverged) )
+	{
+		return std::nullopt;
+	}
+	
+	return result;
+}
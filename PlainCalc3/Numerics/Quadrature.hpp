@@ -0,0 +1,92 @@
+//  Quadrature.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef Quadrature_hpp
+#define Quadrature_hpp
+
+#import <stddef.h>
+#import <functional>
+#import <optional>
+#import <vector>
+
+/*!
+	@typedef	BatchIntegrand
+	@abstract	A function to be integrated, evaluated at several points at
+				once.
+	@discussion	The function receives the points and a vector of the same
+				size to fill with the function values.  It returns false if
+				the function could not be evaluated at some point, which ends
+				the integration.
+*/
+using BatchIntegrand = std::function< bool( const std::vector<double>& inPoints,
+											std::vector<double>& outValues ) >;
+
+/*!
+	@struct		QuadratureResult
+	@abstract	An approximate integral, with an estimate of its error and the
+				number of times the integrand was evaluated.
+*/
+struct QuadratureResult
+{
+	double	value = 0.0;
+	double	errorEstimate = 0.0;
+	size_t	evaluationCount = 0;
+};
+
+/*!
+	@function	Integrate
+	
+	@abstract	Approximate the integral of a function over an interval.
+	
+	@discussion	Two methods are available.  Adaptive Gauss-Kronrod quadrature
+				repeatedly bisects the subintervals with the largest errors,
+				and evaluates all the new points of a round in one batch.
+				Double exponential (tanh-sinh) quadrature crowds its points
+				towards the ends of the interval, and so copes with
+				singularities there, and with infinite intervals.
+				
+				The double exponential method is tried first if an end of the
+				interval is infinite, or if the integrand is not finite there.
+				Otherwise Gauss-Kronrod is tried first.  If the first method
+				fails to reach the tolerance, the other one is tried.
+	
+	@param		inIntegrand		The function being integrated.
+	@param		inStart			Lower limit of integration, possibly -∞.
+	@param		inEnd			Upper limit of integration, possibly ∞.  If it
+								is less than inStart, the result is negated.
+	@param		inTolerance		Requested accuracy, relative to the size of
+								the integral.
+	@result		The integral, or nothing if the integrand could not be
+				evaluated or the integral could not be found to the tolerance.
+*/
+std::optional<QuadratureResult>	Integrate( const BatchIntegrand& inIntegrand,
+											double inStart, double inEnd,
+											double inTolerance );
+
+#endif /* Quadrature_hpp */
@@ -0,0 +1,127 @@
+//  Reductions.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "Reductions.hpp"
+
+#import <math.h>
+
+// Number of independent accumulators: two AVX registers, or four NEON or
+// SSE registers.
+static constexpr size_t kLanes = 8;
+
+// Apply inStep( accumulator, value ) to each value, cycling through the
+// accumulators.  The inner loop has a fixed length, so that it can be
+// unrolled and turned into vector operations.
+template <typename Step>
+static inline void	AccumulateLanes( const double* inValues, size_t inCount,
+									double (&ioLanes)[ kLanes ], Step inStep )
+{
+	size_t i = 0;
+	for (; i + kLanes <= inCount; i += kLanes)
+	{
+		for (size_t j = 0; j < kLanes; ++j)
+		{
+			ioLanes[j] = inStep( ioLanes[j], inValues[ i + j ] );
+		}
+	}
+	for (size_t j = 0; i < inCount; ++i, ++j)
+	{
+		ioLanes[j] = inStep( ioLanes[j], inValues[i] );
+	}
+}
+
+// Combine the accumulators pairwise.
+template <typename Combine>
+static inline double	CombineLanes( double (&ioLanes)[ kLanes ],
+										Combine inCombine )
+{
+	for (size_t width = kLanes / 2; width > 0; width /= 2)
+	{
+		for (size_t j = 0; j < width; ++j)
+		{
+			ioLanes[j] = inCombine( ioLanes[j], ioLanes[ j + width ] );
+		}
+	}
+	return ioLanes[0];
+}
+
+static inline double	Add( double a, double b )
+{
+	return a + b;
+}
+
+// Unlike fmin and fmax, these can be vectorized.  They agree with fmin and
+// fmax as long as the accumulator a is not NaN, which it never is since it
+// starts at an infinity and only takes the value of b when a comparison
+// with b succeeds.
+static inline double	Smaller( double a, double b )
+{
+	return (b < a)? b : a;
+}
+
+static inline double	Larger( double a, double b )
+{
+	return (b > a)? b : a;
+}
+
+double	ReduceSum( const double* inValues, size_t inCount )
+{
+	double lanes[ kLanes ] = {};
+	AccumulateLanes( inValues, inCount, lanes, Add );
+	return CombineLanes( lanes, Add );
+}
+
+double	ReduceReciprocalSum( const double* inValues, size_t inCount )
+{
+	double lanes[ kLanes ] = {};
+	AccumulateLanes( inValues, inCount, lanes,
+		[]( double sum, double x ) { return sum + 1.0 / x; } );
+	return CombineLanes( lanes, Add );
+}
+
+double	ReduceMin( const double* inValues, size_t inCount )
+{
+	double lanes[ kLanes ];
+	for (double& lane : lanes)
+	{
+		lane = INFINITY;
+	}
+	AccumulateLanes( inValues, inCount, lanes, Smaller );
+	return CombineLanes( lanes, Smaller );
+}
+
+double	ReduceMax( const double* inValues, size_t inCount )
+{
+	double lanes[ kLanes ];
+	for (double& lane : lanes)
+	{
+		lane = - INFINITY;
+	}
+	AccumulateLanes( inValues, inCount, lanes, Larger );
+	return CombineLanes( lanes, Larger );
+}
@@ -0,0 +1,70 @@
+//  Reductions.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef Reductions_hpp
+#define Reductions_hpp
+
+#import <stddef.h>
+
+/*
+	Reductions of arrays of numbers, used by the n-ary built-in functions.
+	
+	Each keeps several independent accumulators, so that the compiler may
+	use vector instructions (SSE or AVX on Intel, NEON on ARM) without
+	needing permission to reassociate floating point operations, and so that
+	consecutive operations do not wait for each other.  The results of sums
+	can therefore differ in the last bits from those of a simple loop.
+*/
+
+/*!
+	@function	ReduceSum
+	@abstract	The sum of some numbers, or 0 if there are none.
+*/
+double	ReduceSum( const double* inValues, size_t inCount );
+
+/*!
+	@function	ReduceReciprocalSum
+	@abstract	The sum of the reciprocals of some numbers.
+*/
+double	ReduceReciprocalSum( const double* inValues, size_t inCount );
+
+/*!
+	@function	ReduceMin
+	@abstract	The smallest of some numbers, ignoring NaNs as fmin does, or
+				infinity if there are none.
+*/
+double	ReduceMin( const double* inValues, size_t inCount );
+
+/*!
+	@function	ReduceMax
+	@abstract	The largest of some numbers, ignoring NaNs as fmax does, or
+				-infinity if there are none.
+*/
+double	ReduceMax( const double* inValues, size_t inCount );
+
+#endif /* Reductions_hpp */
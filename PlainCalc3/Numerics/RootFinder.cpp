@@ -0,0 +1,298 @@
+//  RootFinder.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "RootFinder.hpp"
+
+#import <algorithm>
+#import <float.h>
+#import <math.h>
+#import <utility>
+#import <vector>
+
+// When the function has the same sign at both ends of the interval, the
+// interval is divided into up to this many equal parts looking for a change
+// of sign.
+static constexpr size_t kMaxBracketPieces = 64;
+
+// Limit on the number of steps narrowing the bracket.  Brent's method is
+// guaranteed to converge in somewhat more steps than bisection, which needs
+// fewer than 2100 steps to narrow any bracket of doubles to one rounding
+// error, so this is only reached when evaluation goes badly wrong.
+static constexpr size_t kMaxSteps = 5000;
+
+namespace
+{
+	struct Point
+	{
+		double	x;
+		Dual	f;
+	};
+	
+	/*
+		Counts evaluations of the function, and treats a NaN value as
+		a failure.
+	*/
+	class CountedFunction
+	{
+	public:
+		explicit		CountedFunction( const RootFunction& inFunc )
+							: _func( inFunc ) {}
+		
+		std::optional<Point>	operator()( double inX )
+								{
+									++_count;
+									std::optional<Dual> result( _func( inX ) );
+									if (result.has_value() and isnan( result->value ))
+									{
+										result.reset();
+									}
+									return result.has_value()?
+										std::optional<Point>( Point{ inX, *result } ) :
+										std::nullopt;
+								}
+		
+		size_t			Count() const { return _count; }
+	
+	private:
+		const RootFunction&	_func;
+		size_t				_count = 0;
+	};
+}
+
+static bool SignsDiffer( double inA, double inB )
+{
+	return signbit( inA ) != signbit( inB );
+}
+
+/*
+	Find adjacent points, among equally spaced points of the interval, where
+	the function has a change of sign.  On success, either the function
+	value at ioLow is exactly zero, or the function has opposite signs at
+	ioLow and ioHigh.
+*/
+static bool Bracket( CountedFunction& ioFunc, Point& ioLow, Point& ioHigh )
+{
+	std::vector<Point> samples{ ioLow, ioHigh };
+	const double width = ioHigh.x - ioLow.x;
+	
+	for (size_t pieces = 2; pieces <= kMaxBracketPieces; pieces *= 2)
+	{
+		std::vector<Point> refined;
+		refined.reserve( pieces + 1 );
+		refined.push_back( samples.front() );
+		for (size_t i = 1; i < samples.size(); ++i)
+		{
+			const double mid = ioLow.x + width * (2 * i - 1) / pieces;
+			std::optional<Point> midPt( ioFunc( mid ) );
+			if (not midPt.has_value())
+			{
+				return false;
+			}
+			if (midPt->f.value == 0.0)
+			{
+				ioLow = *midPt;
+				return true;
+			}
+			refined.push_back( *midPt );
+			refined.push_back( samples[i] );
+		}
+		samples.swap( refined );
+		
+		for (size_t i = 1; i < samples.size(); ++i)
+		{
+			if (SignsDiffer( samples[i-1].f.value, samples[i].f.value ))
+			{
+				ioLow = samples[i-1];
+				ioHigh = samples[i];
+				return true;
+			}
+		}
+	}
+	
+	return false;
+}
+
+/*
+	Brent's method, as in his book "Algorithms for Minimization Without
+	Derivatives", with a Newton step preferred to interpolation when the
+	derivative at the best point so far is known.  The point b is the best
+	estimate, c is on the other side of the zero, and a is the previous
+	value of b.
+*/
+static std::optional<Point> Narrow( CountedFunction& ioFunc,
+									Point inLow, Point inHigh,
+									double inTolerance )
+{
+	Point a( inLow );
+	Point b( inHigh );
+	Point c( a );
+	double d = b.x - a.x;
+	double e = d;
+	
+	for (size_t step = 0; step < kMaxSteps; ++step)
+	{
+		if (not SignsDiffer( b.f.value, c.f.value ))
+		{
+			c = a;
+			d = e = b.x - a.x;
+		}
+		if (fabs( c.f.value ) < fabs( b.f.value ))
+		{
+			a = b;
+			b = c;
+			c = a;
+		}
+		
+		const double tol = 2.0 * DBL_EPSILON * fabs( b.x ) + 0.5 * inTolerance;
+		const double m = 0.5 * (c.x - b.x);
+		if ( (fabs( m ) <= tol) or (b.f.value == 0.0) )
+		{
+			return b;
+		}
+		
+		bool stepChosen = false;
+		if ( isfinite( b.f.derivative ) and (b.f.derivative != 0.0) )
+		{
+			// The Newton step must head into the bracket, stay within it,
+			// and shrink at least as fast as Brent requires of interpolation.
+			const double newton = - b.f.value / b.f.derivative;
+			if ( (newton * m > 0.0) and (fabs( newton ) < 2.0 * fabs( m )) and
+				(fabs( newton ) < 0.5 * fabs( e )) )
+			{
+				e = d;
+				d = newton;
+				stepChosen = true;
+			}
+		}
+		if ( (not stepChosen) and (fabs( e ) >= tol) and
+			(fabs( a.f.value ) > fabs( b.f.value )) )
+		{
+			double p, q;
+			const double s = b.f.value / a.f.value;
+			if (a.x == c.x)
+			{
+				// Secant method
+				p = 2.0 * m * s;
+				q = 1.0 - s;
+			}
+			else
+			{
+				// Inverse quadratic interpolation
+				const double qa = a.f.value / c.f.value;
+				const double r = b.f.value / c.f.value;
+				p = s * (2.0 * m * qa * (qa - r) - (b.x - a.x) * (r - 1.0));
+				q = (qa - 1.0) * (r - 1.0) * (s - 1.0);
+			}
+			if (p > 0.0)
+			{
+				q = -q;
+			}
+			else
+			{
+				p = -p;
+			}
+			if (2.0 * p < std::min( 3.0 * m * q - fabs( tol * q ), fabs( e * q ) ))
+			{
+				e = d;
+				d = p / q;
+				stepChosen = true;
+			}
+		}
+		if (not stepChosen)
+		{
+			d = e = m;
+		}
+		
+		a = b;
+		const double next = b.x + ((fabs( d ) > tol)? d : copysign( tol, m ));
+		std::optional<Point> nextPt( ioFunc( next ) );
+		if (not nextPt.has_value())
+		{
+			return std::nullopt;
+		}
+		b = *nextPt;
+	}
+	
+	return std::nullopt;
+}
+
+std::optional<RootResult>	FindRoot( const RootFunction& inFunc,
+									double inLow, double inHigh,
+									double inTolerance )
+{
+	std::optional<RootResult> result;
+	if ( (not isfinite( inLow )) or (not isfinite( inHigh )) )
+	{
+		return result;
+	}
+	CountedFunction func( inFunc );
+	std::optional<Point> lowPt( func( std::min( inLow, inHigh ) ) );
+	std::optional<Point> highPt( func( std::max( inLow, inHigh ) ) );
+	if ( (not lowPt.has_value()) or (not highPt.has_value()) )
+	{
+		return result;
+	}
+	
+	std::optional<double> root;
+	if (lowPt->f.value == 0.0)
+	{
+		root = lowPt->x;
+	}
+	else if (highPt->f.value == 0.0)
+	{
+		root = highPt->x;
+	}
+	else if ( SignsDiffer( lowPt->f.value, highPt->f.value ) or
+		Bracket( func, *lowPt, *highPt ) )
+	{
+		if (lowPt->f.value == 0.0)
+		{
+			root = lowPt->x;
+		}
+		else
+		{
+			// Near a true zero, the function is smaller than at the ends of
+			// the bracket.  Near a pole, it is much larger.
+			const double limit = std::max( fabs( lowPt->f.value ),
+				fabs( highPt->f.value ) );
+			std::optional<Point> rootPt( Narrow( func, *lowPt, *highPt,
+				fabs( inTolerance ) ) );
+			if ( rootPt.has_value() and (fabs( rootPt->f.value ) <= limit) )
+			{
+				root = rootPt->x;
+			}
+		}
+	}
+	
+	if (root.has_value())
+	{
+		result = RootResult{ *root, func.Count() };
+	}
+	return result;
+}
@@ -0,0 +1,87 @@
+//  RootFinder.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef RootFinder_hpp
+#define RootFinder_hpp
+
+#import "Dual.hpp"
+
+#import <stddef.h>
+#import <functional>
+#import <optional>
+
+/*!
+	@typedef	RootFunction
+	@abstract	A function whose zero is sought.
+	@discussion	The function returns its value together with its derivative,
+				or a NaN derivative if the derivative is not available.  It
+				returns nothing if it cannot be evaluated, which ends the
+				search.
+*/
+using RootFunction = std::function< std::optional<Dual>( double ) >;
+
+/*!
+	@struct		RootResult
+	@abstract	A zero of a function, with the number of times the function
+				was evaluated to find it.
+*/
+struct RootResult
+{
+	double	root = 0.0;
+	size_t	evaluationCount = 0;
+};
+
+/*!
+	@function	FindRoot
+	
+	@abstract	Find a zero of a function within an interval.
+	
+	@discussion	If the function has the same sign at both ends of the
+				interval, the interval is divided into equal parts, up to a
+				limit, until a change of sign is found.  The bracket is then
+				narrowed by Brent's method, which combines inverse quadratic
+				interpolation, the secant method, and bisection.  Where the
+				derivative is available, a Newton step is taken instead if it
+				stays within the bracket and makes good progress.
+				
+				A change of sign at a discontinuity, such as a pole, is not
+				reported as a zero.
+	
+	@param		inFunc			The function.
+	@param		inLow			One end of the interval.
+	@param		inHigh			The other end of the interval.
+	@param		inTolerance		Acceptable absolute error of the zero, in
+								addition to a few rounding errors.
+	@result		The zero, or nothing if no zero was found.
+*/
+std::optional<RootResult>	FindRoot( const RootFunction& inFunc,
+									double inLow, double inHigh,
+									double inTolerance );
+
+#endif /* RootFinder_hpp */
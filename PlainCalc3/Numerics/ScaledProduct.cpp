@@ -0,0 +1,181 @@
+//  ScaledProduct.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "ScaledProduct.hpp"
+
+#import <algorithm>
+#import <bit>
+#import <limits.h>
+#import <math.h>
+
+// Numbers per block.  Each mantissa taken from a normal number is in
+// [1, 2), so the product of a block's worth in one lane is less than
+// 2^(kBlockSize / kLanes), far from overflow.
+static constexpr size_t kBlockSize = 256;
+
+// Independent products per block.
+static constexpr size_t kLanes = 4;
+
+static constexpr uint64_t kExponentMask =	0x7FF0000000000000ULL;
+static constexpr uint64_t kExponentOfOne =	0x3FF0000000000000ULL;
+static constexpr int kExponentShift = 52;
+static constexpr int64_t kExponentBias = 1023;
+static constexpr uint64_t kMaxExponentField = 0x7FF;
+
+// Bring the mantissa back into [0.5, 1), moving its scale into the exponent.
+static void	Renormalize( ScaledProduct& ioProduct )
+{
+	if (isfinite( ioProduct.mantissa ) and (ioProduct.mantissa != 0.0))
+	{
+		int shift;
+		ioProduct.mantissa = frexp( ioProduct.mantissa, &shift );
+		ioProduct.exponent += shift;
+	}
+}
+
+// Multiply by a block of numbers, none of which is zero, subnormal,
+// infinite, or NaN.
+static void	MultiplyNormalBlock( ScaledProduct& ioProduct,
+									const double* inValues, size_t inCount )
+{
+	double mantissas[ kLanes ] = { 1.0, 1.0, 1.0, 1.0 };
+	int64_t exponents[ kLanes ] = {};
+	
+	size_t i = 0;
+	for (; i + kLanes <= inCount; i += kLanes)
+	{
+		for (size_t j = 0; j < kLanes; ++j)
+		{
+			const uint64_t bits = std::bit_cast<uint64_t>( inValues[ i + j ] );
+			// Keep the sign and fraction, with the exponent of 1.
+			mantissas[j] *= std::bit_cast<double>(
+				(bits & ~kExponentMask) | kExponentOfOne );
+			exponents[j] += static_cast<int64_t>(
+				(bits & kExponentMask) >> kExponentShift ) - kExponentBias;
+		}
+	}
+	for (; i < inCount; ++i)
+	{
+		const uint64_t bits = std::bit_cast<uint64_t>( inValues[i] );
+		mantissas[0] *= std::bit_cast<double>(
+			(bits & ~kExponentMask) | kExponentOfOne );
+		exponents[0] += static_cast<int64_t>(
+			(bits & kExponentMask) >> kExponentShift ) - kExponentBias;
+	}
+	
+	for (size_t j = 0; j < kLanes; ++j)
+	{
+		ioProduct.mantissa *= mantissas[j];
+		ioProduct.exponent += exponents[j];
+		Renormalize( ioProduct );
+	}
+}
+
+static void	MultiplySpecialBlock( ScaledProduct& ioProduct,
+									const double* inValues, size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		int shift = 0;
+		ioProduct.mantissa *= frexp( inValues[i], &shift );
+		if (isfinite( inValues[i] ))
+		{
+			ioProduct.exponent += shift;
+		}
+		Renormalize( ioProduct );
+	}
+}
+
+double	ScaledProduct::Value() const
+{
+	const int64_t clampedExponent = std::clamp<int64_t>( exponent, INT_MIN,
+		INT_MAX );
+	
+	return ldexp( mantissa, static_cast<int>( clampedExponent ) );
+}
+
+// With exponent = q n + r, where 0 <= r < n, the root is
+// 2^q 2^(r/n) mantissa^(1/n), and each factor is accurate.
+double	ScaledProduct::Root( size_t n ) const
+{
+	if ( isnan( mantissa ) or (mantissa < 0.0) )
+	{
+		return NAN;
+	}
+	if ( (mantissa == 0.0) or isinf( mantissa ) )
+	{
+		return mantissa;
+	}
+	
+	const int64_t count = static_cast<int64_t>( n );
+	int64_t quotient = exponent / count;
+	int64_t remainder = exponent % count;
+	if (remainder < 0)
+	{
+		remainder += count;
+		quotient -= 1;
+	}
+	
+	const double fraction = pow( mantissa, 1.0 / n ) *
+		exp2( static_cast<double>( remainder ) / n );
+	
+	return ldexp( fraction, static_cast<int>( std::clamp<int64_t>( quotient,
+		INT_MIN, INT_MAX ) ) );
+}
+
+ScaledProduct	ComputeScaledProduct( const double* inValues, size_t inCount )
+{
+	ScaledProduct result;
+	
+	for (size_t start = 0; start < inCount; start += kBlockSize)
+	{
+		const size_t blockCount = std::min( kBlockSize, inCount - start );
+		const double* block = inValues + start;
+		
+		// Check the exponent fields without branching, so that this loop can
+		// also be vectorized.
+		bool hasSpecial = false;
+		for (size_t i = 0; i < blockCount; ++i)
+		{
+			const uint64_t field = (std::bit_cast<uint64_t>( block[i] ) &
+				kExponentMask) >> kExponentShift;
+			hasSpecial |= (field == 0) | (field == kMaxExponentField);
+		}
+		
+		if (hasSpecial)
+		{
+			MultiplySpecialBlock( result, block, blockCount );
+		}
+		else
+		{
+			MultiplyNormalBlock( result, block, blockCount );
+		}
+	}
+	
+	return result;
+}
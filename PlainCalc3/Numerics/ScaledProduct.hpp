@@ -0,0 +1,85 @@
+//  ScaledProduct.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef ScaledProduct_hpp
+#define ScaledProduct_hpp
+
+#import <stddef.h>
+#import <stdint.h>
+
+/*!
+	@struct		ScaledProduct
+	
+	@abstract	A product of numbers, represented as mantissa * 2^exponent so
+				that intermediate results can neither overflow nor underflow.
+	
+	@discussion	Unless the product is zero, infinite, or NaN, the magnitude of
+				the mantissa is in [0.5, 1).
+*/
+struct ScaledProduct
+{
+	double		mantissa = 0.5;		// an empty product is 0.5 * 2^1
+	int64_t		exponent = 1;
+	
+	/*!
+		@function	Value
+		@abstract	The product as a double, which is infinite or zero only if
+					the true product is out of range.
+	*/
+	double		Value() const;
+	
+	/*!
+		@function	Root
+		@abstract	The positive nth root of the product, or NaN if the
+					product is negative.
+	*/
+	double		Root( size_t n ) const;
+};
+
+/*!
+	@function	ComputeScaledProduct
+	
+	@abstract	Multiply an array of numbers without intermediate overflow or
+				underflow.
+	
+	@discussion	Each number is split into a mantissa and an exponent.  The
+				mantissas are multiplied and the exponents added in four
+				independent lanes, in blocks short enough that the mantissa
+				products stay in range, and each block is renormalized
+				afterwards.  For normal numbers the split is done by bit
+				manipulation, so the loop over a block can use vector
+				instructions; a block that contains zero, subnormal, infinite,
+				or NaN values is handled one number at a time.
+	
+	@param		inValues	The numbers.
+	@param		inCount		The number of numbers.
+	@result		The product.
+*/
+ScaledProduct	ComputeScaledProduct( const double* inValues, size_t inCount );
+
+#endif /* ScaledProduct_hpp */
@@ -0,0 +1,298 @@
+//  SeriesAccelerator.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "SeriesAccelerator.hpp"
+
+#import <algorithm>
+#import <math.h>
+
+// Longest counter-diagonal of the epsilon table that we keep.  Beyond this,
+// rounding errors tend to dominate.
+static constexpr size_t kMaxEpsilonColumns = 30;
+
+// Number of partial sums used by the Euler transformation.
+static constexpr size_t kEulerWindow = 24;
+
+// Series whose terms do not alternate in sign are checked for convergence
+// when the number of terms is this times a power of 2.
+static constexpr size_t kFirstCheckpoint = 8;
+
+// Agreements of successive estimates needed to accept a result.  Estimates
+// at checkpoints are far apart in terms of the number of partial sums, but
+// a single agreement can still be a coincidence.
+static constexpr int kAgreementsNeeded = 2;
+static constexpr int kCheckpointAgreementsNeeded = 2;
+
+// An alternating series is only taken to converge if the size of its terms
+// at n is at most this times the size at a power of 2 between n/4 and n/2.
+static constexpr double kMaxTermRatio = 0.75;
+
+// Partial sums that have not changed at all, as when the first terms of a
+// series are zero, say nothing about the limit.  Only after this many of
+// them do we take the sequence to be constant.
+static constexpr size_t kMinConstantCount = 1 << 12;
+
+SeriesAccelerator::SeriesAccelerator( double inTolerance )
+	: _tolerance( inTolerance )
+	, _count( 0 )
+	, _estimate( 0.0 )
+	, _errorEstimate( INFINITY )
+	, _isAlternating( true )
+	, _hasChanged( false )
+	, _powerTermSize( NAN )
+	, _previousPowerTermSize( NAN )
+	, _wynnEstimate( NAN )
+	, _wynnAgreements( 0 )
+	, _eulerEstimate( NAN )
+	, _eulerAgreements( 0 )
+	, _candidate( NAN )
+	, _confirmCount( 0 )
+	, _nextCheckpoint( kFirstCheckpoint )
+	, _wynnAtCheckpoint( NAN )
+	, _richardsonEstimate( NAN )
+	, _richardsonAgreements( 0 )
+{
+}
+
+// Record a new estimate from one of the methods, and report whether that
+// method has settled down.
+bool	SeriesAccelerator::Accept( double inNewEstimate, double& ioLastEstimate,
+									int& ioAgreements, int inAgreementsNeeded )
+{
+	bool isDone = false;
+	
+	if (isfinite( inNewEstimate ))
+	{
+		const double change = fabs( inNewEstimate - ioLastEstimate );
+		const double allowed = _tolerance * std::max( 1.0, fabs( inNewEstimate ) );
+		
+		if (change <= allowed)
+		{
+			ioAgreements += 1;
+		}
+		else
+		{
+			ioAgreements = 0;
+		}
+		
+		if ( (ioAgreements >= inAgreementsNeeded) or (change < _errorEstimate) )
+		{
+			_estimate = inNewEstimate;
+			_errorEstimate = isfinite( change )? change : _errorEstimate;
+		}
+		isDone = (ioAgreements >= inAgreementsNeeded);
+	}
+	ioLastEstimate = inNewEstimate;
+	
+	return isDone;
+}
+
+void	SeriesAccelerator::UpdateWynn( double inPartial )
+{
+	// The rhombus rule, with the previous counter-diagonal in _epsilon.
+	std::vector<double> next;
+	next.reserve( std::min( _epsilon.size() + 1, kMaxEpsilonColumns ) );
+	next.push_back( inPartial );
+	
+	for (size_t k = 0; (k < _epsilon.size()) and (next.size() < kMaxEpsilonColumns); ++k)
+	{
+		const double diff = next[k] - _epsilon[k];
+		if (diff == 0.0)
+		{
+			// The sequence has stopped changing at this level.
+			break;
+		}
+		const double before = (k == 0)? 0.0 : _epsilon[k - 1];
+		next.push_back( before + 1.0 / diff );
+	}
+	_epsilon.swap( next );
+	
+	// The even columns hold the estimates.
+	_wynnEstimate = _epsilon[ (_epsilon.size() - 1) & ~size_t(1) ];
+}
+
+void	SeriesAccelerator::UpdateEuler()
+{
+	// Repeatedly replace the partial sums by averages of neighbors.
+	std::vector<double> averages( _recent );
+	while (averages.size() > 1)
+	{
+		for (size_t i = 0; i + 1 < averages.size(); ++i)
+		{
+			averages[i] = 0.5 * (averages[i] + averages[i + 1]);
+		}
+		averages.pop_back();
+	}
+	_eulerEstimate = averages[0];
+}
+
+void	SeriesAccelerator::UpdateRichardson( double inPartial )
+{
+	// Assume that the error of the partial sum is a series in powers of 1/n.
+	// Doubling n, the error of order m gets multiplied by 2^-m.
+	std::vector<double> row;
+	row.reserve( _richardson.size() + 1 );
+	row.push_back( inPartial );
+	double factor = 2.0;
+	
+	for (size_t m = 0; m < _richardson.size(); ++m)
+	{
+		row.push_back( row[m] + (row[m] - _richardson[m]) / (factor - 1.0) );
+		factor *= 2.0;
+	}
+	_richardson.swap( row );
+	_richardsonEstimate = _richardson.back();
+}
+
+// An alternating series can settle down to a value even if it diverges, as
+// the sum of (-1)^n settles at -1/2.  So we also require the terms to be
+// shrinking, and the estimate to hold up when the number of terms doubles.
+bool	SeriesAccelerator::ConfirmAlternating( bool inIsSettled, double inTermSize )
+{
+	bool isDone = false;
+	const bool isCandidate = inIsSettled and
+		(inTermSize <= kMaxTermRatio * _previousPowerTermSize);
+	
+	if (isnan( _candidate ))
+	{
+		if (isCandidate)
+		{
+			_candidate = _estimate;
+			_confirmCount = 2 * _count;
+		}
+	}
+	else if (_count >= _confirmCount)
+	{
+		const double allowed = _tolerance * std::max( 1.0, fabs( _candidate ) );
+		isDone = isCandidate and (fabs( _estimate - _candidate ) <= allowed);
+		if (not isDone)
+		{
+			_candidate = NAN;
+		}
+	}
+	
+	return isDone;
+}
+
+bool	SeriesAccelerator::AddPartial( double inPartial )
+{
+	bool isDone = false;
+	_count += 1;
+	
+	if (not isfinite( inPartial ))
+	{
+		_estimate = inPartial;
+		_errorEstimate = INFINITY;
+		return true;
+	}
+	
+	const double termSize = _recent.empty()? NAN :
+		fabs( inPartial - _recent.back() );
+	if ( (_count & (_count - 1)) == 0 )
+	{
+		_previousPowerTermSize = _powerTermSize;
+		_powerTermSize = termSize;
+	}
+	
+	if (_recent.size() >= 2)
+	{
+		const double lastTerm = _recent.back() - _recent[ _recent.size() - 2 ];
+		const double newTerm = inPartial - _recent.back();
+		_isAlternating = _isAlternating and (lastTerm * newTerm < 0.0);
+	}
+	_hasChanged = _hasChanged or
+		( (not _recent.empty()) and (inPartial != _recent.back()) );
+	_recent.push_back( inPartial );
+	if (_recent.size() > kEulerWindow)
+	{
+		_recent.erase( _recent.begin() );
+	}
+	
+	if (_count == 1)
+	{
+		_estimate = inPartial;
+	}
+	
+	// Keep to the schedule of checkpoints even when not using them, since
+	// an alternating series may stop alternating when its terms underflow.
+	const bool isCheckpoint = (_count == _nextCheckpoint);
+	if (isCheckpoint)
+	{
+		_nextCheckpoint *= 2;
+	}
+	
+	if (not _hasChanged)
+	{
+		if (_count >= kMinConstantCount)
+		{
+			_estimate = inPartial;
+			_errorEstimate = 0.0;
+			isDone = true;
+		}
+		return isDone;
+	}
+	
+	double lastWynn = _wynnEstimate;
+	UpdateWynn( inPartial );
+	
+	if (_isAlternating)
+	{
+		// Alternating series are well behaved under both the epsilon
+		// algorithm and the Euler transformation, so we can check every
+		// step.
+		bool isSettled = Accept( _wynnEstimate, lastWynn, _wynnAgreements,
+			kAgreementsNeeded );
+		
+		if ( (not isSettled) and (_recent.size() > 2) )
+		{
+			double lastEuler = _eulerEstimate;
+			UpdateEuler();
+			isSettled = Accept( _eulerEstimate, lastEuler, _eulerAgreements,
+				kAgreementsNeeded );
+		}
+		isDone = ConfirmAlternating( isSettled, termSize );
+	}
+	else if (isCheckpoint)
+	{
+		// For a series of one sign, successive estimates may creep along
+		// so slowly that they look settled when they are not, so we only
+		// compare estimates made with twice as many terms.
+		isDone = Accept( _wynnEstimate, _wynnAtCheckpoint, _wynnAgreements,
+			kCheckpointAgreementsNeeded );
+		
+		if (not isDone)
+		{
+			double lastRichardson = _richardsonEstimate;
+			UpdateRichardson( inPartial );
+			isDone = Accept( _richardsonEstimate, lastRichardson,
+				_richardsonAgreements, kCheckpointAgreementsNeeded );
+		}
+	}
+	
+	return isDone;
+}
@@ -0,0 +1,140 @@
+//  SeriesAccelerator.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SeriesAccelerator_hpp
+#define SeriesAccelerator_hpp
+
+#import <stddef.h>
+#import <vector>
+
+/*!
+	@class		SeriesAccelerator
+	
+	@abstract	Estimates the limit of a sequence of partial sums or partial
+				products, as more of them become known.
+	
+	@discussion	Three convergence acceleration methods are run side by side:
+				
+				The Wynn epsilon algorithm, which computes Shanks transforms and
+				works well for linearly convergent and alternating series.
+				
+				The Euler transformation, applied as repeated averaging of
+				partial sums, which works well for alternating series.
+				
+				Richardson extrapolation of partial sums taken at doubling
+				numbers of terms, which works for logarithmically convergent
+				series whose error is a series in powers of 1/n, such as the
+				sum of 1/n^2.
+				
+				The limit is considered found when the estimates of one of the
+				methods settle down to within the tolerance.  For series whose
+				terms do not alternate in sign, estimates are only compared
+				after doubling the number of terms.  For alternating series,
+				the terms must also be shrinking, and the estimate must still
+				hold after doubling the number of terms, since the estimates
+				of some divergent alternating series settle down too.  Nothing is accepted
+				while the partial sums or products stay the same, unless
+				they do so for a long time.
+*/
+class SeriesAccelerator
+{
+public:
+	explicit		SeriesAccelerator( double inTolerance );
+	
+	/*!
+		@function	AddPartial
+		@abstract	Supply the next partial sum or product.
+		@param		inPartial		The next member of the sequence.
+		@result		True if the limit has been found to within the tolerance.
+	*/
+	bool			AddPartial( double inPartial );
+	
+	/*!
+		@function	Estimate
+		@abstract	Get the best estimate of the limit so far.
+	*/
+	double			Estimate() const noexcept { return _estimate; }
+	
+	/*!
+		@function	ErrorEstimate
+		@abstract	Get an estimate of the error of the result of Estimate.
+	*/
+	double			ErrorEstimate() const noexcept { return _errorEstimate; }
+	
+	/*!
+		@function	Count
+		@abstract	Get the number of partial sums or products supplied so far.
+	*/
+	size_t			Count() const noexcept { return _count; }
+
+private:
+	void			UpdateWynn( double inPartial );
+	void			UpdateEuler();
+	void			UpdateRichardson( double inPartial );
+	bool			Accept( double inNewEstimate, double& ioLastEstimate,
+							int& ioAgreements, int inAgreementsNeeded );
+	bool			ConfirmAlternating( bool inIsSettled, double inTermSize );
+	
+	double					_tolerance;
+	size_t					_count;
+	double					_estimate;
+	double					_errorEstimate;
+	
+	// Last few partial sums, for detecting alternation and for Euler.
+	std::vector<double>		_recent;
+	bool					_isAlternating;
+	bool					_hasChanged;	// whether any two partials differ
+	
+	// Sizes of the terms at the last two powers of 2, to check that the
+	// terms of an alternating series shrink.
+	double					_powerTermSize;
+	double					_previousPowerTermSize;
+	
+	// Latest counter-diagonal of the epsilon table.
+	std::vector<double>		_epsilon;
+	double					_wynnEstimate;
+	int						_wynnAgreements;
+	
+	double					_eulerEstimate;
+	int						_eulerAgreements;
+	
+	// An estimate of the limit of an alternating series, to be confirmed
+	// when the number of terms reaches _confirmCount.
+	double					_candidate;
+	size_t					_confirmCount;
+	
+	// Latest row of the Richardson table, which gets a row at each
+	// checkpoint.
+	std::vector<double>		_richardson;
+	size_t					_nextCheckpoint;
+	double					_wynnAtCheckpoint;
+	double					_richardsonEstimate;
+	int						_richardsonAgreements;
+};
+
+#endif /* SeriesAccelerator_hpp */
@@ -0,0 +1,430 @@
+//  VectorMath.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "VectorMath.hpp"
+
+#import <bit>
+#import <math.h>
+#import <stdint.h>
+
+/*
+	Each function makes two passes over the array.  The first computes every
+	element with straight-line code, using comparisons and selections rather
+	than branches, so that the compiler can turn the loop into vector
+	operations.  The second passes the few elements that the first cannot
+	handle, such as huge arguments of sin and cos, to the C library.
+	
+	Fused multiply-add is only used where it is known to be an instruction,
+	since on Intel processors without FMA it is a library call.  There,
+	exact products are formed by Dekker's method instead.
+	
+	The polynomial coefficients of sin, cos, and log are those of fdlibm.
+*/
+
+// Adding and subtracting this rounds a number of magnitude below 2^51 to an
+// integer, and leaves that integer, in two's complement, in the low bits of
+// the sum.
+static constexpr double kShifter = 0x1.8p52;
+
+// 2^27 + 1, for splitting a double into two halves of 26 bits.
+static constexpr double kSplitter = 134217729.0;
+
+static constexpr double kLn2Hi = 6.93147180369123816490e-01;	// low 32 bits are 0
+static constexpr double kLn2Lo = 1.90821492927058770002e-10;
+
+// a + b = outSum + outError exactly.
+static inline void	TwoSum( double a, double b, double& outSum, double& outError )
+{
+	outSum = a + b;
+	const double bVirtual = outSum - a;
+	outError = (a - (outSum - bVirtual)) + (b - bVirtual);
+}
+
+// a * b = outProduct + outError exactly, unless a or b is huge.  Where
+// fused multiply-add is an instruction, it gives the error directly.
+static inline void	TwoProduct( double a, double b, double& outProduct,
+								double& outError )
+{
+	outProduct = a * b;
+#if defined(__FMA__) || defined(__aarch64__)
+	outError = fma( a, b, - outProduct );
+#else
+	const double aSplit = kSplitter * a;
+	const double aHigh = aSplit - (aSplit - a);
+	const double aLow = a - aHigh;
+	const double bSplit = kSplitter * b;
+	const double bHigh = bSplit - (bSplit - b);
+	const double bLow = b - bHigh;
+	outError = ((aHigh * bHigh - outProduct) + aHigh * bLow + aLow * bHigh) +
+		aLow * bLow;
+#endif
+}
+
+// 2^n for an integer n with -1022 <= n <= 1023.
+static inline double	PowerOfTwo( int64_t n )
+{
+	return std::bit_cast<double>( static_cast<uint64_t>( n + 1023 ) << 52 );
+}
+
+// The integer n as a double, for |n| < 2^51.  Unlike a conversion, this can
+// be done with vector instructions without AVX-512.
+static inline double	IntegerToDouble( int64_t n )
+{
+	return std::bit_cast<double>( std::bit_cast<int64_t>( kShifter ) + n ) -
+		kShifter;
+}
+
+#pragma mark sin and cos
+
+static constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+
+// pi/2 in pieces of 33 bits, and the rest, so that the products of the
+// pieces with integers below 2^20 are exact.
+static constexpr double kPiOver2_1 = 1.57079632673412561417e+00;
+static constexpr double kPiOver2_2 = 6.07710050630396597660e-11;
+static constexpr double kPiOver2_3 = 2.02226624871116645580e-21;
+static constexpr double kPiOver2_3t = 8.47842766036889956997e-32;
+
+// Largest argument reduced by the vector code.
+static constexpr double kMaxReducible = 0x1p19 * M_PI;
+
+// Below this, sin(x) rounds to x and cos(x) to 1.
+static constexpr double kTinyAngle = 0x1p-27;
+
+static constexpr double kS1 = -1.66666666666666324348e-01;
+static constexpr double kS2 = 8.33333333332248946124e-03;
+static constexpr double kS3 = -1.98412698298579493134e-04;
+static constexpr double kS4 = 2.75573137070700676789e-06;
+static constexpr double kS5 = -2.50507602534068634195e-08;
+static constexpr double kS6 = 1.58969099521155010221e-10;
+
+static constexpr double kC1 = 4.16666666666666019037e-02;
+static constexpr double kC2 = -1.38888888888741095749e-03;
+static constexpr double kC3 = 2.48015872894767294178e-05;
+static constexpr double kC4 = -2.75573143513906633035e-07;
+static constexpr double kC5 = 2.08757232129817482790e-09;
+static constexpr double kC6 = -1.13596475577881948265e-11;
+
+// Write x = n pi/2 + (outHi + outLo) with |outHi| <= pi/4 approximately,
+// returning n.  The subtractions of the pieces of pi/2 are exact, so the
+// reduced argument is accurate even when x is close to a multiple of pi/2.
+static inline int64_t	ReduceHalfPi( double x, double& outHi, double& outLo )
+{
+	const double shifted = x * kTwoOverPi + kShifter;
+	const double n = shifted - kShifter;
+	
+	double hi = x - n * kPiOver2_1;
+	double lo = 0.0, error = 0.0;
+	TwoSum( hi, - n * kPiOver2_2, hi, error );
+	lo += error;
+	TwoSum( hi, - n * kPiOver2_3, hi, error );
+	lo += error;
+	lo -= n * kPiOver2_3t;
+	
+	outHi = hi + lo;
+	outLo = lo - (outHi - hi);
+	return std::bit_cast<int64_t>( shifted ) - std::bit_cast<int64_t>( kShifter );
+}
+
+// sin(x + y) for |x| <= pi/4 and |y| much smaller.
+static inline double	SinKernel( double x, double y )
+{
+	const double z = x * x;
+	const double v = z * x;
+	const double r = kS2 + z * (kS3 + z * (kS4 + z * (kS5 + z * kS6)));
+	return x - ((z * (0.5 * y - v * r) - y) - v * kS1);
+}
+
+// cos(x + y) for |x| <= pi/4 and |y| much smaller.
+static inline double	CosKernel( double x, double y )
+{
+	const double z = x * x;
+	const double r = z * (kC1 + z * (kC2 + z * (kC3 + z * (kC4 +
+		z * (kC5 + z * kC6)))));
+	const double halfZ = 0.5 * z;
+	const double w = 1.0 - halfZ;
+	return w + (((1.0 - w) - halfZ) + (z * r - x * y));
+}
+
+// Negate inValue if bit 1 of inQuadrant is set.
+static inline double	FlipSign( double inValue, int64_t inQuadrant )
+{
+	return std::bit_cast<double>( std::bit_cast<uint64_t>( inValue ) ^
+		((static_cast<uint64_t>( inQuadrant ) & 2) << 62) );
+}
+
+void	VectorSin( const double* inX, double* outY, size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		const double x = inX[i];
+		double hi, lo;
+		const int64_t quadrant = ReduceHalfPi( x, hi, lo );
+		const double s = SinKernel( hi, lo );
+		const double c = CosKernel( hi, lo );
+		const double y = FlipSign( (quadrant & 1)? c : s, quadrant );
+		outY[i] = (fabs( x ) < kTinyAngle)? x : y;
+	}
+	
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		if (not (fabs( inX[i] ) <= kMaxReducible))
+		{
+			outY[i] = sin( inX[i] );
+		}
+	}
+}
+
+void	VectorCos( const double* inX, double* outY, size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		const double x = inX[i];
+		double hi, lo;
+		const int64_t quadrant = ReduceHalfPi( x, hi, lo );
+		const double s = SinKernel( hi, lo );
+		const double c = CosKernel( hi, lo );
+		const double y = FlipSign( (quadrant & 1)? s : c, quadrant + 1 );
+		outY[i] = (fabs( x ) < kTinyAngle)? 1.0 : y;
+	}
+	
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		if (not (fabs( inX[i] ) <= kMaxReducible))
+		{
+			outY[i] = cos( inX[i] );
+		}
+	}
+}
+
+#pragma mark exp
+
+static constexpr double kLog2e = 1.44269504088896338700e+00;
+
+// Above this, exp(x) overflows.  Below the other, it rounds to 0.
+static constexpr double kExpOverflow = 7.09782712893383973096e+02;
+static constexpr double kExpUnderflow = -7.45133219101941108420e+02;
+
+// exp(x + tail), where tail is much smaller than x.
+static inline double	ExpKernel( double x, double tail )
+{
+	// Clamping keeps the exponent of the scale factor in range.  A NaN
+	// passes through, and is dealt with at the end.
+	const double clamped = (x > 710.0)? 710.0 : ((x < -746.0)? -746.0 : x);
+	
+	// x = k ln 2 + r with |r| <= ln 2 / 2.
+	const double shifted = clamped * kLog2e + kShifter;
+	const double k = shifted - kShifter;
+	const int64_t kBits = std::bit_cast<int64_t>( shifted ) -
+		std::bit_cast<int64_t>( kShifter );
+	double r, rLo;
+	TwoSum( clamped - k * kLn2Hi, - k * kLn2Lo, r, rLo );
+	rLo += tail;
+	
+	// Taylor series of exp(r) - 1 through the 13th power, divided by r^2.
+	const double q = 1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 +
+		r * (1.0 / 720 + r * (1.0 / 5040 + r * (1.0 / 40320 +
+		r * (1.0 / 362880 + r * (1.0 / 3628800 + r * (1.0 / 39916800 +
+		r * (1.0 / 479001600 + r * (1.0 / 6227020800.0)))))))))));
+	
+	// exp(r + rLo) is about 1 + r + r^2 q + rLo exp(r).  Forming 1 + r
+	// exactly, as a sum and an error, leaves little error besides the final
+	// rounding.
+	const double onePlusR = 1.0 + r;
+	const double onePlusRError = (1.0 - onePlusR) + r;
+	const double squareTerm = r * r * q;
+	const double expR = onePlusR + (onePlusRError + (squareTerm +
+		rLo * (onePlusR + squareTerm)));
+	
+	// Scale by 2^k in two steps, so that neither factor is out of range and
+	// a subnormal result is rounded only once.
+	const int64_t k1 = kBits >> 1;
+	const int64_t k2 = kBits - k1;
+	double result = expR * PowerOfTwo( k1 ) * PowerOfTwo( k2 );
+	
+	result = (x > kExpOverflow)? INFINITY : result;
+	result = (x < kExpUnderflow)? 0.0 : result;
+	result = (x != x)? x : result;
+	return result;
+}
+
+void	VectorExp( const double* inX, double* outY, size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		outY[i] = ExpKernel( inX[i], 0.0 );
+	}
+}
+
+#pragma mark log
+
+static constexpr double kLg1 = 6.666666666666735130e-01;
+static constexpr double kLg2 = 3.999999999940941908e-01;
+static constexpr double kLg3 = 2.857142874366239149e-01;
+static constexpr double kLg4 = 2.222219843214978396e-01;
+static constexpr double kLg5 = 1.818357216161805012e-01;
+static constexpr double kLg6 = 1.531383769920937332e-01;
+static constexpr double kLg7 = 1.479819860511658591e-01;
+
+static constexpr uint64_t kMantissaMask = 0x000FFFFFFFFFFFFFULL;
+static constexpr uint64_t kExponentOfOne = 0x3FF0000000000000ULL;
+
+// Write a positive finite x as 2^outExponent * (1 + f), with
+// sqrt(2)/2 <= 1 + f < sqrt(2), returning f, which is exact.
+static inline double	SplitExponent( double x, double& outExponent )
+{
+	// Scale subnormal numbers into the normal range.
+	const bool isSubnormal = (x < 0x1p-1022);
+	const double scaled = isSubnormal? x * 0x1p54 : x;
+	const uint64_t bits = std::bit_cast<uint64_t>( scaled );
+	int64_t exponent = static_cast<int64_t>( bits >> 52 ) - 1023 -
+		(isSubnormal? 54 : 0);
+	double m = std::bit_cast<double>( (bits & kMantissaMask) | kExponentOfOne );
+	const bool isLarge = (m > M_SQRT2);
+	m = isLarge? 0.5 * m : m;
+	exponent += isLarge? 1 : 0;
+	
+	outExponent = IntegerToDouble( exponent );
+	return m - 1.0;
+}
+
+// The logarithm of x, given a value inLog that is correct if x is positive
+// and finite.
+static inline double	LogSpecialCase( double x, double inLog )
+{
+	double result = (x > 0.0)? inLog : ((x == 0.0)? -INFINITY : NAN);
+	result = (x == INFINITY)? x : result;
+	return result;
+}
+
+void	VectorLog( const double* inX, double* outY, size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		const double x = inX[i];
+		double k;
+		const double f = SplitExponent( x, k );
+		
+		const double s = f / (2.0 + f);
+		const double z = s * s;
+		const double w = z * z;
+		const double t1 = w * (kLg2 + w * (kLg4 + w * kLg6));
+		const double t2 = z * (kLg1 + w * (kLg3 + w * (kLg5 + w * kLg7)));
+		const double r = t2 + t1;
+		const double halfSquare = 0.5 * f * f;
+		const double log = k * kLn2Hi - ((halfSquare - (s * (halfSquare + r) +
+			k * kLn2Lo)) - f);
+		
+		outY[i] = LogSpecialCase( x, log );
+	}
+}
+
+#pragma mark pow
+
+static constexpr double kTwoThirds = 6.66666666666666629659e-01;
+static constexpr double kTwoThirdsLo = 3.70074341541718826189e-17;
+
+// Whether VectorPow computes pow(x, y) itself rather than leaving it to the
+// C library: the base must be positive and finite, and the exponent small
+// enough for TwoProduct.
+static inline bool	IsOrdinaryPower( double x, double y )
+{
+	return (x > 0.0) and (x < INFINITY) and (fabs( y ) < 0x1p900);
+}
+
+// log(x) = outHi + outLo to about 64 bits, for positive finite x.
+static inline void	PreciseLog( double x, double& outHi, double& outLo )
+{
+	double k;
+	const double f = SplitExponent( x, k );
+	
+	// log(1 + f) = 2 atanh(s) = 2s + 2s^3/3 + 2s^5/5 + ..., where
+	// s = f / (2 + f) = sHi + sLo.
+	const double u = 2.0 + f;
+	const double uLo = f - (u - 2.0);
+	const double sHi = f / u;
+	double product, productError;
+	TwoProduct( sHi, u, product, productError );
+	const double sLo = (((f - product) - productError) - sHi * uLo) / u;
+	
+	// The term 2s^3/3 in double-double.
+	double square, squareError, cube, cubeError, third, thirdError;
+	TwoProduct( sHi, sHi, square, squareError );
+	TwoProduct( square, sHi, cube, cubeError );
+	cubeError += squareError * sHi;
+	TwoProduct( cube, kTwoThirds, third, thirdError );
+	thirdError += cube * kTwoThirdsLo + cubeError * kTwoThirds;
+	
+	// The remaining terms, which are less than 2^-12 of the total.
+	const double z = square;
+	const double rest = 2.0 * cube * z * (1.0 / 5 + z * (1.0 / 7 + z * (1.0 / 9 +
+		z * (1.0 / 11 + z * (1.0 / 13 + z * (1.0 / 15 + z * (1.0 / 17 +
+		z * (1.0 / 19 + z * (1.0 / 21 + z * (1.0 / 23 + z * (1.0 / 25)))))))))));
+	
+	// 2 sLo is multiplied by the derivative of atanh, 1 / (1 - s^2).
+	double logHi, logLo;
+	TwoSum( 2.0 * sHi, third, logHi, logLo );
+	logLo += thirdError + rest + 2.0 * sLo * (1.0 + z);
+	
+	double hi, lo;
+	TwoSum( k * kLn2Hi, logHi, hi, lo );
+	lo += logLo + k * kLn2Lo;
+	
+	outHi = hi + lo;
+	outLo = lo - (outHi - hi);
+}
+
+void	VectorPow( const double* inX, const double* inY, double* outResult,
+					size_t inCount )
+{
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		const double x = inX[i];
+		const double y = inY[i];
+		
+		double logHi, logLo;
+		PreciseLog( x, logHi, logLo );
+		
+		// y log(x) in double-double.
+		double product, productError;
+		TwoProduct( y, logHi, product, productError );
+		productError += y * logLo;
+		const double exponent = product + productError;
+		const double exponentLo = productError - (exponent - product);
+		
+		outResult[i] = ExpKernel( exponent, exponentLo );
+	}
+	
+	for (size_t i = 0; i < inCount; ++i)
+	{
+		if (not IsOrdinaryPower( inX[i], inY[i] ))
+		{
+			outResult[i] = pow( inX[i], inY[i] );
+		}
+	}
+}
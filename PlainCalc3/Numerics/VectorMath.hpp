@@ -0,0 +1,89 @@
+//  VectorMath.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef VectorMath_hpp
+#define VectorMath_hpp
+
+#import <stddef.h>
+
+/*
+	Versions of sin, cos, exp, log, and pow that apply the function to an
+	array of numbers, written so that the compiler can use vector
+	instructions.  They are used for batch evaluation when the
+	fastTranscendentals member of the calculator state is set.  The C library
+	functions remain the reference.
+	
+	Error bounds are stated in units in the last place (ulps) relative to
+	the exact result, and are checked against results computed to 50 digits
+	over samples spread through the whole range of doubles.  Results are also
+	within 1 ulp of those of the C library, and special values (zeros,
+	infinities, NaNs) give the same results as the C library.
+*/
+
+/*!
+	@function	VectorSin
+	@abstract	outY[i] = sin( inX[i] ), with error below 1 ulp.
+	@discussion	Arguments beyond 2^19 pi in magnitude are passed to the C
+				library, since reducing them needs more bits of pi.
+*/
+void	VectorSin( const double* inX, double* outY, size_t inCount );
+
+/*!
+	@function	VectorCos
+	@abstract	outY[i] = cos( inX[i] ), with error below 1 ulp.
+	@discussion	Arguments beyond 2^19 pi in magnitude are passed to the C
+				library, since reducing them needs more bits of pi.
+*/
+void	VectorCos( const double* inX, double* outY, size_t inCount );
+
+/*!
+	@function	VectorExp
+	@abstract	outY[i] = exp( inX[i] ), with error below 1 ulp.
+*/
+void	VectorExp( const double* inX, double* outY, size_t inCount );
+
+/*!
+	@function	VectorLog
+	@abstract	outY[i] = log( inX[i] ), with error below 1 ulp.
+*/
+void	VectorLog( const double* inX, double* outY, size_t inCount );
+
+/*!
+	@function	VectorPow
+	@abstract	outResult[i] = pow( inX[i], inY[i] ), with error below 1 ulp.
+	@discussion	The logarithm of the base is computed to about 64 bits, so
+				that the error stays small even when the result is near the
+				limits of the range of doubles, and exact results such as
+				10^2 come out exact.  Negative, zero, infinite, or NaN bases,
+				and exponents beyond 2^900 in magnitude, are passed to the C
+				library.
+*/
+void	VectorPow( const double* inX, const double* inY, double* outResult,
+					size_t inCount );
+
+#endif /* VectorMath_hpp */
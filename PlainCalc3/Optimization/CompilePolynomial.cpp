@@ -0,0 +1,237 @@
+//  CompilePolynomial.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "CompilePolynomial.hpp"
+
+#import "BasicMath.hpp"
+#import "BinaryFuncNode.hpp"
+#import "IndexVariableNode.hpp"
+#import "NumberNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "PolynomialNode.hpp"
+#import "UnaryFuncNode.hpp"
+
+#import <algorithm>
+#import <math.h>
+
+// Coefficients in order of increasing degree.
+using Coefficients = std::vector<double>;
+
+// A subtree with this many nodes is no more work to evaluate directly.
+static constexpr unsigned int kMaxUncompiledNodes = 3;
+
+static void Trim( Coefficients& ioPoly )
+{
+	while ( (ioPoly.size() > 1) and (ioPoly.back() == 0.0) )
+	{
+		ioPoly.pop_back();
+	}
+}
+
+static bool IsMonomial( const Coefficients& inPoly )
+{
+	return std::count_if( inPoly.begin(), inPoly.end(),
+		[]( double coeff ) { return coeff != 0.0; } ) <= 1;
+}
+
+static Coefficients AddPolys( const Coefficients& inA, const Coefficients& inB,
+							double inBSign )
+{
+	Coefficients result( std::max( inA.size(), inB.size() ), 0.0 );
+	for (size_t i = 0; i < inA.size(); ++i)
+	{
+		result[i] = inA[i];
+	}
+	for (size_t i = 0; i < inB.size(); ++i)
+	{
+		result[i] += inBSign * inB[i];
+	}
+	Trim( result );
+	return result;
+}
+
+static std::optional<Coefficients> MultiplyPolys( const Coefficients& inA,
+												const Coefficients& inB )
+{
+	std::optional<Coefficients> result;
+	
+	if ( (inA.size() + inB.size() - 2 <= PolynomialNode::kMaxDegree) and
+		(IsMonomial( inA ) or IsMonomial( inB )) )
+	{
+		Coefficients product( inA.size() + inB.size() - 1, 0.0 );
+		for (size_t i = 0; i < inA.size(); ++i)
+		{
+			for (size_t j = 0; j < inB.size(); ++j)
+			{
+				product[i + j] += inA[i] * inB[j];
+			}
+		}
+		Trim( product );
+		result = product;
+	}
+	
+	return result;
+}
+
+static bool IsVariable( const ASTNode& inNode )
+{
+	return (dynamic_cast<const ParameterIndexNode*>( &inNode ) != nullptr) or
+		(dynamic_cast<const IndexVariableNode*>( &inNode ) != nullptr);
+}
+
+// Find the coefficients of a subtree as a polynomial in ioVariable.  If
+// ioVariable is null, the first variable found becomes the variable.
+static std::optional<Coefficients> FindCoefficients( const autoASTNode& inTree,
+													autoASTNode& ioVariable )
+{
+	std::optional<Coefficients> result;
+	
+	if (const NumberNode* numNode = dynamic_cast<const NumberNode*>( inTree.get() ))
+	{
+		result = Coefficients{ numNode->Value() };
+	}
+	else if (IsVariable( *inTree ))
+	{
+		if (not ioVariable)
+		{
+			ioVariable = inTree;
+		}
+		if (*ioVariable == *inTree)
+		{
+			result = Coefficients{ 0.0, 1.0 };
+		}
+	}
+	else if (const PolynomialNode* polyNode =
+		dynamic_cast<const PolynomialNode*>( inTree.get() ))
+	{
+		if (not ioVariable)
+		{
+			ioVariable = polyNode->Children()[0];
+		}
+		if (*ioVariable == *polyNode->Children()[0])
+		{
+			result = polyNode->Coefficients();
+		}
+	}
+	else if (const UnaryFuncNode* unNode =
+		dynamic_cast<const UnaryFuncNode*>( inTree.get() ))
+	{
+		if (unNode->GetFunc() == Negate)
+		{
+			result = FindCoefficients( unNode->Children()[0], ioVariable );
+			if (result.has_value())
+			{
+				result = AddPolys( Coefficients{ 0.0 }, *result, -1.0 );
+			}
+		}
+	}
+	else if (const BinaryFuncNode* binNode =
+		dynamic_cast<const BinaryFuncNode*>( inTree.get() ))
+	{
+		const BinaryFunc func = binNode->GetFunc();
+		
+		if ( (func != Plus) and (func != Minus) and (func != Multiply) and
+			(func != Divide) and (func != static_cast<BinaryFunc>( ::pow )) )
+		{
+			return result;
+		}
+		
+		std::optional<Coefficients> left( FindCoefficients(
+			binNode->Children()[0], ioVariable ) );
+		if (not left.has_value())
+		{
+			return result;
+		}
+		
+		if (func == static_cast<BinaryFunc>( ::pow ))
+		{
+			const NumberNode* exponentNode = dynamic_cast<const NumberNode*>(
+				binNode->Children()[1].get() );
+			if ( (exponentNode != nullptr) and IsMonomial( *left ) and
+				(exponentNode->Value() >= 0.0) and
+				(exponentNode->Value() == floor( exponentNode->Value() )) and
+				((left->size() - 1) * exponentNode->Value() <= PolynomialNode::kMaxDegree) )
+			{
+				Coefficients power{ 1.0 };
+				for (double i = 0.0; i < exponentNode->Value(); ++i)
+				{
+					power = *MultiplyPolys( power, *left );
+				}
+				result = power;
+			}
+			return result;
+		}
+		
+		std::optional<Coefficients> right( FindCoefficients(
+			binNode->Children()[1], ioVariable ) );
+		if (not right.has_value())
+		{
+			return result;
+		}
+		
+		if (func == Plus)
+		{
+			result = AddPolys( *left, *right, 1.0 );
+		}
+		else if (func == Minus)
+		{
+			result = AddPolys( *left, *right, -1.0 );
+		}
+		else if (func == Multiply)
+		{
+			result = MultiplyPolys( *left, *right );
+		}
+		else if (right->size() == 1)	// Divide by a constant
+		{
+			result = MultiplyPolys( *left, Coefficients{ 1.0 / right->front() } );
+		}
+	}
+	
+	return result;
+}
+
+autoASTNode	CompilePolynomial( const autoASTNode& inNode )
+{
+	autoASTNode result( inNode );
+	
+	if ( (inNode->Count() > kMaxUncompiledNodes) and
+		(dynamic_cast<const PolynomialNode*>( inNode.get() ) == nullptr) )
+	{
+		autoASTNode variable;
+		std::optional<Coefficients> coeffs( FindCoefficients( inNode, variable ) );
+		
+		if ( coeffs.has_value() and (coeffs->size() > 1) and
+			std::all_of( coeffs->begin(), coeffs->end(),
+				[]( double coeff ) { return isfinite( coeff ); } ) )
+		{
+			result = autoASTNode( new PolynomialNode( variable, *coeffs ) );
+		}
+	}
+	
+	return result;
+}
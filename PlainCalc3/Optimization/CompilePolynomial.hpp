@@ -0,0 +1,56 @@
+//  CompilePolynomial.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CompilePolynomial_hpp
+#define CompilePolynomial_hpp
+
+#import "ASTNode.hpp"
+
+/*!
+	@function	CompilePolynomial
+	
+	@abstract	Replace a polynomial subtree by a PolynomialNode.
+	
+	@discussion	A subtree qualifies if it is built from numbers and a single
+				variable, a function parameter or an index variable, using
+				addition, subtraction, negation, multiplication, division by a
+				number, and powers with nonnegative integer exponents.  To
+				avoid introducing rounding errors by expanding factored forms,
+				a product is only accepted if one of its factors is a
+				monomial, and a power only if its base is a monomial.
+				
+				Subtrees with no more than 3 nodes are left alone, as are
+				polynomials of degree 0.
+	
+	@param		inNode		A syntax tree node whose children have already
+							been optimized.
+	@result		An equivalent node.
+*/
+autoASTNode	CompilePolynomial( const autoASTNode& inNode );
+
+#endif /* CompilePolynomial_hpp */
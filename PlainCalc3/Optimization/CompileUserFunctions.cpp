@@ -0,0 +1,362 @@
+//  CompileUserFunctions.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "CompileUserFunctions.hpp"
+
+#import "CompilePolynomial.hpp"
+#import "FoldConstants.hpp"
+#import "FuseIterations.hpp"
+#import "LinearRecurrence.hpp"
+#import "NumberNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "RecursionTable.hpp"
+#import "SCalcState.hpp"
+#import "TabulateUserFunction.hpp"
+#import "TreeUtilities.hpp"
+#import "UserFuncNode.hpp"
+
+#import <math.h>
+#import <set>
+
+using NameSet = std::set< std::string >;
+
+// A function whose compiled body has more nodes than this is not inlined.
+static constexpr unsigned int kMaxInlineBodyNodes = 16;
+
+// If the body of an inlined function uses a parameter more than once, the
+// corresponding argument gets evaluated more than once, so we only allow that
+// for small arguments.
+static constexpr unsigned int kMaxDuplicatedArgNodes = 8;
+
+// Limit on the number of specializations, so that a recursive function
+// called with a constant argument cannot make us unroll it indefinitely.
+static constexpr size_t kMaxSpecializations = 64;
+
+// Specializations made for top-level calculations are retired once there
+// are this many, so that they do not use up the limit above.
+static constexpr size_t kMaxExpressionSpecializations = kMaxSpecializations / 2;
+
+// Specialized functions get names that can not be typed as identifiers.
+static constexpr char kSpecializationSeparator = '#';
+
+static autoASTNode Optimize( const autoASTNode& inTree,
+							SCalcState& ioState,
+							NameSet& ioInProgress );
+
+static bool IsCheapToDuplicate( const autoASTNode& inTree )
+{
+	return (inTree->Count() <= kMaxDuplicatedArgNodes) and
+		(not CallsUserFunctions( *inTree )) and
+		(not ContainsIteration( *inTree ));
+}
+
+// An inlinable body is small and does not call any user function, which
+// rules out recursion.  We also exclude iterations and integrals, because an
+// argument substituted into the body of an iteration could be captured by its
+// index variable.
+static bool IsInlinable( const autoASTNode& inBody )
+{
+	return (inBody->Count() <= kMaxInlineBodyNodes) and
+		(not CallsUserFunctions( *inBody )) and
+		(not ContainsIteration( *inBody ));
+}
+
+static bool CanSubstituteArguments( const autoASTNode& inBody,
+									const ASTNodeVec& inArgs )
+{
+	bool canSubstitute = true;
+	std::vector<unsigned int> useCounts( CountParameterUses( *inBody,
+		inArgs.size() ) );
+	
+	for (size_t i = 0; i < inArgs.size(); ++i)
+	{
+		if ( (useCounts[i] > 1) and (not IsCheapToDuplicate( inArgs[i] )) )
+		{
+			canSubstitute = false;
+			break;
+		}
+	}
+	
+	return canSubstitute;
+}
+
+// Look for faster ways to evaluate a compiled function than by evaluating
+// its body directly.
+static void FindEvaluationMethod( const std::string& inName,
+									CompiledFunc& ioCompiled )
+{
+	if (ioCompiled.paramCount == 1)
+	{
+		ioCompiled.maxRecursionOffset = FindRecursionDepth( inName,
+			*ioCompiled.body );
+		ioCompiled.recurrence = FindLinearRecurrence( inName, *ioCompiled.body );
+	}
+}
+
+// Returns nullptr if the function is undefined, or if we are already in the
+// middle of compiling it, i.e., it is recursive.
+static const CompiledFunc* CompileFunction( const std::string& inName,
+											SCalcState& ioState,
+											NameSet& ioInProgress )
+{
+	const CompiledFunc* result = nullptr;
+	
+	auto compiledIt = ioState.compiledFunctions.find( inName );
+	if (compiledIt != ioState.compiledFunctions.end())
+	{
+		result = &compiledIt->second;
+	}
+	else if (not ioInProgress.contains( inName ))
+	{
+		auto defIt = ioState.userFunctions.find( inName );
+		if (defIt != ioState.userFunctions.end())
+		{
+			ioInProgress.insert( inName );
+			autoASTNode body( Optimize( std::get<autoASTNode>( defIt->second ),
+				ioState, ioInProgress ) );
+			ioInProgress.erase( inName );
+			
+			CompiledFunc& compiled( ioState.compiledFunctions[ inName ] );
+			compiled.body = body;
+			compiled.paramCount = std::get<StringVec>( defIt->second ).size();
+			FindEvaluationMethod( inName, compiled );
+			result = &compiled;
+		}
+	}
+	
+	return result;
+}
+
+static autoASTNode InlineCall( const autoASTNode& inCall,
+								SCalcState& ioState,
+								NameSet& ioInProgress )
+{
+	autoASTNode result( inCall );
+	const UserFuncNode& callNode( dynamic_cast<const UserFuncNode&>( *inCall ) );
+	const CompiledFunc* callee = CompileFunction( callNode.FuncName(), ioState,
+		ioInProgress );
+	
+	if ( (callee != nullptr) and
+		(callee->paramCount == inCall->Children().size()) and
+		IsInlinable( callee->body ) and
+		CanSubstituteArguments( callee->body, inCall->Children() ) )
+	{
+		result = FoldConstants( SubstituteParameters( callee->body,
+			inCall->Children() ), ioState );
+	}
+	
+	return result;
+}
+
+// If some arguments of a call are constants, replace it by a call to a
+// residual function that takes only the remaining arguments, in which the
+// constants have been folded and dead branches of if nodes have been dropped.
+static autoASTNode SpecializeCall( const autoASTNode& inCall,
+									SCalcState& ioState,
+									NameSet& ioInProgress )
+{
+	autoASTNode result( inCall );
+	const UserFuncNode& callNode( dynamic_cast<const UserFuncNode&>( *inCall ) );
+	const ASTNodeVec& args( inCall->Children() );
+	
+	auto defIt = ioState.userFunctions.find( callNode.FuncName() );
+	if ( (defIt == ioState.userFunctions.end()) or
+		(std::get<StringVec>( defIt->second ).size() != args.size()) )
+	{
+		return result;
+	}
+	
+	SpecializationKey key( callNode.FuncName(), {} );
+	key.second.reserve( args.size() );
+	ASTNodeVec substitutions, residualArgs;
+	substitutions.reserve( args.size() );
+	
+	for (const autoASTNode& arg : args)
+	{
+		const NumberNode* numNode = dynamic_cast<const NumberNode*>( arg.get() );
+		if ( (numNode != nullptr) and (not isnan( numNode->Value() )) )
+		{
+			key.second.push_back( numNode->Value() );
+			substitutions.push_back( arg );
+		}
+		else
+		{
+			key.second.push_back( std::nullopt );
+			substitutions.push_back( autoASTNode( new ParameterIndexNode(
+				static_cast<unsigned int>( residualArgs.size() ) ) ) );
+			residualArgs.push_back( arg );
+		}
+	}
+	
+	if (residualArgs.size() < args.size())
+	{
+		auto specIt = ioState.specializations.find( key );
+		if (specIt != ioState.specializations.end())
+		{
+			result = autoASTNode( new UserFuncNode( specIt->second, residualArgs ) );
+		}
+		else if (ioState.specializations.size() < kMaxSpecializations)
+		{
+			// A serial number, rather than the number of specializations,
+			// keeps names of retired specializations from being reused.
+			std::string specName( callNode.FuncName() + kSpecializationSeparator +
+				std::to_string( ioState.specializationSerial++ ) );
+			
+			// Record the specialization before optimizing its body, so that
+			// recursive calls with the same constants can find it.
+			ioState.specializations.emplace( key, specName );
+			if (ioState.optimizingExpression)
+			{
+				ioState.expressionSpecializations.push_back( key );
+			}
+			autoASTNode residual( SubstituteParameters(
+				std::get<autoASTNode>( defIt->second ), substitutions ) );
+			ioState.compiledFunctions[ specName ] =
+				CompiledFunc{ residual, residualArgs.size() };
+			ioState.functionsVersion += 1;
+			
+			residual = Optimize( residual, ioState, ioInProgress );
+			CompiledFunc& compiled( ioState.compiledFunctions[ specName ] );
+			compiled.body = residual;
+			FindEvaluationMethod( specName, compiled );
+			
+			result = autoASTNode( new UserFuncNode( specName, residualArgs ) );
+		}
+	}
+	
+	return result;
+}
+
+static autoASTNode Optimize( const autoASTNode& inTree,
+							SCalcState& ioState,
+							NameSet& ioInProgress )
+{
+	autoASTNode result( inTree );
+	
+	if (not inTree->Children().empty())
+	{
+		ASTNodeVec newChildren;
+		newChildren.reserve( inTree->Children().size() );
+		bool didChange = false;
+		
+		for (const autoASTNode& child : inTree->Children())
+		{
+			newChildren.push_back( Optimize( child, ioState, ioInProgress ) );
+			didChange = didChange or (newChildren.back() != child);
+		}
+		
+		if (didChange)
+		{
+			result = inTree->CloneWithChildren( newChildren );
+		}
+		
+		result = FoldConstantNode( result, ioState );
+		result = FuseIterations( result );
+		result = CompilePolynomial( result );
+	}
+	
+	// A call of a tabulated function is left alone, so that it gets
+	// evaluated by the approximation.
+	const UserFuncNode* callNode = dynamic_cast<const UserFuncNode*>( result.get() );
+	if ( (callNode != nullptr) and
+		(not ioState.tabulations.contains( callNode->FuncName() )) )
+	{
+		autoASTNode inlined( InlineCall( result, ioState, ioInProgress ) );
+		
+		if (inlined == result)
+		{
+			result = SpecializeCall( result, ioState, ioInProgress );
+			
+			// The specialized function may have become simple enough to
+			// inline.
+			if (result != inlined)
+			{
+				result = InlineCall( result, ioState, ioInProgress );
+			}
+		}
+		else
+		{
+			result = inlined;
+		}
+	}
+	
+	return result;
+}
+
+void	CompileUserFunctions( SCalcState& ioState )
+{
+	ioState.compiledFunctions.clear();
+	ioState.specializations.clear();
+	ioState.expressionSpecializations.clear();
+	ioState.specializationSerial = 0;
+	ioState.recursionTables.clear();
+	ioState.prefixSums.clear();
+	DiscardStaleTabulations( ioState );
+	ioState.functionsVersion += 1;
+	NameSet inProgress;
+	
+	for (const auto& [name, def] : ioState.userFunctions)
+	{
+		CompileFunction( name, ioState, inProgress );
+	}
+}
+
+
+autoASTNode	OptimizeExpression( const autoASTNode& inTree, SCalcState& ioState )
+{
+	NameSet inProgress;
+	
+	ioState.optimizingExpression = true;
+	autoASTNode result( Optimize( inTree, ioState, inProgress ) );
+	ioState.optimizingExpression = false;
+	
+	return result;
+}
+
+
+// Nothing refers to these specializations between calculations except
+// caches, which identify functions by name, and names are not reused.
+// The worker states of parallel evaluation may keep their copies, so
+// there is no need to change the functionsVersion.
+void	RetireExpressionSpecializations( SCalcState& ioState )
+{
+	if (ioState.expressionSpecializations.size() >= kMaxExpressionSpecializations)
+	{
+		for (const SpecializationKey& key : ioState.expressionSpecializations)
+		{
+			auto specIt = ioState.specializations.find( key );
+			if (specIt != ioState.specializations.end())
+			{
+				ioState.compiledFunctions.erase( specIt->second );
+				ioState.recursionTables.erase( specIt->second );
+				ioState.specializations.erase( specIt );
+			}
+		}
+		ioState.expressionSpecializations.clear();
+	}
+}
@@ -0,0 +1,97 @@
+//  CompileUserFunctions.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef CompileUserFunctions_hpp
+#define CompileUserFunctions_hpp
+
+#import "ASTNode.hpp"
+
+struct SCalcState;
+
+/*!
+	@function	CompileUserFunctions
+	
+	@abstract	Rebuild the compiled forms of all user-defined functions.
+	
+	@discussion	The compiled form of a function is the syntax tree that is
+				actually evaluated when the function is called.  It differs
+				from the right hand side recorded in userFunctions in that
+				calls to small, non-recursive user functions have been replaced
+				by the bodies of those functions, constant subexpressions have
+				been evaluated, and calls with some constant arguments have been
+				replaced by calls to specialized versions of the callee.
+				
+				Since the compiled form of a function can depend on the
+				definitions of other functions, this should be called whenever
+				any user function is defined, redefined, or removed.  For the
+				same reason, it discards cached recursion tables and prefix
+				sums, and approximations made by tabulate whose functions
+				depend on changed definitions.
+	
+	@param		ioState		A calculator state whose compiledFunctions member will
+							be rebuilt from its userFunctions member.
+*/
+void	CompileUserFunctions( SCalcState& ioState );
+
+
+/*!
+	@function	OptimizeExpression
+	
+	@abstract	Apply the optimizations used by CompileUserFunctions to a syntax
+				tree that is not part of a function definition.
+	
+	@discussion	This is worthwhile for trees that will be evaluated many times,
+				such as the body of an iteration.  It may add specializations
+				to the compiledFunctions member of the state, which later
+				calculations with the same constant arguments reuse until
+				RetireExpressionSpecializations removes them.
+	
+	@param		inTree		A syntax tree.
+	@param		ioState		A calculator state.
+	@result		An equivalent syntax tree.
+*/
+autoASTNode	OptimizeExpression( const autoASTNode& inTree, SCalcState& ioState );
+
+
+/*!
+	@function	RetireExpressionSpecializations
+	
+	@abstract	Discard the specializations made by OptimizeExpression once
+				there are many of them.
+	
+	@discussion	Without this, each new combination of a function and
+				constant arguments in an ordinary calculation would use up
+				one of the limited number of specializations for the rest of
+				the session.  It must be called between calculations, when no
+				syntax tree refers to the specializations.
+	
+	@param		ioState		A calculator state.
+*/
+void	RetireExpressionSpecializations( SCalcState& ioState );
+
+#endif /* CompileUserFunctions_hpp */
@@ -0,0 +1,109 @@
+//  FoldConstants.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "FoldConstants.hpp"
+
+#import "BinaryFuncNode.hpp"
+#import "IfNode.hpp"
+#import "NaryFuncNode.hpp"
+#import "NumberNode.hpp"
+#import "PolynomialNode.hpp"
+#import "SCalcState.hpp"
+#import "UnaryFuncNode.hpp"
+
+#import <algorithm>
+
+static bool IsNumber( const autoASTNode& inNode )
+{
+	return dynamic_cast<const NumberNode*>( inNode.get() ) != nullptr;
+}
+
+static bool IsBuiltInFunction( const autoASTNode& inNode )
+{
+	return (dynamic_cast<const UnaryFuncNode*>( inNode.get() ) != nullptr) or
+		(dynamic_cast<const BinaryFuncNode*>( inNode.get() ) != nullptr) or
+		(dynamic_cast<const NaryFuncNode*>( inNode.get() ) != nullptr) or
+		(dynamic_cast<const PolynomialNode*>( inNode.get() ) != nullptr);
+}
+
+autoASTNode	FoldConstantNode( const autoASTNode& inNode, SCalcState& ioState )
+{
+	autoASTNode result( inNode );
+	
+	if (dynamic_cast<const IfNode*>( inNode.get() ) != nullptr)
+	{
+		const NumberNode* testNode =
+			dynamic_cast<const NumberNode*>( inNode->Children()[0].get() );
+		if (testNode != nullptr)
+		{
+			// Same test as IfNode::Evaluate.
+			result = (testNode->Value() > 0.0)? inNode->Children()[1] :
+				inNode->Children()[2];
+		}
+	}
+	else if ( IsBuiltInFunction( inNode ) and
+		std::all_of( inNode->Children().begin(), inNode->Children().end(),
+			IsNumber ) )
+	{
+		std::optional<double> value( inNode->Evaluate( ioState ) );
+		if (value.has_value())
+		{
+			result = MakeNode<NumberNode>( *value );
+		}
+	}
+	
+	return result;
+}
+
+
+autoASTNode	FoldConstants( const autoASTNode& inTree, SCalcState& ioState )
+{
+	autoASTNode result( inTree );
+	
+	if (not inTree->Children().empty())
+	{
+		ASTNodeVec newChildren;
+		newChildren.reserve( inTree->Children().size() );
+		bool didChange = false;
+		
+		for (const autoASTNode& child : inTree->Children())
+		{
+			newChildren.push_back( FoldConstants( child, ioState ) );
+			didChange = didChange or (newChildren.back() != child);
+		}
+		
+		if (didChange)
+		{
+			result = inTree->CloneWithChildren( newChildren );
+		}
+		
+		result = FoldConstantNode( result, ioState );
+	}
+	
+	return result;
+}
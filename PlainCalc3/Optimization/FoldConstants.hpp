@@ -0,0 +1,65 @@
+//  FoldConstants.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef FoldConstants_hpp
+#define FoldConstants_hpp
+
+#import "ASTNode.hpp"
+
+struct SCalcState;
+
+/*!
+	@function	FoldConstantNode
+	
+	@abstract	Simplify a node whose children have already been simplified.
+	
+	@discussion	A built-in function or polynomial node whose arguments are all
+				numbers is replaced by a number node holding its value, and an
+				if node whose test is a number is replaced by the branch that
+				would be taken.  Other nodes are returned unchanged.
+	
+	@param		inNode		A syntax tree node.
+	@param		ioState		A calculator state, used for evaluation.
+	@result		An equivalent node.
+*/
+autoASTNode	FoldConstantNode( const autoASTNode& inNode, SCalcState& ioState );
+
+
+/*!
+	@function	FoldConstants
+	
+	@abstract	Simplify a syntax tree by applying FoldConstantNode from the
+				bottom up.
+	
+	@param		inTree		A syntax tree.
+	@param		ioState		A calculator state, used for evaluation.
+	@result		An equivalent tree.
+*/
+autoASTNode	FoldConstants( const autoASTNode& inTree, SCalcState& ioState );
+
+#endif /* FoldConstants_hpp */
@@ -0,0 +1,126 @@
+//  FuseIterations.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "FuseIterations.hpp"
+
+#import "FusedIterationNode.hpp"
+#import "IndexVariableNode.hpp"
+#import "IterationNode.hpp"
+#import "NumberNode.hpp"
+
+#import <algorithm>
+#import <math.h>
+
+static bool UsesIndexVariable( const ASTNode& inTree, const std::string& inName )
+{
+	const IndexVariableNode* varNode =
+		dynamic_cast<const IndexVariableNode*>( &inTree );
+	bool found = (varNode != nullptr) and (varNode->Name() == inName);
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		if (found)
+		{
+			break;
+		}
+		found = UsesIndexVariable( *child, inName );
+	}
+	
+	return found;
+}
+
+static bool IsInfiniteConstant( const ASTNode& inTree )
+{
+	const NumberNode* numNode = dynamic_cast<const NumberNode*>( &inTree );
+	return (numNode != nullptr) and isinf( numNode->Value() );
+}
+
+autoASTNode	FuseIterations( const autoASTNode& inNode )
+{
+	const IterationNode* outer = dynamic_cast<const IterationNode*>( inNode.get() );
+	if ( (outer == nullptr) or outer->HasTolerance() or
+		IsInfiniteConstant( *outer->Children()[1] ) )
+	{
+		return inNode;
+	}
+	const autoASTNode& content( outer->Children()[2] );
+	
+	// Collect the index variables, bounds, and content of the inner iteration.
+	std::vector<std::string> innerVariables;
+	ASTNodeVec innerBounds;
+	autoASTNode innerContent;
+	
+	if (const IterationNode* inner = dynamic_cast<const IterationNode*>( content.get() ))
+	{
+		if ( (inner->Kind() != outer->Kind()) or inner->HasTolerance() or
+			IsInfiniteConstant( *inner->Children()[1] ) )
+		{
+			return inNode;
+		}
+		innerVariables.push_back( inner->Variable() );
+		innerBounds.assign( inner->Children().begin(), inner->Children().begin() + 2 );
+		innerContent = inner->Children()[2];
+	}
+	else if (const FusedIterationNode* inner =
+		dynamic_cast<const FusedIterationNode*>( content.get() ))
+	{
+		if (inner->Kind() != outer->Kind())
+		{
+			return inNode;
+		}
+		innerVariables = inner->Variables();
+		innerBounds.assign( inner->Children().begin(), inner->Children().end() - 1 );
+		innerContent = inner->Content();
+	}
+	else
+	{
+		return inNode;
+	}
+	
+	// The inner bounds must not depend on the outer index variable, which
+	// must not be hidden by an inner one of the same name.
+	if ( (std::find( innerVariables.begin(), innerVariables.end(),
+			outer->Variable() ) != innerVariables.end()) or
+		std::any_of( innerBounds.begin(), innerBounds.end(),
+			[outer]( const autoASTNode& bound )
+			{
+				return UsesIndexVariable( *bound, outer->Variable() );
+			} ) )
+	{
+		return inNode;
+	}
+	
+	std::vector<std::string> variables{ outer->Variable() };
+	variables.insert( variables.end(), innerVariables.begin(), innerVariables.end() );
+	ASTNodeVec children{ outer->Children()[0], outer->Children()[1] };
+	children.insert( children.end(), innerBounds.begin(), innerBounds.end() );
+	children.push_back( innerContent );
+	
+	return autoASTNode( new FusedIterationNode( outer->Kind(), variables,
+		children ) );
+}
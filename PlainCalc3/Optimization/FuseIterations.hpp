@@ -0,0 +1,54 @@
+//  FuseIterations.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef FuseIterations_hpp
+#define FuseIterations_hpp
+
+#import "ASTNode.hpp"
+
+/*!
+	@function	FuseIterations
+	
+	@abstract	Combine an iteration with an iteration of the same kind
+				directly inside it.
+	
+	@discussion	A sum whose content is a sum, or a product whose content is a
+				product, is replaced by a FusedIterationNode, provided that the
+				bounds of the inner iteration do not depend on the outer index
+				variable.  The inner iteration may itself be a
+				FusedIterationNode, so applying this from the bottom up
+				flattens a whole nest.  Iterations with a tolerance, and those
+				whose end value is the constant ∞, are left alone.
+	
+	@param		inNode		A syntax tree node whose children have already
+							been optimized.
+	@result		An equivalent node.
+*/
+autoASTNode	FuseIterations( const autoASTNode& inNode );
+
+#endif /* FuseIterations_hpp */
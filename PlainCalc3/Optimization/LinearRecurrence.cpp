@@ -0,0 +1,343 @@
+//  LinearRecurrence.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "LinearRecurrence.hpp"
+
+#import "BasicMath.hpp"
+#import "BinaryFuncNode.hpp"
+#import "IfNode.hpp"
+#import "NumberNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "RecursionTable.hpp"
+#import "SCalcState.hpp"
+#import "TreeUtilities.hpp"
+#import "UnaryFuncNode.hpp"
+#import "UserFuncNode.hpp"
+
+#import <algorithm>
+#import <math.h>
+
+// Beyond this, consecutive integers are not distinguishable as doubles.
+static constexpr double kMaxSteps = 9007199254740992.0;	// 2^53
+
+namespace
+{
+	// a1 f(n-1) + ... + ad f(n-d) + b
+	struct LinearForm
+	{
+		std::vector<double>	coefficients;
+		double				constant = 0.0;
+		
+		bool	IsConstant() const
+				{
+					return std::all_of( coefficients.begin(),
+						coefficients.end(), []( double c ) { return c == 0.0; } );
+				}
+		
+		void	Scale( double inFactor )
+				{
+					for (double& c : coefficients)
+					{
+						c *= inFactor;
+					}
+					constant *= inFactor;
+				}
+		
+		void	Add( const LinearForm& inOther, double inFactor )
+				{
+					if (coefficients.size() < inOther.coefficients.size())
+					{
+						coefficients.resize( inOther.coefficients.size(), 0.0 );
+					}
+					for (size_t i = 0; i < inOther.coefficients.size(); ++i)
+					{
+						coefficients[i] += inFactor * inOther.coefficients[i];
+					}
+					constant += inFactor * inOther.constant;
+				}
+	};
+	
+	// Square matrix stored by rows.
+	struct Matrix
+	{
+		explicit	Matrix( size_t inSize )
+						: size( inSize ), entries( inSize * inSize, 0.0 ) {}
+		
+		double&			at( size_t row, size_t col )
+						{ return entries[ row * size + col ]; }
+		const double&	at( size_t row, size_t col ) const
+						{ return entries[ row * size + col ]; }
+		
+		size_t				size;
+		std::vector<double>	entries;
+	};
+}
+
+static Matrix operator*( const Matrix& inA, const Matrix& inB )
+{
+	Matrix product( inA.size );
+	
+	for (size_t i = 0; i < inA.size; ++i)
+	{
+		for (size_t k = 0; k < inA.size; ++k)
+		{
+			const double a = inA.at( i, k );
+			if (a != 0.0)
+			{
+				for (size_t j = 0; j < inA.size; ++j)
+				{
+					product.at( i, j ) += a * inB.at( k, j );
+				}
+			}
+		}
+	}
+	
+	return product;
+}
+
+static std::optional<LinearForm> GetLinearForm( const std::string& inName,
+												const ASTNode& inTree )
+{
+	std::optional<LinearForm> result;
+	
+	if (const NumberNode* numNode = dynamic_cast<const NumberNode*>( &inTree ))
+	{
+		result = LinearForm();
+		result->constant = numNode->Value();
+	}
+	else if (const UserFuncNode* callNode = dynamic_cast<const UserFuncNode*>( &inTree ))
+	{
+		if ( (callNode->FuncName() == inName) and
+			(callNode->Children().size() == 1) )
+		{
+			unsigned int offset = GetRecursionOffset( *callNode->Children()[0] );
+			if (offset > 0)
+			{
+				result = LinearForm();
+				result->coefficients.resize( offset, 0.0 );
+				result->coefficients[ offset - 1 ] = 1.0;
+			}
+		}
+	}
+	else if (const UnaryFuncNode* unNode = dynamic_cast<const UnaryFuncNode*>( &inTree ))
+	{
+		if (unNode->GetFunc() == Negate)
+		{
+			result = GetLinearForm( inName, *inTree.Children()[0] );
+			if (result.has_value())
+			{
+				result->Scale( -1.0 );
+			}
+		}
+	}
+	else if (const BinaryFuncNode* binNode = dynamic_cast<const BinaryFuncNode*>( &inTree ))
+	{
+		std::optional<LinearForm> left( GetLinearForm( inName, *inTree.Children()[0] ) );
+		std::optional<LinearForm> right( GetLinearForm( inName, *inTree.Children()[1] ) );
+		
+		if (left.has_value() and right.has_value())
+		{
+			BinaryFunc func = binNode->GetFunc();
+			
+			if ( (func == Plus) or (func == Minus) )
+			{
+				result = left;
+				result->Add( *right, (func == Plus)? 1.0 : -1.0 );
+			}
+			else if ( (func == Multiply) and left->IsConstant() )
+			{
+				result = right;
+				result->Scale( left->constant );
+			}
+			else if ( (func == Multiply) and right->IsConstant() )
+			{
+				result = left;
+				result->Scale( right->constant );
+			}
+			else if ( (func == Divide) and right->IsConstant() and
+				(right->constant != 0.0) )
+			{
+				result = left;
+				result->Scale( 1.0 / right->constant );
+			}
+		}
+	}
+	
+	return result;
+}
+
+// Recognize n - k, n + (-k), or n, returning k.
+static std::optional<double> GetThreshold( const ASTNode& inTest )
+{
+	std::optional<double> result;
+	
+	if (const ParameterIndexNode* paramNode = dynamic_cast<const ParameterIndexNode*>( &inTest ))
+	{
+		if (paramNode->Index() == 0)
+		{
+			result = 0.0;
+		}
+	}
+	else if (const BinaryFuncNode* binNode = dynamic_cast<const BinaryFuncNode*>( &inTest ))
+	{
+		const ParameterIndexNode* paramNode = dynamic_cast<const ParameterIndexNode*>(
+			inTest.Children()[0].get() );
+		const NumberNode* numNode = dynamic_cast<const NumberNode*>(
+			inTest.Children()[1].get() );
+		
+		if ( (paramNode != nullptr) and (paramNode->Index() == 0) and
+			(numNode != nullptr) )
+		{
+			if (binNode->GetFunc() == Minus)
+			{
+				result = numNode->Value();
+			}
+			else if (binNode->GetFunc() == Plus)
+			{
+				result = -numNode->Value();
+			}
+		}
+	}
+	
+	return result;
+}
+
+autoLinearRecurrence	FindLinearRecurrence( const std::string& inName,
+											const ASTNode& inBody )
+{
+	autoLinearRecurrence result;
+	
+	if (dynamic_cast<const IfNode*>( &inBody ) != nullptr)
+	{
+		std::optional<double> threshold( GetThreshold( *inBody.Children()[0] ) );
+		std::optional<LinearForm> form( GetLinearForm( inName,
+			*inBody.Children()[1] ) );
+		const autoASTNode& baseCase( inBody.Children()[2] );
+		
+		if ( threshold.has_value() and isfinite( *threshold ) and
+			form.has_value() and (not form->IsConstant()) and
+			(not CallsUserFunctions( *baseCase )) )
+		{
+			std::shared_ptr<LinearRecurrence> recurrence(
+				std::make_shared<LinearRecurrence>() );
+			recurrence->threshold = *threshold;
+			recurrence->coefficients = form->coefficients;
+			recurrence->constant = form->constant;
+			recurrence->baseCase = baseCase;
+			result = recurrence;
+		}
+	}
+	
+	return result;
+}
+
+
+std::optional<double>	EvaluateLinearRecurrence( const LinearRecurrence& inRecurrence,
+												double inArg,
+												SCalcState& ioState )
+{
+	std::optional<double> result;
+	
+	// The number of times the recursive branch is taken before reaching a
+	// base case.
+	const double steps = ceil( inArg - inRecurrence.threshold );
+	if ( (inArg != floor( inArg )) or (steps < 1.0) or (steps > kMaxSteps) )
+	{
+		return result;
+	}
+	
+	// Evaluate the base case at the d arguments preceding the first
+	// recursive one.
+	const double firstBase = inArg - steps;
+	const size_t order = inRecurrence.coefficients.size();
+	std::vector<double> initial;
+	initial.reserve( order );
+	DoubleVec args( 1 );
+	ioState.functionArguments.swap( args );
+	
+	for (size_t i = 0; i < order; ++i)
+	{
+		ioState.functionArguments[0] = firstBase - i;
+		std::optional<double> baseVal( inRecurrence.baseCase->Evaluate( ioState ) );
+		if (not baseVal.has_value())
+		{
+			break;
+		}
+		initial.push_back( *baseVal );
+	}
+	ioState.functionArguments.swap( args );
+	
+	if (initial.size() == order)
+	{
+		// The state vector is (f(m), f(m-1), ..., f(m-d+1), 1).  The companion
+		// matrix advances m by 1.
+		Matrix companion( order + 1 );
+		for (size_t j = 0; j < order; ++j)
+		{
+			companion.at( 0, j ) = inRecurrence.coefficients[j];
+		}
+		companion.at( 0, order ) = inRecurrence.constant;
+		for (size_t i = 1; i < order; ++i)
+		{
+			companion.at( i, i - 1 ) = 1.0;
+		}
+		companion.at( order, order ) = 1.0;
+		
+		// Raise it to the power steps by repeated squaring.
+		Matrix power( order + 1 );
+		for (size_t i = 0; i <= order; ++i)
+		{
+			power.at( i, i ) = 1.0;
+		}
+		for (uint64_t n = static_cast<uint64_t>( steps ); n > 0; n >>= 1)
+		{
+			if (n & 1)
+			{
+				power = power * companion;
+			}
+			if (n > 1)
+			{
+				companion = companion * companion;
+			}
+		}
+		
+		double value = power.at( 0, order );
+		for (size_t j = 0; j < order; ++j)
+		{
+			value += power.at( 0, j ) * initial[j];
+		}
+		// If something overflowed, the matrix may hold infinities and NaNs
+		// that the direct evaluation would not have produced.
+		if (isfinite( value ))
+		{
+			result = value;
+		}
+	}
+	
+	return result;
+}
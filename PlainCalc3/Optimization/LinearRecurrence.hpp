@@ -0,0 +1,88 @@
+//  LinearRecurrence.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef LinearRecurrence_hpp
+#define LinearRecurrence_hpp
+
+#import "ASTNode.hpp"
+
+#import <memory>
+#import <optional>
+#import <string>
+#import <vector>
+
+struct SCalcState;
+
+/*!
+	@struct		LinearRecurrence
+	
+	@abstract	Description of a function of the form
+				f(n) = if( n - k, a1 f(n-1) + ... + ad f(n-d) + b, base(n) ).
+*/
+struct LinearRecurrence
+{
+	double					threshold;		// k
+	std::vector<double>		coefficients;	// a1 ... ad
+	double					constant;		// b
+	autoASTNode				baseCase;		// does not call f
+};
+
+using autoLinearRecurrence = std::shared_ptr< const LinearRecurrence >;
+
+
+/*!
+	@function	FindLinearRecurrence
+	
+	@abstract	Recognize a constant-coefficient linear recurrence.
+	
+	@param		inName		Name of a function of one parameter.
+	@param		inBody		Compiled body of the function.
+	@result		A description of the recurrence, or nullptr.
+*/
+autoLinearRecurrence	FindLinearRecurrence( const std::string& inName,
+											const ASTNode& inBody );
+
+
+/*!
+	@function	EvaluateLinearRecurrence
+	
+	@abstract	Evaluate a linear recurrence in O(log n) time by raising its
+				companion matrix to a power.
+	
+	@param		inRecurrence	The recurrence.
+	@param		inArg			Argument value.
+	@param		ioState			A calculator state.
+	@result		The function value, or nothing if the argument is not an
+				integer greater than the threshold, in which case the caller
+				should evaluate the function in the usual way.
+*/
+std::optional<double>	EvaluateLinearRecurrence( const LinearRecurrence& inRecurrence,
+												double inArg,
+												SCalcState& ioState );
+
+#endif /* LinearRecurrence_hpp */
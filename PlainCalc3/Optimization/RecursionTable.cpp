@@ -0,0 +1,301 @@
+//  RecursionTable.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "RecursionTable.hpp"
+
+#import "BasicMath.hpp"
+#import "BinaryFuncNode.hpp"
+#import "DerivativeNode.hpp"
+#import "MinimizeNode.hpp"
+#import "NumberNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "SCalcState.hpp"
+#import "UserFuncNode.hpp"
+
+#import <math.h>
+
+// We do not make tables larger than this, or look further than this for
+// base cases.
+static constexpr size_t kMaxTableSize = 1U << 20;
+
+// Tables larger than this are discarded between calculations.
+static constexpr size_t kMaxKeptTableSize = 1U << 16;
+
+// Recursive calls reaching further back than this are not handled.
+static constexpr unsigned int kMaxRecursionDepth = 64;
+
+// How often to check for the user interrupting a long table fill.
+static constexpr size_t kInterruptCheckInterval = 1024;
+
+unsigned int	GetRecursionOffset( const ASTNode& inArg )
+{
+	unsigned int offset = 0;
+	const BinaryFuncNode* binNode = dynamic_cast<const BinaryFuncNode*>( &inArg );
+	
+	if ( (binNode != nullptr) and
+		((binNode->GetFunc() == Minus) or (binNode->GetFunc() == Plus)) )
+	{
+		const ParameterIndexNode* paramNode = dynamic_cast<const ParameterIndexNode*>(
+			inArg.Children()[0].get() );
+		const NumberNode* numNode = dynamic_cast<const NumberNode*>(
+			inArg.Children()[1].get() );
+		
+		if ( (paramNode != nullptr) and (paramNode->Index() == 0) and
+			(numNode != nullptr) )
+		{
+			double c = (binNode->GetFunc() == Minus)? numNode->Value() :
+				-numNode->Value();
+			if ( (c >= 1.0) and (c <= kMaxRecursionDepth) and (c == floor(c)) )
+			{
+				offset = static_cast<unsigned int>( c );
+			}
+		}
+	}
+	
+	return offset;
+}
+
+// Returns false if the tree contains a call that disqualifies the function.
+static bool FindRecursiveCalls( const std::string& inName,
+								const ASTNode& inTree,
+								unsigned int& ioMaxOffset )
+{
+	bool isOK = true;
+	
+	const UserFuncNode* callNode = dynamic_cast<const UserFuncNode*>( &inTree );
+	if (callNode != nullptr)
+	{
+		unsigned int offset = 0;
+		if ( (callNode->FuncName() == inName) and
+			(callNode->Children().size() == 1) )
+		{
+			offset = GetRecursionOffset( *callNode->Children()[0] );
+		}
+		
+		if (offset == 0)
+		{
+			isOK = false;
+		}
+		else
+		{
+			ioMaxOffset = std::max( ioMaxOffset, offset );
+		}
+	}
+	else if ( (dynamic_cast<const DerivativeNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const MinimizeNode*>( &inTree ) != nullptr) )
+	{
+		// The derivative or minimum would be computed outside the table.
+		isOK = false;
+	}
+	else
+	{
+		for (const autoASTNode& child : inTree.Children())
+		{
+			if (not FindRecursiveCalls( inName, *child, ioMaxOffset ))
+			{
+				isOK = false;
+				break;
+			}
+		}
+	}
+	
+	return isOK;
+}
+
+unsigned int	FindRecursionDepth( const std::string& inName,
+									const ASTNode& inBody )
+{
+	unsigned int maxOffset = 0;
+	
+	if (not FindRecursiveCalls( inName, inBody, maxOffset ))
+	{
+		maxOffset = 0;
+	}
+	
+	return maxOffset;
+}
+
+
+std::optional<double>	LookUpRecursionTable( double inArg, SCalcState& ioState )
+{
+	std::optional<double> result;
+	const RecursionTable* table = ioState.tableBeingFilled;
+	
+	if (table != nullptr)
+	{
+		double offset = inArg - table->start;
+		if ( (offset >= 0.0) and (offset < table->values.size()) )
+		{
+			result = table->values[ static_cast<size_t>( offset ) ];
+		}
+	}
+	
+	if (not result.has_value())
+	{
+		ioState.tableLookupFailed = true;
+	}
+	
+	return result;
+}
+
+// Evaluate the body at one argument, with recursive calls answered from the
+// table, which may be null.
+static std::optional<double> EvaluateStep( const CompiledFunc& inFunc,
+											const RecursionTable* inTable,
+											double inArg,
+											DoubleVec& ioArgs,
+											SCalcState& ioState )
+{
+	ioState.tableBeingFilled = inTable;
+	ioState.tableLookupFailed = false;
+	ioArgs[0] = inArg;
+	
+	std::optional<double> result( inFunc.body->Evaluate( ioState ) );
+	
+	if (ioState.tableLookupFailed)
+	{
+		result.reset();
+	}
+	
+	return result;
+}
+
+// Find a starting point for the table such that the function does not recurse
+// at the first maxOffset arguments.
+static std::optional<double> FindTableStart( const CompiledFunc& inFunc,
+											double inArg,
+											DoubleVec& ioArgs,
+											SCalcState& ioState )
+{
+	std::optional<double> result;
+	
+	for (double distance = 0.0; distance < kMaxTableSize;
+		distance = std::max( 1.0, 2.0 * distance ))
+	{
+		const double start = inArg - distance;
+		bool isBase = true;
+		
+		for (unsigned int i = 0; isBase and (i < inFunc.maxRecursionOffset); ++i)
+		{
+			isBase = EvaluateStep( inFunc, nullptr, start + i, ioArgs,
+				ioState ).has_value();
+		}
+		
+		if (isBase)
+		{
+			result = start;
+			break;
+		}
+		if (ioState.interruptCode != CalcInterruptCode::none)
+		{
+			break;
+		}
+	}
+	
+	return result;
+}
+
+std::optional<double>	EvaluateByRecursionTable( const std::string& inName,
+												const CompiledFunc& inFunc,
+												double inArg,
+												SCalcState& ioState )
+{
+	std::optional<double> result;
+	
+	if ( (ioState.tableFuncName != nullptr) or (not isfinite( inArg )) )
+	{
+		return result;
+	}
+	
+	DoubleVec args( 1, inArg );
+	ioState.functionArguments.swap( args );
+	ioState.tableFuncName = &inName;
+	
+	// Reuse an existing table if the argument lines up with it.
+	RecursionTable& table( ioState.recursionTables[ inName ] );
+	double offset = inArg - table.start;
+	if ( table.values.empty() or (offset < 0.0) or (offset != floor( offset )) )
+	{
+		table.values.clear();
+		std::optional<double> start( FindTableStart( inFunc, inArg,
+			ioState.functionArguments, ioState ) );
+		if (start.has_value())
+		{
+			table.start = *start;
+			offset = inArg - table.start;
+		}
+		else
+		{
+			offset = kMaxTableSize;
+		}
+	}
+	
+	if (offset < kMaxTableSize)
+	{
+		const size_t index = static_cast<size_t>( offset );
+		if (index >= table.values.size())
+		{
+			table.values.reserve( index + 1 );
+		}
+		
+		while (table.values.size() <= index)
+		{
+			std::optional<double> value( EvaluateStep( inFunc, &table,
+				table.start + table.values.size(), ioState.functionArguments,
+				ioState ) );
+			
+			if ( (not value.has_value()) or
+				( (table.values.size() % kInterruptCheckInterval == 0) and
+				(ioState.interruptCode != CalcInterruptCode::none) ) )
+			{
+				break;
+			}
+			table.values.push_back( *value );
+		}
+		
+		if (index < table.values.size())
+		{
+			result = table.values[ index ];
+		}
+	}
+	
+	ioState.tableFuncName = nullptr;
+	ioState.tableBeingFilled = nullptr;
+	ioState.functionArguments.swap( args );
+	
+	return result;
+}
+
+
+void	TrimRecursionTables( SCalcState& ioState )
+{
+	std::erase_if( ioState.recursionTables, []( const auto& inEntry )
+		{
+			return inEntry.second.values.size() > kMaxKeptTableSize;
+		} );
+}
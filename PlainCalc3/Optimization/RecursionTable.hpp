@@ -0,0 +1,127 @@
+//  RecursionTable.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef RecursionTable_hpp
+#define RecursionTable_hpp
+
+#import "ASTNode.hpp"
+
+#import <optional>
+#import <string>
+
+struct SCalcState;
+struct CompiledFunc;
+
+/*!
+	@function	GetRecursionOffset
+	
+	@abstract	Recognize the argument of a recursive call that steps down by
+				a constant.
+	
+	@param		inArg		Argument of a call within a function of one
+							parameter n.
+	@result		A positive integer c if inArg has the form n - c or n + (-c),
+				otherwise 0.
+*/
+unsigned int	GetRecursionOffset( const ASTNode& inArg );
+
+
+/*!
+	@function	FindRecursionDepth
+	
+	@abstract	Determine whether a function of one parameter can be evaluated
+				by filling a table from the bottom up.
+	
+	@discussion	This is possible if the only user function calls in the body
+				are calls of the function itself with arguments of the form
+				n - c, where n is the parameter and c is a positive integer.
+	
+	@param		inName		Name of the function.
+	@param		inBody		Compiled body of the function.
+	@result		The largest c, or 0 if the function does not qualify.
+*/
+unsigned int	FindRecursionDepth( const std::string& inName,
+									const ASTNode& inBody );
+
+
+/*!
+	@function	EvaluateByRecursionTable
+	
+	@abstract	Evaluate a function found suitable by FindRecursionDepth.
+	
+	@discussion	Rather than recursing from n downward, we look for a range of
+				arguments at or below n where the function does not recurse,
+				and then evaluate the body at each argument from there up to
+				n, looking up the values of recursive calls in a table.  The
+				table is kept in the state, so that later calls can reuse or
+				extend it.
+	
+	@param		inName		Name of the function.
+	@param		inFunc		The compiled function.
+	@param		inArg		Argument value.
+	@param		ioState		A calculator state.
+	@result		The function value, or nothing if this method of evaluation
+				did not work out, in which case the caller should evaluate
+				the function in the usual way.
+*/
+std::optional<double>	EvaluateByRecursionTable( const std::string& inName,
+												const CompiledFunc& inFunc,
+												double inArg,
+												SCalcState& ioState );
+
+
+/*!
+	@function	LookUpRecursionTable
+	
+	@abstract	Get the value of a recursive call while a table is being
+				filled by EvaluateByRecursionTable.
+	
+	@param		inArg		Argument value.
+	@param		ioState		A calculator state.
+	@result		The tabulated value, or nothing if the argument is not in the
+				table.  In the latter case, the tableLookupFailed member of the
+				state is set.
+*/
+std::optional<double>	LookUpRecursionTable( double inArg, SCalcState& ioState );
+
+
+/*!
+	@function	TrimRecursionTables
+	
+	@abstract	Discard the large recursion tables of a state.
+	
+	@discussion	Tables of up to 65536 values, which take 512 KB each, are kept
+				from one calculation to the next.  Larger ones are only worth
+				keeping for the calculation that made them.  This should be
+				called between calculations.
+	
+	@param		ioState		A calculator state.
+*/
+void	TrimRecursionTables( SCalcState& ioState );
+
+#endif /* RecursionTable_hpp */
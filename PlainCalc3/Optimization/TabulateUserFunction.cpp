@@ -0,0 +1,162 @@
+//  TabulateUserFunction.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "TabulateUserFunction.hpp"
+
+#import "ChebyshevApproximant.hpp"
+#import "CompileUserFunctions.hpp"
+#import "DerivativeNode.hpp"
+#import "MinimizeNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "SCalcState.hpp"
+#import "UserFuncNode.hpp"
+
+#import <utility>
+
+using DependencyMap = std::map< std::string, std::optional<FuncSource> >;
+
+static std::optional<FuncSource> CurrentSource( const std::string& inName,
+												const SCalcState& inState )
+{
+	std::optional<FuncSource> result;
+	
+	auto defIt = inState.userFunctions.find( inName );
+	if (defIt != inState.userFunctions.end())
+	{
+		result = FuncSource( std::get<StringVec>( defIt->second ),
+			std::get<std::string>( defIt->second ) );
+	}
+	
+	return result;
+}
+
+// Record the source of a function and of the functions it calls, directly
+// or indirectly.
+static void CollectDependencies( const std::string& inName,
+								const SCalcState& inState,
+								DependencyMap& ioDependencies );
+
+static void CollectCalledFunctions( const ASTNode& inTree,
+									const SCalcState& inState,
+									DependencyMap& ioDependencies )
+{
+	if (const UserFuncNode* callNode = dynamic_cast<const UserFuncNode*>( &inTree ))
+	{
+		CollectDependencies( callNode->FuncName(), inState, ioDependencies );
+	}
+	else if (const DerivativeNode* derivNode =
+		dynamic_cast<const DerivativeNode*>( &inTree ))
+	{
+		CollectDependencies( derivNode->FuncName(), inState, ioDependencies );
+	}
+	else if (const MinimizeNode* minNode =
+		dynamic_cast<const MinimizeNode*>( &inTree ))
+	{
+		CollectDependencies( minNode->FuncName(), inState, ioDependencies );
+	}
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		CollectCalledFunctions( *child, inState, ioDependencies );
+	}
+}
+
+static void CollectDependencies( const std::string& inName,
+								const SCalcState& inState,
+								DependencyMap& ioDependencies )
+{
+	if (not ioDependencies.contains( inName ))
+	{
+		ioDependencies[ inName ] = CurrentSource( inName, inState );
+		
+		auto defIt = inState.userFunctions.find( inName );
+		if (defIt != inState.userFunctions.end())
+		{
+			CollectCalledFunctions( *std::get<autoASTNode>( defIt->second ),
+				inState, ioDependencies );
+		}
+	}
+}
+
+std::optional<double>	TabulateUserFunction( const std::string& inName,
+											double inStart, double inEnd,
+											double inTolerance,
+											SCalcState& ioState )
+{
+	std::optional<double> result;
+	
+	// Approximate the function itself, not an old approximation of it.
+	ioState.tabulations.erase( inName );
+	
+	autoASTNode call( new UserFuncNode( inName,
+		ASTNodeVec{ autoASTNode( new ParameterIndexNode( 0 ) ) } ) );
+	std::vector<double> savedArguments( std::move( ioState.functionArguments ) );
+	
+	std::shared_ptr<const ChebyshevApproximant> approximant(
+		ChebyshevApproximant::Build(
+			[&ioState, &call]( double x ) -> std::optional<double>
+			{
+				ioState.functionArguments.assign( 1, x );
+				return call->Evaluate( ioState );
+			},
+			inStart, inEnd, inTolerance ) );
+	
+	ioState.functionArguments = std::move( savedArguments );
+	
+	if (approximant != nullptr)
+	{
+		Tabulation& tabulation( ioState.tabulations[ inName ] );
+		tabulation.approximant = approximant;
+		CollectDependencies( inName, ioState, tabulation.dependencies );
+		
+		// Callers compiled earlier may have the function inlined.
+		CompileUserFunctions( ioState );
+		result = approximant->ErrorBound();
+	}
+	
+	return result;
+}
+
+void	DiscardStaleTabulations( SCalcState& ioState )
+{
+	std::erase_if( ioState.tabulations,
+		[&ioState]( const auto& nameAndTabulation )
+		{
+			bool isStale = false;
+			for (const auto& [ name, source ] : nameAndTabulation.second.dependencies)
+			{
+				if (CurrentSource( name, ioState ) != source)
+				{
+					isStale = true;
+					break;
+				}
+			}
+			return isStale;
+		} );
+}
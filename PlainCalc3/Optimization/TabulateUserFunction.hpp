@@ -0,0 +1,76 @@
+//  TabulateUserFunction.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef TabulateUserFunction_hpp
+#define TabulateUserFunction_hpp
+
+#import <optional>
+#import <string>
+
+struct SCalcState;
+
+/*!
+	@function	TabulateUserFunction
+	
+	@abstract	Make a fast approximation of a user function of one variable
+				on an interval.
+	
+	@discussion	The function is approximated by a ChebyshevApproximant, which
+				is recorded in the tabulations member of the state.  From then
+				on, calls of the function with an argument in the interval are
+				evaluated by the approximant rather than by the body of the
+				function, until the function or a function that it calls is
+				redefined.  A previous approximation of the function is
+				replaced.
+	
+	@param		inName			Name of a user function with one parameter.
+	@param		inStart			Start of the interval.
+	@param		inEnd			End of the interval.
+	@param		inTolerance		Requested accuracy.
+	@param		ioState			A calculator state.
+	@result		An estimate of the largest error of the approximation, or
+				nothing if the function could not be approximated.
+*/
+std::optional<double>	TabulateUserFunction( const std::string& inName,
+											double inStart, double inEnd,
+											double inTolerance,
+											SCalcState& ioState );
+
+
+/*!
+	@function	DiscardStaleTabulations
+	
+	@abstract	Remove approximations of functions whose definitions, or the
+				definitions of functions that they call, have changed.
+	
+	@param		ioState			A calculator state.
+*/
+void	DiscardStaleTabulations( SCalcState& ioState );
+
+#endif /* TabulateUserFunction_hpp */
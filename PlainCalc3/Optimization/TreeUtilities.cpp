@@ -0,0 +1,273 @@
+//  TreeUtilities.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "TreeUtilities.hpp"
+
+#import "BinaryFuncNode.hpp"
+#import "DerivativeNode.hpp"
+#import "FusedIterationNode.hpp"
+#import "IndexVariableNode.hpp"
+#import "IntegralNode.hpp"
+#import "IterationNode.hpp"
+#import "MinimizeNode.hpp"
+#import "NaryFuncNode.hpp"
+#import "NumberNode.hpp"
+#import "ParameterIndexNode.hpp"
+#import "PolynomialNode.hpp"
+#import "SolveNode.hpp"
+#import "UnaryFuncNode.hpp"
+#import "UserFuncNode.hpp"
+
+#import <algorithm>
+#import <functional>
+#import <typeinfo>
+
+static void CountUses( const ASTNode& inTree, std::vector<unsigned int>& ioCounts )
+{
+	const ParameterIndexNode* paramNode =
+		dynamic_cast<const ParameterIndexNode*>( &inTree );
+	if ( (paramNode != nullptr) and (paramNode->Index() < ioCounts.size()) )
+	{
+		ioCounts[ paramNode->Index() ] += 1;
+	}
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		CountUses( *child, ioCounts );
+	}
+}
+
+std::vector<unsigned int>	CountParameterUses( const ASTNode& inTree,
+												size_t inParamCount )
+{
+	std::vector<unsigned int> counts( inParamCount, 0 );
+	
+	CountUses( inTree, counts );
+	
+	return counts;
+}
+
+
+autoASTNode	SubstituteParameters( const autoASTNode& inTree,
+								const ASTNodeVec& inArgs )
+{
+	autoASTNode result( inTree );
+	
+	const ParameterIndexNode* paramNode =
+		dynamic_cast<const ParameterIndexNode*>( inTree.get() );
+	if (paramNode != nullptr)
+	{
+		if (paramNode->Index() < inArgs.size())
+		{
+			result = inArgs[ paramNode->Index() ];
+		}
+	}
+	else if (not inTree->Children().empty())
+	{
+		ASTNodeVec newChildren;
+		newChildren.reserve( inTree->Children().size() );
+		bool didChange = false;
+		
+		for (const autoASTNode& child : inTree->Children())
+		{
+			newChildren.push_back( SubstituteParameters( child, inArgs ) );
+			didChange = didChange or (newChildren.back() != child);
+		}
+		
+		if (didChange)
+		{
+			result = inTree->CloneWithChildren( newChildren );
+		}
+	}
+	
+	return result;
+}
+
+
+static void CollectParameters( const ASTNode& inTree,
+								std::vector<unsigned int>& ioIndices )
+{
+	const ParameterIndexNode* paramNode =
+		dynamic_cast<const ParameterIndexNode*>( &inTree );
+	if (paramNode != nullptr)
+	{
+		ioIndices.push_back( paramNode->Index() );
+	}
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		CollectParameters( *child, ioIndices );
+	}
+}
+
+std::vector<unsigned int>	UsedParameters( const ASTNode& inTree )
+{
+	std::vector<unsigned int> indices;
+	
+	CollectParameters( inTree, indices );
+	std::sort( indices.begin(), indices.end() );
+	indices.erase( std::unique( indices.begin(), indices.end() ), indices.end() );
+	
+	return indices;
+}
+
+
+static size_t CombineHash( size_t inSeed, size_t inValue )
+{
+	return inSeed ^ (inValue + 0x9e3779b97f4a7c15ULL + (inSeed << 6) + (inSeed >> 2));
+}
+
+template <typename Func>
+static size_t HashFunction( Func inFunc )
+{
+	return std::hash<const void*>()( reinterpret_cast<const void*>( inFunc ) );
+}
+
+size_t	StructuralHash( const ASTNode& inTree )
+{
+	size_t hash = typeid( inTree ).hash_code();
+	
+	if (const NumberNode* node = dynamic_cast<const NumberNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<double>()( node->Value() ) );
+	}
+	else if (const ParameterIndexNode* node =
+		dynamic_cast<const ParameterIndexNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, node->Index() );
+	}
+	else if (const IndexVariableNode* node =
+		dynamic_cast<const IndexVariableNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->Name() ) );
+	}
+	else if (const UserFuncNode* node = dynamic_cast<const UserFuncNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->FuncName() ) );
+	}
+	else if (const DerivativeNode* node = dynamic_cast<const DerivativeNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->FuncName() ) );
+	}
+	else if (const MinimizeNode* node = dynamic_cast<const MinimizeNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->FuncName() ) );
+	}
+	else if (const UnaryFuncNode* node = dynamic_cast<const UnaryFuncNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, HashFunction( node->GetFunc() ) );
+	}
+	else if (const BinaryFuncNode* node = dynamic_cast<const BinaryFuncNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, HashFunction( node->GetFunc() ) );
+	}
+	else if (const NaryFuncNode* node = dynamic_cast<const NaryFuncNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, HashFunction( node->GetFunc() ) );
+	}
+	else if (const IterationNode* node = dynamic_cast<const IterationNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, static_cast<size_t>( node->Kind() ) );
+		hash = CombineHash( hash, std::hash<std::string>()( node->Variable() ) );
+	}
+	else if (const FusedIterationNode* node =
+		dynamic_cast<const FusedIterationNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, static_cast<size_t>( node->Kind() ) );
+		for (const std::string& variable : node->Variables())
+		{
+			hash = CombineHash( hash, std::hash<std::string>()( variable ) );
+		}
+	}
+	else if (const IntegralNode* node = dynamic_cast<const IntegralNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->Variable() ) );
+	}
+	else if (const SolveNode* node = dynamic_cast<const SolveNode*>( &inTree ))
+	{
+		hash = CombineHash( hash, std::hash<std::string>()( node->Variable() ) );
+	}
+	else if (const PolynomialNode* node = dynamic_cast<const PolynomialNode*>( &inTree ))
+	{
+		for (double coeff : node->Coefficients())
+		{
+			hash = CombineHash( hash, std::hash<double>()( coeff ) );
+		}
+	}
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		hash = CombineHash( hash, StructuralHash( *child ) );
+	}
+	
+	return hash;
+}
+
+
+bool	CallsUserFunctions( const ASTNode& inTree )
+{
+	return ContainsNodeOfType<UserFuncNode>( inTree ) or
+		ContainsNodeOfType<DerivativeNode>( inTree ) or
+		ContainsNodeOfType<MinimizeNode>( inTree );
+}
+
+
+bool	ContainsIteration( const ASTNode& inTree )
+{
+	return ContainsNodeOfType<IterationNode>( inTree ) or
+		ContainsNodeOfType<FusedIterationNode>( inTree ) or
+		ContainsNodeOfType<IntegralNode>( inTree ) or
+		ContainsNodeOfType<SolveNode>( inTree );
+}
+
+
+double	EstimateCost( const ASTNode& inTree )
+{
+	double childCost = 0.0;
+	for (const autoASTNode& child : inTree.Children())
+	{
+		childCost += EstimateCost( *child );
+	}
+	
+	double cost = 1.0 + childCost;
+	if ( (dynamic_cast<const UserFuncNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const DerivativeNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const MinimizeNode*>( &inTree ) != nullptr) )
+	{
+		cost += kUserCallCost;
+	}
+	else if ( (dynamic_cast<const IterationNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const FusedIterationNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const IntegralNode*>( &inTree ) != nullptr) or
+		(dynamic_cast<const SolveNode*>( &inTree ) != nullptr) )
+	{
+		cost = 1.0 + kIterationCostFactor * childCost;
+	}
+	
+	return cost;
+}
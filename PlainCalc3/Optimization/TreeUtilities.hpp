@@ -0,0 +1,163 @@
+//  TreeUtilities.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef TreeUtilities_hpp
+#define TreeUtilities_hpp
+
+#import "ASTNode.hpp"
+
+#import <vector>
+
+/*!
+	@function	ContainsNodeOfType
+	
+	@abstract	Determine whether a tree contains a node of a given class.
+	
+	@param		inTree		A syntax tree.
+	@result		True if inTree or one of its descendants is a NodeType.
+*/
+template <typename NodeType>
+bool	ContainsNodeOfType( const ASTNode& inTree )
+{
+	bool found = (dynamic_cast<const NodeType*>( &inTree ) != nullptr);
+	
+	for (const autoASTNode& child : inTree.Children())
+	{
+		if (found)
+		{
+			break;
+		}
+		found = ContainsNodeOfType<NodeType>( *child );
+	}
+	
+	return found;
+}
+
+
+/*!
+	@function	CountParameterUses
+	
+	@abstract	Count how many times each formal parameter appears in a function body.
+	
+	@param		inTree			Right hand side of a user function definition.
+	@param		inParamCount	Number of formal parameters of the function.
+	@result		A vector of inParamCount use counts.
+*/
+std::vector<unsigned int>	CountParameterUses( const ASTNode& inTree,
+												size_t inParamCount );
+
+
+/*!
+	@function	SubstituteParameters
+	
+	@abstract	Replace the formal parameters in a function body by argument trees.
+	
+	@discussion	Subtrees that do not involve any parameters are shared with the
+				original tree rather than copied.  A parameter whose index has
+				no corresponding argument is left alone.
+	
+	@param		inTree		Right hand side of a user function definition.
+	@param		inArgs		One syntax tree for each formal parameter.
+	@result		A tree in which each ParameterIndexNode has been replaced by the
+				corresponding argument.
+*/
+autoASTNode	SubstituteParameters( const autoASTNode& inTree,
+								const ASTNodeVec& inArgs );
+
+
+
+/*!
+	@function	UsedParameters
+	
+	@abstract	Find which formal parameters appear in a tree.
+	
+	@param		inTree		A syntax tree.
+	@result		The distinct parameter indices, in increasing order.
+*/
+std::vector<unsigned int>	UsedParameters( const ASTNode& inTree );
+
+
+/*!
+	@function	StructuralHash
+	
+	@abstract	Compute a hash value of a tree that is consistent with the
+				operator== of nodes.
+	
+	@param		inTree		A syntax tree.
+	@result		A hash value combining the kinds, data, and children of the
+				nodes.
+*/
+size_t	StructuralHash( const ASTNode& inTree );
+
+
+/*!
+	@function	CallsUserFunctions
+	
+	@abstract	Determine whether evaluating a tree may call a user function,
+				either directly or to compute a derivative or minimum.
+	
+	@param		inTree		A syntax tree.
+	@result		True if inTree contains a UserFuncNode, DerivativeNode, or
+				MinimizeNode.
+*/
+bool	CallsUserFunctions( const ASTNode& inTree );
+
+
+/*!
+	@function	ContainsIteration
+	
+	@abstract	Determine whether a tree contains a sum, product, integral,
+				or equation to solve.
+	
+	@param		inTree		A syntax tree.
+	@result		True if inTree contains an IterationNode, FusedIterationNode,
+				IntegralNode, or SolveNode.
+*/
+bool	ContainsIteration( const ASTNode& inTree );
+
+
+// Weights used by EstimateCost.
+constexpr double	kUserCallCost = 64.0;
+constexpr double	kIterationCostFactor = 64.0;
+
+/*!
+	@function	EstimateCost
+	
+	@abstract	Make a rough estimate of the work of evaluating a tree.
+	
+	@discussion	Each node costs 1, a call of a user function or a derivative
+				or minimum costs kUserCallCost more, since the body is not
+				known here, and what lies below a sum, product, integral,
+				or equation to solve is counted kIterationCostFactor times.
+	
+	@param		inTree		A syntax tree.
+	@result		An estimate in units of the work of one simple node.
+*/
+double	EstimateCost( const ASTNode& inTree );
+
+#endif /* TreeUtilities_hpp */
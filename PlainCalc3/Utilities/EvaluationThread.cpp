@@ -0,0 +1,125 @@
+//  EvaluationThread.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "EvaluationThread.hpp"
+
+#import "GetStackSize.hpp"
+
+EvaluationThread::EvaluationThread( size_t inStackSize )
+	: _isStarted( false )
+	, _stackSize( inStackSize )
+	, _job( nullptr )
+	, _jobFailure( nullptr )
+	, _isStopping( false )
+{
+	pthread_attr_t attr;
+	InitThreadStackAttributes( attr, _stackSize );
+	_isStarted = (0 == pthread_create( &_thread, &attr, ThreadEntry, this ));
+	pthread_attr_destroy( &attr );
+}
+
+EvaluationThread::~EvaluationThread()
+{
+	if (_isStarted)
+	{
+		{
+			std::lock_guard<std::mutex> guard( _lock );
+			_isStopping = true;
+		}
+		_condition.notify_all();
+		pthread_join( _thread, nullptr );
+	}
+}
+
+void*	EvaluationThread::ThreadEntry( void* inParam )
+{
+	static_cast<EvaluationThread*>( inParam )->RunLoop();
+	
+	return nullptr;
+}
+
+void	EvaluationThread::RunLoop()
+{
+	std::unique_lock<std::mutex> guard( _lock );
+	
+	while (true)
+	{
+		_condition.wait( guard, [this]() { return _isStopping or (_job != nullptr); } );
+		if (_isStopping)
+		{
+			break;
+		}
+		
+		guard.unlock();
+		SaveStackAddress();
+		
+		// An exception must not escape the thread, so it is passed to the
+		// thread waiting in Run.
+		try
+		{
+			(*_job)();
+		}
+		catch (...)
+		{
+			*_jobFailure = std::current_exception();
+		}
+		guard.lock();
+		
+		_job = nullptr;
+		_jobFailure = nullptr;
+		_condition.notify_all();
+	}
+}
+
+void	EvaluationThread::Run( const Job& inJob )
+{
+	if ( (not _isStarted) or pthread_equal( _thread, pthread_self() ) )
+	{
+		inJob();
+	}
+	else
+	{
+		std::exception_ptr failure;
+		{
+			std::unique_lock<std::mutex> guard( _lock );
+			
+			// Another thread may be waiting for its own job to finish.
+			_condition.wait( guard, [this]() { return _job == nullptr; } );
+			_job = &inJob;
+			_jobFailure = &failure;
+			_condition.notify_all();
+			_condition.wait( guard, [this, &inJob]() { return _job != &inJob; } );
+		}
+		
+		if (failure)
+		{
+			std::rethrow_exception( failure );
+		}
+	}
+}
@@ -0,0 +1,90 @@
+//  EvaluationThread.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef EvaluationThread_hpp
+#define EvaluationThread_hpp
+
+#import <condition_variable>
+#import <exception>
+#import <functional>
+#import <mutex>
+
+#import <pthread.h>
+
+/*!
+	@class		EvaluationThread
+	
+	@abstract	A thread with a stack of a chosen size, which runs jobs on
+				behalf of other threads.
+	
+	@discussion	The amount of recursion that a calculation can do is limited
+				by the stack of the thread doing it, which is often small for
+				threads other than the main thread.  An EvaluationThread lets
+				a caller do the work on a larger stack, while waiting as if
+				the work were done on the calling thread.
+				
+				The thread calls SaveStackAddress before each job.
+*/
+class EvaluationThread
+{
+public:
+	using Job = std::function< void() >;
+	
+	explicit			EvaluationThread( size_t inStackSize );
+						EvaluationThread( const EvaluationThread& ) = delete;
+						~EvaluationThread();
+	
+	size_t				StackSize() const noexcept { return _stackSize; }
+	
+	/*!
+		@function	Run
+		@abstract	Run a job on this thread, returning when it is done.
+		@discussion	If the thread could not be created, or if Run is called
+					from a job of this thread, the job runs on the calling
+					thread.  An exception thrown by the job is rethrown here,
+					on the calling thread.
+		@param		inJob		The job.
+	*/
+	void				Run( const Job& inJob );
+
+private:
+	static void*		ThreadEntry( void* inParam );
+	void				RunLoop();
+	
+	pthread_t				_thread;
+	bool					_isStarted;
+	size_t					_stackSize;
+	std::mutex				_lock;
+	std::condition_variable	_condition;
+	const Job*				_job;		// non-null while a job is pending
+	std::exception_ptr*		_jobFailure;	// receives an exception of the job
+	bool					_isStopping;
+};
+
+#endif /* EvaluationThread_hpp */
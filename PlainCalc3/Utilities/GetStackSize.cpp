@@ -28,7 +28,22 @@
 
 #import "GetStackSize.hpp"
 
-static char* stackAtStart;
+#import <unistd.h>
+
+// Used if we can not find the bounds of the stack.
+static constexpr size_t kDefaultStackLimit = 1048576U; // 1 megabyte
+
+// Stack that is not counted as usable by GetStackLimit, to allow for the
+// frames between successive checks of the stack size, and for library code.
+static constexpr size_t kStackReserve = 256U * 1024U;
+
+// Size of the inaccessible region at the end of the stacks of threads we
+// create.  A single page would not catch a large frame that jumps over it.
+static constexpr size_t kStackGuardSize = 64U * 1024U;
+
+// Each thread that evaluates recursive functions has its own stack.
+static thread_local char* stackAtStart;
+static thread_local size_t stackLimit = kDefaultStackLimit;
 
 static void save_stack_pointer( char dumb )
 {
@@ -40,6 +55,33 @@ static size_t get_stack_size( char dumb )
     return stackAtStart - &dumb;
 }
 
+// Find the lowest address of the stack of the current thread.  Stacks grow
+// downward on all the platforms we support.
+static char* FindStackBottom()
+{
+	char* bottom = nullptr;
+	
+#if __APPLE__
+	pthread_t thread = pthread_self();
+	char* top = static_cast<char*>( pthread_get_stackaddr_np( thread ) );
+	bottom = top - pthread_get_stacksize_np( thread );
+#else
+	pthread_attr_t attr;
+	if (0 == pthread_getattr_np( pthread_self(), &attr ))
+	{
+		void* stackAddr = nullptr;
+		size_t stackSize = 0;
+		if (0 == pthread_attr_getstack( &attr, &stackAddr, &stackSize ))
+		{
+			bottom = static_cast<char*>( stackAddr );
+		}
+		pthread_attr_destroy( &attr );
+	}
+#endif
+	
+	return bottom;
+}
+
 
 /*!
 	@function	SaveStackAddress
@@ -49,6 +91,15 @@ static size_t get_stack_size( char dumb )
 void	SaveStackAddress()
 {
 	save_stack_pointer( 'A' );
+	
+	stackLimit = kDefaultStackLimit;
+	char* bottom = FindStackBottom();
+	if ( (bottom != nullptr) and (bottom < stackAtStart) )
+	{
+		const size_t available = stackAtStart - bottom;
+		stackLimit = (available > 2 * kStackReserve)?
+			available - kStackReserve : available / 2;
+	}
 }
 
 
@@ -63,3 +114,34 @@ size_t		GetStackSize()
 {
 	return get_stack_size('B');
 }
+
+
+/*!
+	@function	GetStackLimit
+	
+	@abstract	Get the largest value of GetStackSize that can safely be reached
+				on the current thread.
+	
+	@result		Stack size in bytes.
+*/
+size_t		GetStackLimit()
+{
+	return stackLimit;
+}
+
+
+/*!
+	@function	InitThreadStackAttributes
+	
+	@abstract	Initialize attributes for creating a thread with a given stack
+				size.
+*/
+void		InitThreadStackAttributes( pthread_attr_t& outAttr, size_t inStackSize )
+{
+	const size_t pageSize = static_cast<size_t>( sysconf( _SC_PAGESIZE ) );
+	const size_t roundedSize = (inStackSize + pageSize - 1) / pageSize * pageSize;
+	
+	pthread_attr_init( &outAttr );
+	pthread_attr_setstacksize( &outAttr, roundedSize );
+	pthread_attr_setguardsize( &outAttr, kStackGuardSize );
+}
@@ -30,11 +30,16 @@
 #define GetStackSize_hpp
 
 #import <stdlib.h>
+#import <pthread.h>
 
 /*!
 	@function	SaveStackAddress
 	
 	@abstract	Call this once before starting something involving recursion.
+	
+	@discussion	This also looks up the bounds of the stack of the current
+				thread, for use by GetStackLimit.  The information is kept
+				separately for each thread.
 */
 void	SaveStackAddress();
 
@@ -44,9 +49,41 @@ void	SaveStackAddress();
 	
 	@abstract	Get the current size of the stack.
 	
-	@result		Stack size in bytes.
+	@result		Stack size in bytes, measured from the point where
+				SaveStackAddress was called on this thread.
 */
 size_t		GetStackSize();
 
 
+/*!
+	@function	GetStackLimit
+	
+	@abstract	Get the largest value of GetStackSize that can safely be reached
+				on the current thread.
+	
+	@discussion	This is the space between the point where SaveStackAddress was
+				called and the end of the stack of the thread, less a reserve
+				for the work done between checks of GetStackSize.  If the bounds
+				of the stack could not be determined, a conservative default is
+				returned.
+	
+	@result		Stack size in bytes.
+*/
+size_t		GetStackLimit();
+
+
+/*!
+	@function	InitThreadStackAttributes
+	
+	@abstract	Initialize attributes for creating a thread with a given stack
+				size, with a guard region beyond the end of the stack so that an
+				overflow faults rather than corrupting other memory.
+	
+	@param		outAttr			Attributes to initialize.  The caller should
+								destroy them with pthread_attr_destroy.
+	@param		inStackSize		Requested stack size in bytes.
+*/
+void		InitThreadStackAttributes( pthread_attr_t& outAttr, size_t inStackSize );
+
+
 #endif /* GetStackSize_hpp */
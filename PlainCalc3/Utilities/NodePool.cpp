@@ -0,0 +1,113 @@
+//  NodePool.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "NodePool.hpp"
+
+#import <new>
+
+namespace
+{
+	// Blocks are grouped into size classes in multiples of kGranule bytes.
+	// Blocks larger than the biggest class go straight to operator new.
+	constexpr size_t kGranule = 16;
+	constexpr size_t kClassCount = 16;
+	
+	struct FreeBlock
+	{
+		FreeBlock*	next;
+	};
+	
+	struct NodeBlockPool
+	{
+					~NodeBlockPool();
+		
+		FreeBlock*	freeLists[ kClassCount ] = {};
+	};
+	
+	NodeBlockPool::~NodeBlockPool()
+	{
+		for (FreeBlock*& listHead : freeLists)
+		{
+			while (listHead != nullptr)
+			{
+				FreeBlock* doomed = listHead;
+				listHead = listHead->next;
+				::operator delete( doomed );
+			}
+		}
+	}
+	
+	thread_local NodeBlockPool sPool;
+}
+
+static size_t SizeClass( size_t inSize )
+{
+	return (inSize + kGranule - 1) / kGranule - 1;
+}
+
+void*	AllocateNodeBlock( size_t inSize )
+{
+	void* result = nullptr;
+	size_t sizeClass = SizeClass( inSize );
+	
+	if (sizeClass < kClassCount)
+	{
+		FreeBlock*& listHead( sPool.freeLists[ sizeClass ] );
+		if (listHead != nullptr)
+		{
+			result = listHead;
+			listHead = listHead->next;
+		}
+		else
+		{
+			result = ::operator new( (sizeClass + 1) * kGranule );
+		}
+	}
+	else
+	{
+		result = ::operator new( inSize );
+	}
+	
+	return result;
+}
+
+void	ReleaseNodeBlock( void* inBlock, size_t inSize ) noexcept
+{
+	size_t sizeClass = SizeClass( inSize );
+	
+	if (sizeClass < kClassCount)
+	{
+		FreeBlock* freed = static_cast<FreeBlock*>( inBlock );
+		freed->next = sPool.freeLists[ sizeClass ];
+		sPool.freeLists[ sizeClass ] = freed;
+	}
+	else
+	{
+		::operator delete( inBlock );
+	}
+}
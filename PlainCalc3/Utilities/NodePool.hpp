@@ -0,0 +1,97 @@
+//  NodePool.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef NodePool_hpp
+#define NodePool_hpp
+
+#import <stddef.h>
+
+/*!
+	@function	AllocateNodeBlock
+	
+	@abstract	Get a block of memory for a syntax tree node.
+	
+	@discussion	Small blocks are taken from a per-thread free list when one is
+				available, so that once a calculation has warmed up the pool,
+				creating and destroying nodes does not go through malloc.
+	
+	@param		inSize		Size of the block in bytes.
+	@result		A block of memory, suitably aligned for any node type.
+*/
+void*	AllocateNodeBlock( size_t inSize );
+
+/*!
+	@function	ReleaseNodeBlock
+	
+	@abstract	Return a block obtained from AllocateNodeBlock.
+	
+	@discussion	Small blocks go onto the free list of the current thread rather
+				than being returned to the system.
+	
+	@param		inBlock		A block obtained from AllocateNodeBlock.
+	@param		inSize		The size that was passed to AllocateNodeBlock.
+*/
+void	ReleaseNodeBlock( void* inBlock, size_t inSize ) noexcept;
+
+
+/*!
+	@struct		NodePoolAllocator
+	
+	@abstract	Standard allocator that uses AllocateNodeBlock and ReleaseNodeBlock.
+	
+	@discussion	This is meant to be used with std::allocate_shared, so that a
+				node and its shared_ptr control block share one pooled block.
+*/
+template <typename T>
+struct NodePoolAllocator
+{
+	using value_type = T;
+	
+	NodePoolAllocator() noexcept = default;
+	
+	template <typename U>
+	NodePoolAllocator( const NodePoolAllocator<U>& ) noexcept {}
+	
+	T*		allocate( size_t n )
+			{
+				return static_cast<T*>( AllocateNodeBlock( n * sizeof(T) ) );
+			}
+	
+	void	deallocate( T* p, size_t n ) noexcept
+			{
+				ReleaseNodeBlock( p, n * sizeof(T) );
+			}
+	
+	template <typename U>
+	bool	operator==( const NodePoolAllocator<U>& ) const noexcept
+			{
+				return true;
+			}
+};
+
+#endif /* NodePool_hpp */
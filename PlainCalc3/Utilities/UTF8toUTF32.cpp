@@ -34,16 +34,25 @@
 std::u32string UTF8toUTF32( const std::string& inStr )
 {
 	std::u32string result;
+	
+	UTF8toUTF32( inStr, result );
+		
+	return result;
+}
+
+void UTF8toUTF32( const std::string& inStr, std::u32string& outStr )
+{
+	outStr.clear();
 
 	// If every code point is less than or equal to 0x7F, then we can do it
 	// the easy way.
 	if (std::all_of( inStr.cbegin(), inStr.cend(),
 		[](char codept){ return static_cast<unsigned char>(codept) <= 0x7F; } ))
 	{
-		result.reserve( inStr.size() );
+		outStr.reserve( inStr.size() );
 		for (char codept : inStr)
 		{
-			result += static_cast<char32_t>( codept );
+			outStr += static_cast<char32_t>( codept );
 		}
 	}
 	else
@@ -52,21 +61,19 @@ std::u32string UTF8toUTF32( const std::string& inStr )
 			kCFStringEncodingUTF8 );
 		if (strCF != nullptr)
 		{
-			result.resize( inStr.size() );
+			outStr.resize( inStr.size() );
 			auto fullRange = CFRangeMake( 0, CFStringGetLength(strCF) );
 			CFIndex bytesInBuffer = 0;
 			CFStringGetBytes( strCF, fullRange,
-				kCFStringEncodingUTF32LE, '?', false, (UInt8*) result.data(),
-				result.size() * sizeof(char32_t), &bytesInBuffer );
+				kCFStringEncodingUTF32LE, '?', false, (UInt8*) outStr.data(),
+				outStr.size() * sizeof(char32_t), &bytesInBuffer );
 
 			// Probably bytesInBuffer is a multiple of 4, but just to be safe...
 			size_t codeCount = (bytesInBuffer + sizeof(char32_t) - 1) /
 				sizeof(char32_t);
-			result.resize( codeCount );
+			outStr.resize( codeCount );
 			
 			CFRelease( strCF );
 		}
 	}
-		
-	return result;
 }
@@ -33,5 +33,8 @@
 
 std::u32string UTF8toUTF32( const std::string& inStr );
 
+/// Convert UTF-8 to UTF-32 in an existing string, reusing its storage.
+void UTF8toUTF32( const std::string& inStr, std::u32string& outStr );
+
 
 #endif /* UTF8toUTF32_hpp */
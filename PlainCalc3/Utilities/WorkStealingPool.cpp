@@ -0,0 +1,274 @@
+//  WorkStealingPool.cpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "WorkStealingPool.hpp"
+
+#import "GetStackSize.hpp"
+
+namespace
+{
+	struct ThreadStartInfo
+	{
+		WorkStealingPool*	pool;
+		unsigned int		index;
+	};
+}
+
+static thread_local const WorkStealingPool*	sCurrentPool = nullptr;
+static thread_local unsigned int			sCurrentIndex = 0;
+
+WorkStealingPool::WorkStealingPool( unsigned int inThreadCount,
+									size_t inStackSize )
+	: _nextQueue( 0 )
+	, _queuedCount( 0 )
+	, _isStopping( false )
+	, _stackSize( inStackSize )
+{
+	for (unsigned int i = 0; i < inThreadCount; ++i)
+	{
+		_workers.push_back( std::make_unique<Worker>() );
+	}
+	
+	pthread_attr_t attr;
+	InitThreadStackAttributes( attr, _stackSize );
+	
+	for (unsigned int i = 0; i < inThreadCount; ++i)
+	{
+		pthread_t thread;
+		if (0 == pthread_create( &thread, &attr, ThreadEntry,
+			new ThreadStartInfo{ this, i } ))
+		{
+			_threads.push_back( thread );
+		}
+	}
+	
+	pthread_attr_destroy( &attr );
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> guard( _idleLock );
+		_isStopping = true;
+	}
+	_idleCondition.notify_all();
+	
+	for (pthread_t thread : _threads)
+	{
+		pthread_join( thread, nullptr );
+	}
+}
+
+void*	WorkStealingPool::ThreadEntry( void* inParam )
+{
+	std::unique_ptr<ThreadStartInfo> info(
+		static_cast<ThreadStartInfo*>( inParam ) );
+	
+	SaveStackAddress();
+	info->pool->RunWorker( info->index );
+	
+	return nullptr;
+}
+
+void	WorkStealingPool::RunWorker( unsigned int inIndex )
+{
+	sCurrentPool = this;
+	sCurrentIndex = inIndex;
+	
+	for (;;)
+	{
+		autoTask task( TakeTask( inIndex ) );
+		if (task)
+		{
+			RunTask( task );
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock( _idleLock );
+			_idleCondition.wait( lock, [this]()
+				{
+					return _isStopping or (_queuedCount > 0);
+				} );
+			if (_isStopping)
+			{
+				break;
+			}
+		}
+	}
+	
+	sCurrentPool = nullptr;
+}
+
+std::optional<unsigned int>	WorkStealingPool::WorkerIndex() const noexcept
+{
+	std::optional<unsigned int> result;
+	
+	if (sCurrentPool == this)
+	{
+		result = sCurrentIndex;
+	}
+	
+	return result;
+}
+
+WorkStealingPool::autoTask	WorkStealingPool::Spawn( Job inJob )
+{
+	autoTask task( std::make_shared<Task>() );
+	task->job = std::move( inJob );
+	
+	if (_workers.empty())
+	{
+		RunTask( task );
+	}
+	else
+	{
+		// A worker queues new work for itself; other threads spread it around.
+		std::optional<unsigned int> myIndex( WorkerIndex() );
+		unsigned int queueIndex = myIndex.has_value()? *myIndex :
+			(_nextQueue++ % ThreadCount());
+		
+		{
+			std::lock_guard<std::mutex> guard( _workers[ queueIndex ]->lock );
+			_workers[ queueIndex ]->tasks.push_back( task );
+		}
+		
+		{
+			std::lock_guard<std::mutex> guard( _idleLock );
+			_queuedCount += 1;
+		}
+		_idleCondition.notify_one();
+	}
+	
+	return task;
+}
+
+WorkStealingPool::autoTask	WorkStealingPool::TakeTask( std::optional<unsigned int> inIndex )
+{
+	autoTask task;
+	
+	if (_queuedCount > 0)
+	{
+		// Newest task from our own queue.
+		if (inIndex.has_value())
+		{
+			Worker& mine( *_workers[ *inIndex ] );
+			std::lock_guard<std::mutex> guard( mine.lock );
+			if (not mine.tasks.empty())
+			{
+				task = mine.tasks.back();
+				mine.tasks.pop_back();
+			}
+		}
+		
+		// Oldest task from someone else's queue.
+		const unsigned int threadCount = ThreadCount();
+		const unsigned int start = inIndex.has_value()? *inIndex + 1 : 0;
+		for (unsigned int i = 0; (not task) and (i < threadCount); ++i)
+		{
+			Worker& victim( *_workers[ (start + i) % threadCount ] );
+			std::lock_guard<std::mutex> guard( victim.lock );
+			if (not victim.tasks.empty())
+			{
+				task = victim.tasks.front();
+				victim.tasks.pop_front();
+			}
+		}
+		
+		if (task)
+		{
+			_queuedCount -= 1;
+		}
+	}
+	
+	return task;
+}
+
+void	WorkStealingPool::RunTask( const autoTask& inTask )
+{
+	try
+	{
+		inTask->job();
+	}
+	catch (...)
+	{
+		inTask->exception = std::current_exception();
+	}
+	
+	inTask->isDone.store( true, std::memory_order_release );
+	inTask->isDone.notify_all();
+}
+
+void	WorkStealingPool::Wait( const autoTask& inTask )
+{
+	std::optional<unsigned int> myIndex( WorkerIndex() );
+	
+	while (not inTask->isDone.load( std::memory_order_acquire ))
+	{
+		autoTask other( TakeTask( myIndex ) );
+		if (other)
+		{
+			RunTask( other );
+		}
+		else
+		{
+			// Nothing is queued, so the task is running on another thread,
+			// which will run any tasks that it spawns itself if need be.
+			inTask->isDone.wait( false, std::memory_order_acquire );
+		}
+	}
+	
+	if (inTask->exception)
+	{
+		std::rethrow_exception( inTask->exception );
+	}
+}
+
+void	WorkStealingPool::WaitAll( const std::vector< autoTask >& inTasks )
+{
+	std::exception_ptr firstException;
+	
+	for (const autoTask& task : inTasks)
+	{
+		try
+		{
+			Wait( task );
+		}
+		catch (...)
+		{
+			if (not firstException)
+			{
+				firstException = std::current_exception();
+			}
+		}
+	}
+	
+	if (firstException)
+	{
+		std::rethrow_exception( firstException );
+	}
+}
@@ -0,0 +1,144 @@
+//  WorkStealingPool.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WorkStealingPool_hpp
+#define WorkStealingPool_hpp
+
+#import <atomic>
+#import <condition_variable>
+#import <deque>
+#import <exception>
+#import <functional>
+#import <memory>
+#import <mutex>
+#import <optional>
+#import <vector>
+
+#import <pthread.h>
+
+/*!
+	@class		WorkStealingPool
+	
+	@abstract	A fixed set of worker threads that run tasks for fork-join
+				parallelism.
+	
+	@discussion	Each worker has its own queue of tasks.  A worker takes the
+				most recently spawned task from its own queue, and when that
+				is empty, steals the oldest task from another queue.
+				
+				A thread that waits for a task to finish runs other tasks in
+				the meantime, so that waiting inside a task can not deadlock
+				the pool.  When there are none, it blocks until the task is
+				done.  An exception thrown by a task is rethrown to the
+				thread that waits for it.
+				
+				Each worker thread calls SaveStackAddress when it starts, so
+				that GetStackSize works in tasks.
+*/
+class WorkStealingPool
+{
+public:
+	using Job = std::function< void() >;
+	
+	struct Task
+	{
+		Job					job;
+		std::exception_ptr	exception;	// set before isDone
+		std::atomic<bool>	isDone{ false };
+	};
+	using autoTask = std::shared_ptr< Task >;
+	
+						WorkStealingPool( unsigned int inThreadCount,
+										size_t inStackSize );
+						WorkStealingPool( const WorkStealingPool& ) = delete;
+						~WorkStealingPool();
+	
+	unsigned int		ThreadCount() const noexcept
+						{
+							return static_cast<unsigned int>( _workers.size() );
+						}
+	
+	/*!
+		@function	WorkerIndex
+		@abstract	Find out whether the calling thread is one of our workers.
+		@result		An index less than ThreadCount(), or nothing if the calling
+					thread does not belong to this pool.
+	*/
+	std::optional<unsigned int>	WorkerIndex() const noexcept;
+	
+	/*!
+		@function	Spawn
+		@abstract	Queue a job to be run by some thread.
+		@param		inJob		The job.
+		@result		A task object that can be passed to Wait.
+	*/
+	autoTask			Spawn( Job inJob );
+	
+	/*!
+		@function	Wait
+		@abstract	Return when a spawned task is done, running other tasks
+					meanwhile.
+		@discussion	If the task ended by throwing an exception, the exception
+					is rethrown.
+		@param		inTask		A task returned by Spawn.
+	*/
+	void				Wait( const autoTask& inTask );
+	
+	/*!
+		@function	WaitAll
+		@abstract	Return when all of several spawned tasks are done.
+		@discussion	Even if a task ended by throwing an exception, this waits
+					for the others, since they may refer to data owned by the
+					caller.  Then the first such exception is rethrown.
+		@param		inTasks		Tasks returned by Spawn.
+	*/
+	void				WaitAll( const std::vector< autoTask >& inTasks );
+
+private:
+	struct Worker
+	{
+		std::mutex				lock;
+		std::deque< autoTask >	tasks;
+	};
+	
+	static void*		ThreadEntry( void* inParam );
+	void				RunWorker( unsigned int inIndex );
+	autoTask			TakeTask( std::optional<unsigned int> inIndex );
+	static void			RunTask( const autoTask& inTask );
+	
+	std::vector< std::unique_ptr<Worker> >	_workers;
+	std::vector< pthread_t >				_threads;
+	std::atomic<unsigned int>				_nextQueue;
+	std::atomic<size_t>						_queuedCount;
+	std::mutex								_idleLock;
+	std::condition_variable					_idleCondition;
+	bool									_isStopping;
+	size_t									_stackSize;
+};
+
+#endif /* WorkStealingPool_hpp */
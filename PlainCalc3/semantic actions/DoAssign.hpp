@@ -30,6 +30,7 @@
 #define DoAssign_h
 
 #import "SCalcState.hpp"
+#import "CompileUserFunctions.hpp"
 
 struct DoAssign
 {
@@ -41,7 +42,10 @@ inline void	DoAssign::operator()( auto& ctx ) const
 	SCalcState& state( _globals(ctx) );
 	
 	// if a user-defined function has the name of leftIdentifier, erase it.
-	state.userFunctions.erase( state.leftIdentifier );
+	if (state.userFunctions.erase( state.leftIdentifier ) > 0)
+	{
+		CompileUserFunctions( state );
+	}
 	
 	autoASTNode topNode( state.valStack.top() );
 	std::optional<double> topValue = topNode->Evaluate( state );
@@ -59,13 +59,13 @@ struct DoBinaryOperator
 				autoASTNode lhs( state.valStack.top() );
 				state.valStack.pop();
 				
-				std::optional<double> leftVal( lhs->Evaluate( state ) );
-				std::optional<double> rightVal( rhs->Evaluate( state ) );
+				std::optional<double> leftVal( state.FoldedValue( *lhs ) );
+				std::optional<double> rightVal( state.FoldedValue( *rhs ) );
 				
 				if ( leftVal.has_value() and rightVal.has_value() )
 				{
 					double resultNum = _func( leftVal.value(), rightVal.value() );
-					state.valStack.push( autoASTNode( new NumberNode( resultNum ) ) );
+					state.valStack.push( MakeNode<NumberNode>( resultNum ) );
 				}
 				else
 				{
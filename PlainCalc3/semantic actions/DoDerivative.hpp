@@ -0,0 +1,106 @@
+//  DoDerivative.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef DoDerivative_h
+#define DoDerivative_h
+
+#import "DerivativeNode.hpp"
+#import "MatchedText.hpp"
+#import "NumberNode.hpp"
+#import "SCalcState.hpp"
+
+/// Check that the identifier is the name of a user function of one variable,
+/// and push it on the function name stack.
+struct DoGetDerivativeFunc
+{
+	void	operator()( auto& ctx ) const;
+};
+
+/// Replace the argument on the value stack by the derivative of the function
+/// at that argument.
+struct DoDerivative
+{
+	void	operator()( auto& ctx ) const;
+};
+
+inline void	DoGetDerivativeFunc::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	std::string theIdentifier( MatchedText( ctx ) );
+	
+	auto defIt = state.userFunctions.find( theIdentifier );
+	if ( (defIt == state.userFunctions.end()) or
+		(std::get<StringVec>( defIt->second ).size() != 1) )
+	{
+		_report_error( ctx, "'" + theIdentifier + "' is not a user function "
+			"of one variable" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.funcNameStack.push( theIdentifier );
+}
+
+inline void	DoDerivative::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	
+	if ( state.funcNameStack.empty() or state.valStack.empty() )
+	{
+		_report_error( ctx, "stack underrun" );
+		_pass( ctx ) = false;
+		return;
+	}
+	std::string funcName( state.funcNameStack.top() );
+	state.funcNameStack.pop();
+	autoASTNode argument( state.valStack.top() );
+	state.valStack.pop();
+	
+	autoASTNode derivNode( new DerivativeNode( funcName, argument ) );
+	
+	if (state.suppressUserFuncEvaluation == 0)
+	{
+		std::optional<double> result = derivNode->Evaluate( state );
+		
+		if (result.has_value())
+		{
+			state.valStack.push( MakeNode<NumberNode>( result.value() ) );
+		}
+		else
+		{
+			state.valStack.push( std::move( derivNode ) );
+		}
+	}
+	else
+	{
+		state.valStack.push( std::move( derivNode ) );
+	}
+}
+
+#endif /* DoDerivative_h */
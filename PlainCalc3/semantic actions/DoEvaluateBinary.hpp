@@ -60,13 +60,13 @@ inline void	DoEvaluateBinary::operator()( auto& ctx ) const
 	autoASTNode param1Node( state.valStack.top() );
 	state.valStack.pop();
 	
-	std::optional<double> param1Value = param1Node->Evaluate( state );
-	std::optional<double> param2Value = param2Node->Evaluate( state );
+	std::optional<double> param1Value = state.FoldedValue( *param1Node );
+	std::optional<double> param2Value = state.FoldedValue( *param2Node );
 	
 	if ( param1Value.has_value() and param2Value.has_value() )
 	{
 		double resultNum = theFunc( param1Value.value(), param2Value.value() );
-		state.valStack.push( autoASTNode( new NumberNode( resultNum ) ) );
+		state.valStack.push( MakeNode<NumberNode>( resultNum ) );
 	}
 	else
 	{
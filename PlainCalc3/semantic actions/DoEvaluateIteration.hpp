@@ -30,14 +30,28 @@
 #define DoEvaluateIteration_h
 
 #import "Built-ins.hpp"
+#import "CompileUserFunctions.hpp"
+#import "IntegralNode.hpp"
 #import "IterationNode.hpp"
 #import "SCalcState.hpp"
+#import "SolveNode.hpp"
 
 struct DoEvaluateIteration
 {
 	void	operator()( auto& ctx ) const;
 };
 
+struct DoIterationTolerance
+{
+	void	operator()( auto& ctx ) const;
+};
+
+inline void	DoIterationTolerance::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	state.iterationHasTolerance = true;
+}
+
 inline void	DoEvaluateIteration::operator()( auto& ctx ) const
 {
 	SCalcState& state( _globals(ctx) );
@@ -70,13 +84,22 @@ inline void	DoEvaluateIteration::operator()( auto& ctx ) const
 		return;
 	}
 	
-	// Get the 3 arguments
-	if (state.valStack.size() < 3)
+	// Get the 3 or 4 arguments
+	const bool hasTolerance = state.iterationHasTolerance;
+	state.iterationHasTolerance = false;
+	if (state.valStack.size() < (hasTolerance? 4 : 3))
 	{
 		_report_error( ctx, "value stack underrun" );
 		_pass( ctx ) = false;
 		return;
 	}
+	autoASTNode toleranceNode;
+	if (hasTolerance)
+	{
+		toleranceNode = state.valStack.top();
+		state.valStack.pop();
+	}
+	
 	autoASTNode contentNode( state.valStack.top() );
 	state.valStack.pop();
 	
@@ -86,9 +109,33 @@ inline void	DoEvaluateIteration::operator()( auto& ctx ) const
 	autoASTNode startValueNode( state.valStack.top() );
 	state.valStack.pop();
 	
-	// Make an iteration node
-	state.valStack.push( autoASTNode( new IterationNode( *kindVal,
-		indexVariable, startValueNode, endValueNode, contentNode ) ) );
+	// Make an iteration node, or an integral or solution
+	autoASTNode iterationNode;
+	if (*kindVal == IterationKind::integration)
+	{
+		iterationNode = autoASTNode( new IntegralNode( indexVariable,
+			startValueNode, endValueNode, contentNode, toleranceNode ) );
+	}
+	else if (*kindVal == IterationKind::rootFinding)
+	{
+		iterationNode = autoASTNode( new SolveNode( indexVariable,
+			startValueNode, endValueNode, contentNode, toleranceNode ) );
+	}
+	else
+	{
+		iterationNode = autoASTNode( new IterationNode( *kindVal,
+			indexVariable, startValueNode, endValueNode, contentNode,
+			toleranceNode ) );
+	}
+	
+	// The content will be evaluated repeatedly, so it is worth optimizing,
+	// and nested iterations may be fused.  Within a function definition,
+	// that happens when the function is compiled.
+	if (state.suppressUserFuncEvaluation == 0)
+	{
+		iterationNode = OptimizeExpression( iterationNode, state );
+	}
+	state.valStack.push( iterationNode );
 }
 
 #endif /* DoEvaluateIteration_h */
@@ -33,6 +33,7 @@
 #import "SCalcState.hpp"
 #import "NumberNode.hpp"
 #import "NaryFuncNode.hpp"
+#import <algorithm>
 #import <math.h>
 
 struct DoEvaluateNary
@@ -40,6 +41,13 @@ struct DoEvaluateNary
 	void	operator()( auto& ctx ) const;
 };
 
+/// Apply an n-ary function to a list of literal numbers, pushing the result.
+/// The attribute is the function followed by the vector of numbers.
+struct DoEvaluateNaryLiterals
+{
+	void	operator()( auto& ctx ) const;
+};
+
 inline void	DoEvaluateNary::operator()( auto& ctx ) const
 {
 	SCalcState& state( _globals(ctx) );
@@ -59,9 +67,9 @@ inline void	DoEvaluateNary::operator()( auto& ctx ) const
 	
 	NaryFunc theFunc = BuiltInNarySyms().at( funcName );
 	
-	// Pop the function arguments and put them into a vector.
-	// This operation will reverse the order of the arguments, but none of
-	// my n-ary functions care about the order of their arguments.
+	// Pop the function arguments and put them into a vector.  Popping
+	// reverses their order, which matters for functions such as quantile
+	// whose first argument is special, so undo that.
 	std::vector< autoASTNode > args;
 	args.reserve( attCount );
 	while (attCount > 0)
@@ -71,13 +79,14 @@ inline void	DoEvaluateNary::operator()( auto& ctx ) const
 		args.push_back( oneArg );
 		--attCount;
 	}
+	std::reverse( args.begin(), args.end() );
 	
 	autoASTNode funcNode( new NaryFuncNode( theFunc, args ) );
 	
-	std::optional<double> theValue = funcNode->Evaluate( state );
+	std::optional<double> theValue = state.FoldedValue( *funcNode );
 	if (theValue.has_value())
 	{
-		state.valStack.push( autoASTNode( new NumberNode( theValue.value() ) ) );
+		state.valStack.push( MakeNode<NumberNode>( theValue.value() ) );
 	}
 	else
 	{
@@ -85,4 +94,23 @@ inline void	DoEvaluateNary::operator()( auto& ctx ) const
 	}
 }
 
+inline void	DoEvaluateNaryLiterals::operator()( auto& ctx ) const
+{
+	using namespace boost::parser::literals;
+	SCalcState& state( _globals(ctx) );
+	const NaryFunc theFunc = boost::parser::get( _attr(ctx), 0_c );
+	const std::vector<double>& args( boost::parser::get( _attr(ctx), 1_c ) );
+	
+	// Like the general case, require at least 2 arguments, so that it can
+	// report the error.  When folding is deferred, leave the call to the
+	// general case too, so that it is kept as a node.
+	if ( (args.size() < 2) or state.deferFolding )
+	{
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.valStack.push( MakeNode<NumberNode>( theFunc( args ) ) );
+}
+
 #endif /* DoEvaluateNary_h */
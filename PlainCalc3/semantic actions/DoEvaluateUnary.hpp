@@ -58,12 +58,12 @@ inline void	DoEvaluateUnary::operator()( auto& ctx ) const
 	autoASTNode paramNode = state.valStack.top();
 	state.valStack.pop();
 	
-	std::optional<double> paramValue = paramNode->Evaluate( state );
+	std::optional<double> paramValue = state.FoldedValue( *paramNode );
 	
 	if (paramValue.has_value())
 	{
 		double result = theFunc( paramValue.value() );
-		state.valStack.push( autoASTNode( new NumberNode( result ) ) );
+		state.valStack.push( MakeNode<NumberNode>( result ) );
 	}
 	else
 	{
@@ -93,7 +93,7 @@ inline void	DoEvaluateUserFunc::operator()( auto& ctx ) const
 		
 		if (result.has_value())
 		{
-			state.valStack.push( autoASTNode( new NumberNode( result.value() ) ) );
+			state.valStack.push( MakeNode<NumberNode>( result.value() ) );
 		}
 		else
 		{
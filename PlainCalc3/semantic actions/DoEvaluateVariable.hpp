@@ -56,7 +56,7 @@ inline void	DoEvaluateVariable::operator()( auto& ctx ) const
 	std::optional<double> constVal( Lookup( theIdentifier, BuiltInConstants() ) );
 	if (constVal.has_value())
 	{
-		state.valStack.push( autoASTNode( new NumberNode( constVal.value() ) ) );
+		state.valStack.push( MakeNode<NumberNode>( constVal.value() ) );
 		return;
 	}
 	
@@ -80,7 +80,7 @@ inline void	DoEvaluateVariable::operator()( auto& ctx ) const
 	std::optional<double> varValue( Lookup( theIdentifier, state.variables ) );
 	if (varValue.has_value())
 	{
-		state.valStack.push( autoASTNode( new NumberNode( varValue.value() ) ) );
+		state.valStack.push( MakeNode<NumberNode>( varValue.value() ) );
 		return;
 	}
 	
@@ -93,13 +93,13 @@ inline void	DoEvaluateVariable::operator()( auto& ctx ) const
 		return;
 	}
 	
-	// Is it "if"?  If we got here, we must not have reached any expectation
-	// points in the "if" section of the factor parser, so it must not be
-	// immediately followed by a left parenthesis.
-	if (theIdentifier == "if")
+	// Is it a keyword such as "if"?  If we got here, we must not have reached
+	// any expectation points in the corresponding section of the factor
+	// parser, so it must not be immediately followed by a left parenthesis.
+	if (IsBuiltInKeyword( theIdentifier ))
 	{
-		_report_error( ctx, "'if' cannot be used as a variable, only as a "
-			"built-in function" );
+		_report_error( ctx, "'" + theIdentifier + "' cannot be used as a "
+			"variable, only as a built-in function" );
 		_pass(ctx) = false;
 		return;
 	}
@@ -50,12 +50,13 @@ inline void	DoGetAssignableIdentifier::operator()( auto& ctx ) const
 	SCalcState& state( _globals(ctx) );
 	std::string theIdentifier( MatchedText( ctx ) );
 	
-	if ( BuiltInConstants().contains( theIdentifier ) or
+	if ( (not IsShadowableBuiltIn( theIdentifier )) and
+		( BuiltInConstants().contains( theIdentifier ) or
 		BuiltInUnarySyms().Contains( theIdentifier ) or
 		BuiltInBinarySyms().Contains( theIdentifier ) or
 		BuiltInNarySyms().Contains( theIdentifier ) or
 		BuiltInIterationSyms().find( ctx, theIdentifier ) or
-		(theIdentifier == "if") )
+		IsBuiltInKeyword( theIdentifier ) ) )
 	{
 		std::string msg = "Identifier '" + theIdentifier + "' is built in, " +
 			"and cannot be assigned to,";
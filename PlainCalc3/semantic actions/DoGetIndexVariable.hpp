@@ -52,7 +52,8 @@ inline void	DoGetIndexVariable::operator()( auto& ctx ) const
 		BuiltInUnarySyms().Contains( theIdentifier ) or
 		BuiltInBinarySyms().Contains( theIdentifier ) or
 		BuiltInNarySyms().Contains( theIdentifier ) or
-		BuiltInIterationSyms().find( ctx, theIdentifier ) )
+		( BuiltInIterationSyms().find( ctx, theIdentifier ) and
+		(not IsShadowableBuiltIn( theIdentifier )) ) )
 	{
 		forbidMsg = "Built-in function or constant '" + theIdentifier +
 			"' cannot be an index variable";
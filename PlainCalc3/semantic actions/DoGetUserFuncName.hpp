@@ -44,13 +44,14 @@ struct DoGetUserFuncName
 		state.suppressUserFuncEvaluation += 1;
 		
 		// Make sure this name is not the name of a built-in constant or
-		// function.
-		if ( BuiltInConstants().contains( theIdentifier ) or
+		// function, other than one that user functions may shadow.
+		if ( (not IsShadowableBuiltIn( theIdentifier )) and
+			( BuiltInConstants().contains( theIdentifier ) or
 			BuiltInUnarySyms().Contains( theIdentifier ) or
 			BuiltInBinarySyms().Contains( theIdentifier ) or
 			BuiltInNarySyms().Contains( theIdentifier ) or
 			BuiltInIterationSyms().find( ctx, theIdentifier ) or
-			(theIdentifier == "if") )
+			IsBuiltInKeyword( theIdentifier ) ) )
 		{
 			std::string msg = "Identifier " + theIdentifier + " is built in, " +
 				"and cannot be redefined,";
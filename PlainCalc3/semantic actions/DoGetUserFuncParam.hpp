@@ -61,7 +61,8 @@ struct DoGetUserFuncParam
 		else if ( BuiltInUnarySyms().Contains( theIdentifier ) or
 			BuiltInBinarySyms().Contains( theIdentifier ) or
 			BuiltInNarySyms().Contains( theIdentifier ) or
-			BuiltInIterationSyms().find( ctx, theIdentifier ) )
+			( BuiltInIterationSyms().find( ctx, theIdentifier ) and
+			(not IsShadowableBuiltIn( theIdentifier )) ) )
 		{
 			forbidMsg = "Built-in function '" + theIdentifier +
 				"' cannot be a formal parameter";
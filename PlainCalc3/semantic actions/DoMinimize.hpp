@@ -0,0 +1,125 @@
+//  DoMinimize.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef DoMinimize_h
+#define DoMinimize_h
+
+#import "MatchedText.hpp"
+#import "MinimizeNode.hpp"
+#import "NumberNode.hpp"
+#import "SCalcState.hpp"
+
+#import <algorithm>
+
+/// Check that the identifier is the name of a user function, and push it on
+/// the function name stack.
+struct DoGetMinimizeFunc
+{
+	void	operator()( auto& ctx ) const;
+};
+
+/// Replace the arguments on the value stack by the minimum of the function,
+/// starting from a point or searching a box.
+struct DoMinimize
+{
+	void	operator()( auto& ctx ) const;
+};
+
+inline void	DoGetMinimizeFunc::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	std::string theIdentifier( MatchedText( ctx ) );
+	
+	if (not state.userFunctions.contains( theIdentifier ))
+	{
+		_report_error( ctx, "'" + theIdentifier + "' is not a user function" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.funcNameStack.push( theIdentifier );
+}
+
+inline void	DoMinimize::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	
+	size_t argCount = _attr(ctx).end() - _attr(ctx).begin();
+	
+	if ( state.funcNameStack.empty() or (state.valStack.size() < argCount) )
+	{
+		_report_error( ctx, "stack underrun" );
+		_pass( ctx ) = false;
+		return;
+	}
+	std::string funcName( state.funcNameStack.top() );
+	state.funcNameStack.pop();
+	
+	const size_t paramCount = std::get<StringVec>(
+		state.userFunctions[ funcName ] ).size();
+	if ( (argCount != paramCount) and (argCount != 2 * paramCount) )
+	{
+		_report_error( ctx, "minimizing '" + funcName + "' needs " +
+			std::to_string( paramCount ) + " starting values or " +
+			std::to_string( paramCount ) + " pairs of bounds" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	ASTNodeVec args;
+	args.reserve( argCount );
+	for (size_t i = 0; i < argCount; ++i)
+	{
+		args.push_back( state.valStack.top() );
+		state.valStack.pop();
+	}
+	std::reverse( args.begin(), args.end() );
+	
+	autoASTNode minNode( new MinimizeNode( funcName, args ) );
+	
+	if (state.suppressUserFuncEvaluation == 0)
+	{
+		std::optional<double> result = minNode->Evaluate( state );
+		
+		if (result.has_value())
+		{
+			state.valStack.push( MakeNode<NumberNode>( result.value() ) );
+		}
+		else
+		{
+			state.valStack.push( std::move( minNode ) );
+		}
+	}
+	else
+	{
+		state.valStack.push( std::move( minNode ) );
+	}
+}
+
+#endif /* DoMinimize_h */
@@ -46,10 +46,10 @@ inline void	DoNegate::operator()( auto& ctx ) const
 	autoASTNode topNode = state.valStack.top();
 	state.valStack.pop();
 	
-	std::optional<double> topValue( topNode->Evaluate( state ) );
+	std::optional<double> topValue( state.FoldedValue( *topNode ) );
 	if (topValue.has_value())
 	{
-		state.valStack.push( autoASTNode( new NumberNode( - topValue.value() ) ) );
+		state.valStack.push( MakeNode<NumberNode>( - topValue.value() ) );
 	}
 	else
 	{
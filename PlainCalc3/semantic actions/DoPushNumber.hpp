@@ -44,7 +44,7 @@ inline void	DoPushNumber::operator()( auto& ctx ) const
 
 	double theNumber = _attr(ctx);
 	
-	state.valStack.push( autoASTNode( new NumberNode( theNumber ) ) );
+	state.valStack.push( MakeNode<NumberNode>( theNumber ) );
 }
 
 
@@ -0,0 +1,110 @@
+//  DoTable.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef DoTable_h
+#define DoTable_h
+
+#import "CompileUserFunctions.hpp"
+#import "EvaluateTable.hpp"
+#import "SCalcState.hpp"
+
+#import <string>
+
+/// Record the grid of a table statement, leaving its optimized content on
+/// the value stack.
+struct DoTable
+{
+	void	operator()( auto& ctx ) const;
+};
+
+inline void	DoTable::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	
+	if ( state.iterationIndexVariables.empty() or (state.valStack.size() < 4) )
+	{
+		_report_error( ctx, "stack underrun" );
+		_pass( ctx ) = false;
+		return;
+	}
+	std::string indexVariable( state.iterationIndexVariables.back() );
+	state.iterationIndexVariables.pop_back();
+	
+	autoASTNode contentNode( state.valStack.top() );
+	state.valStack.pop();
+	
+	autoASTNode stepNode( state.valStack.top() );
+	state.valStack.pop();
+	
+	autoASTNode endNode( state.valStack.top() );
+	state.valStack.pop();
+	
+	autoASTNode startNode( state.valStack.top() );
+	state.valStack.pop();
+	
+	// The grid must be known before the table is evaluated, so that the rows
+	// can be divided among threads.
+	std::optional<double> startValue( startNode->Evaluate( state ) );
+	std::optional<double> endValue( endNode->Evaluate( state ) );
+	std::optional<double> stepValue( stepNode->Evaluate( state ) );
+	if ( not (startValue.has_value() and endValue.has_value() and
+		stepValue.has_value()) )
+	{
+		_report_error( ctx, "the start, end, and step of a table must be "
+			"numbers" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	std::optional<size_t> rowCount( TableRowCount( *startValue, *endValue,
+		*stepValue ) );
+	if (not rowCount.has_value())
+	{
+		_report_error( ctx, "the step of a table must be nonzero and lead "
+			"from the start toward the end" );
+		_pass( ctx ) = false;
+		return;
+	}
+	if (*rowCount > kMaxTableRows)
+	{
+		_report_error( ctx, "a table can have at most " +
+			std::to_string( kMaxTableRows ) + " rows" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.tableGrid.variable = indexVariable;
+	state.tableGrid.start = *startValue;
+	state.tableGrid.step = *stepValue;
+	state.tableGrid.rowCount = *rowCount;
+	
+	// The content will be evaluated once per row.
+	state.valStack.push( OptimizeExpression( contentNode, state ) );
+}
+
+#endif /* DoTable_h */
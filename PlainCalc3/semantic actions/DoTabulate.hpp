@@ -0,0 +1,139 @@
+//  DoTabulate.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef DoTabulate_h
+#define DoTabulate_h
+
+#import "MatchedText.hpp"
+#import "NumberNode.hpp"
+#import "SCalcState.hpp"
+#import "TabulateUserFunction.hpp"
+
+#import <math.h>
+
+// Default requested accuracy of tabulate.
+static constexpr double kDefaultTabulateTolerance = 1.0e-12;
+
+/// Check that the identifier is the name of a user function of one variable,
+/// and push it on the function name stack.
+struct DoGetTabulatedFunc
+{
+	void	operator()( auto& ctx ) const;
+};
+
+/// Approximate the function and push the error bound.
+struct DoTabulate
+{
+	DoTabulate() = delete;
+	
+	DoTabulate( bool hasTolerance )
+		: _hasTolerance( hasTolerance ) {}
+
+	void	operator()( auto& ctx ) const;
+
+private:
+	bool	_hasTolerance;
+};
+
+inline void	DoGetTabulatedFunc::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	std::string theIdentifier( MatchedText( ctx ) );
+	
+	if (state.suppressUserFuncEvaluation > 0)
+	{
+		_report_error( ctx, "tabulate cannot be used within a function "
+			"definition or an if" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	auto defIt = state.userFunctions.find( theIdentifier );
+	if ( (defIt == state.userFunctions.end()) or
+		(std::get<StringVec>( defIt->second ).size() != 1) )
+	{
+		_report_error( ctx, "'" + theIdentifier + "' is not a user function "
+			"of one variable" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.funcNameStack.push( theIdentifier );
+}
+
+inline void	DoTabulate::operator()( auto& ctx ) const
+{
+	SCalcState& state( _globals(ctx) );
+	
+	if ( state.funcNameStack.empty() or
+		(state.valStack.size() < (_hasTolerance? 3 : 2)) )
+	{
+		_report_error( ctx, "stack underrun" );
+		_pass( ctx ) = false;
+		return;
+	}
+	std::string funcName( state.funcNameStack.top() );
+	state.funcNameStack.pop();
+	
+	std::optional<double> tolerance( kDefaultTabulateTolerance );
+	if (_hasTolerance)
+	{
+		tolerance = state.valStack.top()->Evaluate( state );
+		state.valStack.pop();
+	}
+	std::optional<double> endValue( state.valStack.top()->Evaluate( state ) );
+	state.valStack.pop();
+	std::optional<double> startValue( state.valStack.top()->Evaluate( state ) );
+	state.valStack.pop();
+	
+	if ( (not startValue.has_value()) or (not endValue.has_value()) or
+		(not tolerance.has_value()) or
+		(not isfinite( *startValue )) or (not isfinite( *endValue )) or
+		(*startValue >= *endValue) or (not (*tolerance > 0.0)) )
+	{
+		_report_error( ctx, "tabulate needs a finite interval and a "
+			"positive tolerance" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	std::optional<double> errorBound( TabulateUserFunction( funcName,
+		*startValue, *endValue, *tolerance, state ) );
+	if (not errorBound.has_value())
+	{
+		_report_error( ctx, "'" + funcName + "' could not be approximated "
+			"to the requested tolerance" );
+		_pass( ctx ) = false;
+		return;
+	}
+	
+	state.valStack.push( MakeNode<NumberNode>( *errorBound ) );
+}
+
+#endif /* DoTabulate_h */
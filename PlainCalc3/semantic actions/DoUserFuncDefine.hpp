@@ -32,6 +32,7 @@
 #import "SCalcState.hpp"
 #import "MatchedText.hpp"
 #import "NumberNode.hpp"
+#import "CompileUserFunctions.hpp"
 #import <iostream>
 
 
@@ -84,12 +85,21 @@ struct DoUserFuncDefine
 		}
 		else
 		{
-			rightHandSide = autoASTNode( new NumberNode( 0.0 ) );
+			rightHandSide = MakeNode<NumberNode>( 0.0 );
 			state.preexistingUserFunc = state.userFunctions.contains( state.leftIdentifier );
 		}
 		state.userFunctions[ state.leftIdentifier ] =
 			FuncDef( state.paramsOfFuncBeingDefined, rhsText, rightHandSide );
 		state.definedUserFunc = _fullyDefined;
+		
+		if (_fullyDefined)
+		{
+			CompileUserFunctions( state );
+		}
+		else
+		{
+			state.compiledFunctions.erase( state.leftIdentifier );
+		}
 	}
 
 private:
@@ -33,7 +33,10 @@
 #import <memory>
 #import <vector>
 #import <initializer_list>
+#import <utility>
 #import "autoCF.hpp"
+#import "Dual.hpp"
+#import "NodePool.hpp"
 
 struct SCalcState;
 
@@ -58,10 +61,19 @@ public:
 	
 	virtual std::optional<double>	Evaluate( SCalcState& state ) const = 0;
 	
+	/// Evaluate the node and its derivative with respect to the arguments
+	/// in the dualArguments member of the state, which stand in for the
+	/// parameters of the user function being differentiated.
+	virtual std::optional<Dual>		EvaluateDual( SCalcState& state ) const = 0;
+	
 	virtual autoCFDictionaryRef		ToDictionary() const = 0;
 	
 	virtual bool					operator==( const ASTNode& other ) const = 0;
 	
+	/// Make a node of the same kind with the same data but different children.
+	/// This is the basis of tree transformations such as inlining.
+	virtual autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const = 0;
+	
 	const ASTNodeVec&				Children() const noexcept { return _children; }
 
 protected:
@@ -78,4 +90,21 @@ inline  unsigned int	ASTNode::Count() const noexcept
 	return result;
 }
 
+/*!
+	@function	MakeNode
+	
+	@abstract	Create a syntax tree node.
+	
+	@discussion	The node and its reference count share one block of memory from
+				the node pool, so that nodes which are created and discarded
+				during every calculation do not cause heap allocations once the
+				pool has warmed up.
+*/
+template <typename NodeType, typename... Args>
+inline autoASTNode	MakeNode( Args&&... args )
+{
+	return std::allocate_shared<NodeType>( NodePoolAllocator<NodeType>(),
+		std::forward<Args>( args )... );
+}
+
 #endif /* ASTNode_hpp */
@@ -44,11 +44,14 @@ public:
 				{}
 	
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 	
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
 	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
 	BinaryFunc				GetFunc() const { return _func; }
 
 private:
@@ -30,7 +30,9 @@
 
 #import "BasicMath.hpp"
 #import "Built-ins.hpp"
+#import "Differentiation.hpp"
 #import "SCalcState.hpp"
+#import "ParallelEvaluation.hpp"
 
 #import <Foundation/Foundation.h>
 #import <math.h>
@@ -39,8 +41,20 @@ std::optional<double>	BinaryFuncNode::Evaluate( SCalcState& state ) const
 {
 	std::optional<double> result;
 	
-	std::optional<double> param1Value( _children[0]->Evaluate( state ) );
-	std::optional<double> param2Value( _children[1]->Evaluate( state ) );
+	std::optional<double> param1Value, param2Value;
+	
+	if ( (state.parallel != nullptr) and state.parallel->ShouldSpawn( state, _children ) )
+	{
+		std::optional<double> values[2];
+		state.parallel->EvaluateAll( state, _children, values );
+		param1Value = values[0];
+		param2Value = values[1];
+	}
+	else
+	{
+		param1Value = _children[0]->Evaluate( state );
+		param2Value = _children[1]->Evaluate( state );
+	}
 	
 	if ( param1Value.has_value() and param2Value.has_value() )
 	{
@@ -50,6 +64,25 @@ std::optional<double>	BinaryFuncNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	BinaryFuncNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<Dual> param1Value( _children[0]->EvaluateDual( state ) );
+	std::optional<Dual> param2Value;
+	if (param1Value.has_value())
+	{
+		param2Value = _children[1]->EvaluateDual( state );
+	}
+	
+	if (param2Value.has_value())
+	{
+		result = ApplyBinary( _func, *param1Value, *param2Value );
+	}
+	
+	return result;
+}
+
 
 autoCFDictionaryRef	BinaryFuncNode::ToDictionary() const
 {
@@ -111,3 +144,9 @@ bool	BinaryFuncNode::operator==( const ASTNode& other ) const
 		(*asMyType->Children()[1] == *Children()[1]);
 	return isEqual;
 }
+
+
+autoASTNode	BinaryFuncNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new BinaryFuncNode( _func, children[0], children[1] ) );
+}
@@ -31,13 +31,18 @@
 #import "BasicMath.hpp"
 #import "BinaryFuncNode.hpp"
 #import "Built-ins.hpp"
+#import "DerivativeNode.hpp"
 #import "IfNode.hpp"
+#import "IntegralNode.hpp"
 #import "IndexVariableNode.hpp"
 #import "IterationNode.hpp"
 #import "Lookup.hpp"
+#import "MinimizeNode.hpp"
 #import "NaryFuncNode.hpp"
 #import "NumberNode.hpp"
 #import "ParameterIndexNode.hpp"
+#import "PolynomialNode.hpp"
+#import "SolveNode.hpp"
 #import "UnaryFuncNode.hpp"
 #import "UserFuncNode.hpp"
 
@@ -87,6 +92,31 @@ static autoASTNode BinaryFuncMaker( NSDictionary* dict )
 	return resultTree;
 }
 
+static autoASTNode DerivativeMaker( NSDictionary* dict )
+{
+	NSString* name = dict[@"function"];
+	NSDictionary* argument = dict[@"argument"];
+	autoASTNode argTree = BuildTreeFromDictionary( argument );
+	autoASTNode resultTree( new DerivativeNode( name.UTF8String, argTree ) );
+	
+	return resultTree;
+}
+
+static autoASTNode MinimizeMaker( NSDictionary* dict )
+{
+	NSString* name = dict[@"function"];
+	std::vector< autoASTNode > argVec;
+	NSArray* argArray = dict[@"args"];
+	argVec.reserve( argArray.count );
+	for (NSDictionary* argDict in argArray)
+	{
+		argVec.push_back( BuildTreeFromDictionary( argDict ) );
+	}
+	autoASTNode resultTree( new MinimizeNode( name.UTF8String, argVec ) );
+	
+	return resultTree;
+}
+
 static autoASTNode IfMaker( NSDictionary* dict )
 {
 	NSDictionary* test = dict[@"test"];
@@ -178,8 +208,43 @@ static autoASTNode IterationNodeMaker( NSDictionary* dict )
 	autoASTNode endTree = BuildTreeFromDictionary( end );
 	NSDictionary* content = dict[@"content"];
 	autoASTNode contentTree = BuildTreeFromDictionary( content );
-	autoASTNode resultTree( new IterationNode( kind, variableName.UTF8String,
-		startTree, endTree, contentTree ) );
+	NSDictionary* tolerance = dict[@"tolerance"];
+	autoASTNode toleranceTree;
+	if (tolerance != nil)
+	{
+		toleranceTree = BuildTreeFromDictionary( tolerance );
+	}
+	autoASTNode resultTree;
+	if (kind == IterationKind::integration)
+	{
+		resultTree = autoASTNode( new IntegralNode( variableName.UTF8String,
+			startTree, endTree, contentTree, toleranceTree ) );
+	}
+	else if (kind == IterationKind::rootFinding)
+	{
+		resultTree = autoASTNode( new SolveNode( variableName.UTF8String,
+			startTree, endTree, contentTree, toleranceTree ) );
+	}
+	else
+	{
+		resultTree = autoASTNode( new IterationNode( kind, variableName.UTF8String,
+			startTree, endTree, contentTree, toleranceTree ) );
+	}
+	return resultTree;
+}
+
+static autoASTNode PolynomialMaker( NSDictionary* dict )
+{
+	NSDictionary* variable = dict[@"variable"];
+	autoASTNode variableTree = BuildTreeFromDictionary( variable );
+	NSArray<NSNumber*>* coefficients = dict[@"coefficients"];
+	std::vector<double> coeffs;
+	coeffs.reserve( coefficients.count );
+	for (NSNumber* coeff in coefficients)
+	{
+		coeffs.push_back( coeff.doubleValue );
+	}
+	autoASTNode resultTree( new PolynomialNode( variableTree, coeffs ) );
 	return resultTree;
 }
 
@@ -191,10 +256,13 @@ autoASTNode BuildTreeFromDictionary( NSDictionary* dict )
 	static std::map<std::string, TreeMaker > sMakerMap
 	{
 		{ "BinaryFunc", BinaryFuncMaker },
+		{ "Derivative", DerivativeMaker },
 		{ "If", IfMaker },
+		{ "Minimize", MinimizeMaker },
 		{ "NaryFunc", NaryMaker },
 		{ "Number", NumberMaker },
 		{ "ParameterIndex", ParameterIndexMaker },
+		{ "Polynomial", PolynomialMaker },
 		{ "UnaryFunc", UnaryFuncMaker },
 		{ "UserFunc", UserFuncMaker },
 		{ "IndexVariable", IndexVariableMaker },
@@ -0,0 +1,63 @@
+//  DerivativeNode.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef DerivativeNode_hpp
+#define DerivativeNode_hpp
+
+#import "ASTNode.hpp"
+#import <string>
+
+/*!
+	@class		DerivativeNode
+	@abstract	The derivative of a user function of one variable, evaluated at
+				the value of the child node by forward-mode automatic
+				differentiation.
+*/
+class DerivativeNode : public ASTNode
+{
+public:
+			DerivativeNode( const std::string& funcName, autoASTNode argument )
+				: ASTNode{ argument }
+				, _funcName( funcName ) {}
+	
+	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
+	
+	autoCFDictionaryRef		ToDictionary() const override;
+	
+	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	const std::string&		FuncName() const { return _funcName; }
+
+private:
+	std::string				_funcName;
+};
+
+#endif /* DerivativeNode_hpp */
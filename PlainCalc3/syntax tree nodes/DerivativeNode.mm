@@ -0,0 +1,108 @@
+//  DerivativeNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "DerivativeNode.hpp"
+
+#import "SCalcState.hpp"
+#import "UserFuncNode.hpp"
+
+#import <Foundation/Foundation.h>
+
+std::optional<double>	DerivativeNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	
+	std::optional<double> argVal( _children[0]->Evaluate( state ) );
+	if (argVal.has_value())
+	{
+		std::vector<Dual> arguments{ Dual{ *argVal, 1.0 } };
+		std::optional<Dual> dualVal( UserFuncNode::CallDual( _funcName,
+			arguments, state ) );
+		if (dualVal.has_value())
+		{
+			result = dualVal->derivative;
+		}
+	}
+	
+	return result;
+}
+
+std::optional<Dual>	DerivativeNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<Dual> argVal( _children[0]->EvaluateDual( state ) );
+	
+	// Only first derivatives are supported, so a derivative can only be
+	// differentiated where its argument does not vary.
+	if ( argVal.has_value() and (argVal->derivative == 0.0) )
+	{
+		std::optional<double> value( Evaluate( state ) );
+		if (value.has_value())
+		{
+			result = Dual{ *value, 0.0 };
+		}
+	}
+	
+	return result;
+}
+
+
+autoCFDictionaryRef	DerivativeNode::ToDictionary() const
+{
+	NSDictionary* result = nil;
+	
+	NSDictionary* argDict = CF_NS( _children[0]->ToDictionary() );
+	
+	if (argDict != nil)
+	{
+		result = @{
+			@"kind": @"Derivative",
+			@"function": @(_funcName.c_str()),
+			@"argument": argDict
+		};
+	}
+	
+	return NS_CF( result );
+}
+
+
+bool	DerivativeNode::operator==( const ASTNode& other ) const
+{
+	const DerivativeNode* asMyType = dynamic_cast<const DerivativeNode*>( &other );
+	bool isEqual = (asMyType != nullptr) and
+		(asMyType->_funcName == _funcName) and
+		(*asMyType->Children()[0] == *Children()[0]);
+	return isEqual;
+}
+
+
+autoASTNode	DerivativeNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new DerivativeNode( _funcName, children[0] ) );
+}
@@ -0,0 +1,97 @@
+//  FusedIterationNode.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef FusedIterationNode_hpp
+#define FusedIterationNode_hpp
+
+#import "ASTNode.hpp"
+#import "Built-ins.hpp"
+
+#import <string>
+#import <vector>
+
+/*!
+	@class		FusedIterationNode
+	
+	@abstract	Nested sums or nested products over a rectangular range of
+				index values, evaluated as one multi-dimensional loop.
+	
+	@discussion	This is made by FuseIterations from nested IterationNodes of
+				the same kind, where the bounds of the inner iterations do not
+				depend on the outer index variables.  The children are the
+				start and end values of each index variable, outermost first,
+				followed by the content.  The bounds are evaluated once, and
+				if the content calls user functions, whose results get
+				memoized, the last two dimensions are traversed in tiles so
+				that nearby arguments are reused while they are still cached.
+				Each value of an index variable gets its own total of the
+				inner dimensions, so that the result is the same as that of
+				the nested iterations, to the last bit.
+				
+				When evaluating in parallel, the outermost dimension is split
+				into chunks that may be evaluated on different threads.  Then
+				the totals of the chunks are added, which groups the terms of
+				the outermost sum or product differently, and can change the
+				last bits of the result.
+*/
+class FusedIterationNode : public ASTNode
+{
+public:
+			FusedIterationNode( IterationKind kind,
+								const std::vector<std::string>& indexVariables,
+								const ASTNodeVec& children );
+	
+	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
+	
+	autoCFDictionaryRef		ToDictionary() const override;
+	
+	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	IterationKind			Kind() const { return _kind; }
+	const std::vector<std::string>&	Variables() const { return _indexVariables; }
+	const autoASTNode&		Content() const { return _children.back(); }
+	
+	/*!
+		@function	Unfuse
+		@abstract	Make the equivalent nest of IterationNodes.
+	*/
+	autoASTNode				Unfuse() const;
+
+private:
+	ASTNodeVec				SplitOutermost( const std::vector<double>& inBounds,
+											size_t inChunkCount ) const;
+	
+	IterationKind			_kind;
+	std::vector<std::string>	_indexVariables;
+	bool					_callsUserFunctions;
+};
+
+#endif /* FusedIterationNode_hpp */
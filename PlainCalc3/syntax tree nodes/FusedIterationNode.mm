@@ -0,0 +1,323 @@
+//  FusedIterationNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "FusedIterationNode.hpp"
+
+#import "IterationNode.hpp"
+#import "NumberNode.hpp"
+#import "ParallelEvaluation.hpp"
+#import "SCalcState.hpp"
+#import "TreeUtilities.hpp"
+
+#import <Foundation/Foundation.h>
+#import <algorithm>
+#import <math.h>
+
+// When the content calls user functions, the last two dimensions are
+// traversed in square tiles of this size.
+static constexpr double kTileSize = 32.0;
+
+// Otherwise, the last dimension is traversed in chunks of this size.  We
+// check for interruption once per tile or chunk.
+static constexpr double kChunkSize = kTileSize * kTileSize;
+
+// When evaluating in parallel, the outermost dimension is split into this
+// many chunks per thread, so that the work can be balanced.
+static constexpr size_t kChunksPerThread = 4;
+
+namespace
+{
+	// Runs the loops of a FusedIterationNode, given the start value and the
+	// number of values of each index variable.
+	struct FusedLoop
+	{
+		SCalcState&					state;
+		const FusedIterationNode&	node;
+		const std::vector<double>&	bounds;
+		bool						isTiled;
+		double						identity;
+		
+		void	Add( double& ioTotal, double inValue ) const;
+		bool	Run( size_t inDim, double& ioTotal );
+		bool	RunLastTwo( size_t inDim, double& ioTotal );
+	};
+}
+
+void	FusedLoop::Add( double& ioTotal, double inValue ) const
+{
+	if (node.Kind() == IterationKind::summation)
+	{
+		ioTotal += inValue;
+	}
+	else
+	{
+		ioTotal *= inValue;
+	}
+}
+
+// Each dimension totals the values of the dimensions inside it for each
+// value of its index variable, and then adds those up in order, just as
+// nested iterations would.  So fusion does not change the result.
+bool	FusedLoop::Run( size_t inDim, double& ioTotal )
+{
+	if (inDim + 2 >= node.Variables().size())
+	{
+		return RunLastTwo( inDim, ioTotal );
+	}
+	
+	bool allEvaluated = true;
+	IndexVariableScope index( state, node.Variables()[ inDim ] );
+	const double start = bounds[ 2 * inDim ];
+	const double count = bounds[ 2 * inDim + 1 ];
+	
+	for (double i = 0.0; allEvaluated and (i < count); ++i)
+	{
+		index.Value() = start + i;
+		double subtotal = identity;
+		allEvaluated = Run( inDim + 1, subtotal );
+		Add( ioTotal, subtotal );
+	}
+	
+	return allEvaluated;
+}
+
+bool	FusedLoop::RunLastTwo( size_t inDim, double& ioTotal )
+{
+	IndexVariableScope outer( state, node.Variables()[ inDim ] );
+	IndexVariableScope inner( state, node.Variables()[ inDim + 1 ] );
+	const double outerStart = bounds[ 2 * inDim ];
+	const double outerCount = bounds[ 2 * inDim + 1 ];
+	const double innerStart = bounds[ 2 * inDim + 2 ];
+	const double innerCount = bounds[ 2 * inDim + 3 ];
+	const double outerTile = isTiled? kTileSize : 1.0;
+	const double innerTile = isTiled? kTileSize : kChunkSize;
+	const ASTNode& content( *node.Content() );
+	
+	// Within a tile, each value of the outer index keeps its own total of
+	// the inner iteration.
+	double rowTotals[ static_cast<size_t>( kTileSize ) ];
+	
+	for (double i0 = 0.0; i0 < outerCount; i0 += outerTile)
+	{
+		const double iEnd = std::min( i0 + outerTile, outerCount );
+		std::fill_n( rowTotals, static_cast<size_t>( iEnd - i0 ), identity );
+		
+		for (double j0 = 0.0; j0 < innerCount; j0 += innerTile)
+		{
+			if (state.interruptCode != CalcInterruptCode::none)
+			{
+				return false;
+			}
+			const double jEnd = std::min( j0 + innerTile, innerCount );
+			
+			for (double i = i0; i < iEnd; ++i)
+			{
+				outer.Value() = outerStart + i;
+				double& rowTotal( rowTotals[ static_cast<size_t>( i - i0 ) ] );
+				
+				for (double j = j0; j < jEnd; ++j)
+				{
+					inner.Value() = innerStart + j;
+					std::optional<double> contentVal( content.Evaluate( state ) );
+					if (not contentVal.has_value())
+					{
+						return false;
+					}
+					Add( rowTotal, contentVal.value() );
+				}
+			}
+		}
+		
+		for (double i = i0; i < iEnd; ++i)
+		{
+			Add( ioTotal, rowTotals[ static_cast<size_t>( i - i0 ) ] );
+		}
+	}
+	
+	return true;
+}
+
+FusedIterationNode::FusedIterationNode( IterationKind kind,
+										const std::vector<std::string>& indexVariables,
+										const ASTNodeVec& children )
+	: ASTNode( children )
+	, _kind( kind )
+	, _indexVariables( indexVariables )
+	, _callsUserFunctions( CallsUserFunctions( *children.back() ) )
+{
+}
+
+// Make nodes that each cover a range of values of the first index variable
+// and all values of the others.
+ASTNodeVec	FusedIterationNode::SplitOutermost( const std::vector<double>& inBounds,
+												size_t inChunkCount ) const
+{
+	ASTNodeVec chunks;
+	chunks.reserve( inChunkCount );
+	const double count = inBounds[1];
+	
+	for (size_t c = 0; c < inChunkCount; ++c)
+	{
+		const double first = floor( count * c / inChunkCount );
+		const double next = floor( count * (c + 1) / inChunkCount );
+		ASTNodeVec children;
+		children.reserve( _children.size() );
+		children.push_back( MakeNode<NumberNode>( inBounds[0] + first ) );
+		children.push_back( MakeNode<NumberNode>( inBounds[0] + next - 1.0 ) );
+		
+		for (size_t i = 2; i < inBounds.size(); i += 2)
+		{
+			children.push_back( MakeNode<NumberNode>( inBounds[i] ) );
+			children.push_back( MakeNode<NumberNode>( inBounds[i] +
+				inBounds[i + 1] - 1.0 ) );
+		}
+		children.push_back( Content() );
+		chunks.push_back( CloneWithChildren( children ) );
+	}
+	
+	return chunks;
+}
+
+std::optional<double>	FusedIterationNode::Evaluate( SCalcState& state ) const
+{
+	const double identity = (Kind() == IterationKind::summation)? 0.0 : 1.0;
+	std::vector<double> bounds;
+	bounds.reserve( 2 * _indexVariables.size() );
+	
+	// Evaluate the bounds, outermost first.  If the range is empty in some
+	// dimension, the result is the identity without looking at the rest, as
+	// with nested iterations, even if the rest could not be evaluated.
+	for (size_t i = 0; i < _indexVariables.size(); ++i)
+	{
+		std::optional<double> startVal( _children[ 2 * i ]->Evaluate( state ) );
+		std::optional<double> endVal( _children[ 2 * i + 1 ]->Evaluate( state ) );
+		if ( (not startVal.has_value()) or (not endVal.has_value()) )
+		{
+			return std::nullopt;
+		}
+		
+		// Infinite iterations, and the errors from infinite start values,
+		// are the business of IterationNode.
+		if ( (not isfinite( startVal.value() )) or
+			(isinf( endVal.value() ) and (endVal.value() > 0.0)) )
+		{
+			return Unfuse()->Evaluate( state );
+		}
+		
+		if (not (endVal.value() >= startVal.value()))
+		{
+			return identity;
+		}
+		bounds.push_back( startVal.value() );
+		bounds.push_back( floor( endVal.value() - startVal.value() ) + 1.0 );
+	}
+	
+	if ( (state.parallel != nullptr) and _callsUserFunctions )
+	{
+		size_t chunkCount = static_cast<size_t>( std::min( bounds[1],
+			static_cast<double>( kChunksPerThread * state.parallel->ThreadCount() ) ) );
+		if (chunkCount > 1)
+		{
+			ASTNodeVec chunks( SplitOutermost( bounds, chunkCount ) );
+			if (state.parallel->ShouldSpawn( state, chunks ))
+			{
+				std::vector< std::optional<double> > chunkValues( chunks.size() );
+				state.parallel->EvaluateAll( state, chunks, chunkValues.data() );
+				double total = identity;
+				for (const std::optional<double>& chunkValue : chunkValues)
+				{
+					if (not chunkValue.has_value())
+					{
+						return std::nullopt;
+					}
+					total = (Kind() == IterationKind::summation)?
+						total + chunkValue.value() : total * chunkValue.value();
+				}
+				return total;
+			}
+		}
+	}
+	
+	FusedLoop loop{ state, *this, bounds, _callsUserFunctions, identity };
+	std::optional<double> result;
+	double total = identity;
+	if (loop.Run( 0, total ))
+	{
+		result = total;
+	}
+	
+	return result;
+}
+
+autoASTNode	FusedIterationNode::Unfuse() const
+{
+	autoASTNode result( Content() );
+	
+	for (size_t i = _indexVariables.size(); i-- > 0; )
+	{
+		result = autoASTNode( new IterationNode( _kind, _indexVariables[i],
+			_children[ 2 * i ], _children[ 2 * i + 1 ], result ) );
+	}
+	
+	return result;
+}
+
+std::optional<Dual>	FusedIterationNode::EvaluateDual( SCalcState& state ) const
+{
+	return Unfuse()->EvaluateDual( state );
+}
+
+autoCFDictionaryRef		FusedIterationNode::ToDictionary() const
+{
+	// Fusion is an optimization, so we record the nested iterations.
+	return Unfuse()->ToDictionary();
+}
+
+bool	FusedIterationNode::operator==( const ASTNode& other ) const
+{
+	const FusedIterationNode* asMyType =
+		dynamic_cast<const FusedIterationNode*>( &other );
+	bool isEqual = (asMyType != nullptr) and
+		(asMyType->Kind() == Kind()) and
+		(asMyType->Variables() == Variables()) and
+		(asMyType->Children().size() == Children().size());
+	
+	for (size_t i = 0; isEqual and (i < Children().size()); ++i)
+	{
+		isEqual = (*asMyType->Children()[i] == *Children()[i]);
+	}
+	
+	return isEqual;
+}
+
+
+autoASTNode	FusedIterationNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new FusedIterationNode( _kind, _indexVariables,
+		children ) );
+}
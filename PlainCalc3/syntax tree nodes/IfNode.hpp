@@ -39,10 +39,13 @@ public:
 				{}
 	
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 	
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
 };
 
 #endif /* IfNode_hpp */
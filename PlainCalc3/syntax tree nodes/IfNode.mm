@@ -58,6 +58,19 @@ std::optional<double>	IfNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	IfNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<Dual> testVal( _children[0]->EvaluateDual( state ) );
+	if (testVal.has_value())
+	{
+		result = _children[ (testVal->value > 0.0)? 1 : 2 ]->EvaluateDual( state );
+	}
+	
+	return result;
+}
+
 
 autoCFDictionaryRef	IfNode::ToDictionary() const
 {
@@ -90,3 +103,9 @@ bool	IfNode::operator==( const ASTNode& other ) const
 		(*asMyType->Children()[2] == *Children()[2]);
 	return isEqual;
 }
+
+
+autoASTNode	IfNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new IfNode( children[0], children[1], children[2] ) );
+}
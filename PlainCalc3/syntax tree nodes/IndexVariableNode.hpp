@@ -36,11 +36,14 @@ public:
 				: _name( name ) {}
 	
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 	
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
 	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
 	const std::string&		Name() const { return _name; }
 
 private:
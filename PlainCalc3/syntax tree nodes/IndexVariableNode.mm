@@ -40,6 +40,24 @@ std::optional<double>	IndexVariableNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+// Index variables do not depend on the parameters of a function, though
+// their ranges might.  When solving an equation, its variable is the one
+// of differentiation.
+std::optional<Dual>	IndexVariableNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	std::optional<double> value( Evaluate( state ) );
+	
+	if (value.has_value())
+	{
+		const bool isDualVariable = (state.dualIndexVariable != nullptr) and
+			(*state.dualIndexVariable == _name);
+		result = Dual{ *value, isDualVariable? 1.0 : 0.0 };
+	}
+	
+	return result;
+}
+
 autoCFDictionaryRef		IndexVariableNode::ToDictionary() const
 {
 	NSDictionary* result = @{
@@ -55,3 +73,9 @@ bool	IndexVariableNode::operator==( const ASTNode& other ) const
 	return (asMyType != nullptr) and
 		(asMyType->Name() == Name());
 }
+
+
+autoASTNode	IndexVariableNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new IndexVariableNode( _name ) );
+}
@@ -0,0 +1,78 @@
+//  IntegralNode.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef IntegralNode_hpp
+#define IntegralNode_hpp
+
+#import "ASTNode.hpp"
+
+#import <string>
+
+/*!
+	@class		IntegralNode
+	
+	@abstract	A definite integral with respect to a variable.
+	
+	@discussion	The children are the lower and upper limits, the integrand,
+				and optionally a relative tolerance, as in an IterationNode.
+				The variable is bound in the same way as an index variable,
+				but takes values throughout the interval of integration.
+				Either limit may be infinite.
+*/
+class IntegralNode : public ASTNode
+{
+public:
+			IntegralNode( const std::string& variable,
+						autoASTNode start, autoASTNode end,
+						autoASTNode content,
+						autoASTNode tolerance = autoASTNode() );
+	
+	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
+	
+	autoCFDictionaryRef		ToDictionary() const override;
+	
+	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	const std::string&		Variable() const { return _variable; }
+	bool					HasTolerance() const { return _children.size() > 3; }
+
+private:
+	std::optional<double>	Tolerance( SCalcState& state ) const;
+	std::optional<double>	ContentAt( double inX, SCalcState& state ) const;
+	std::optional<double>	IntegrateContent( double inStart, double inEnd,
+											double inTolerance, bool inDerivative,
+											SCalcState& state ) const;
+	
+	std::string				_variable;
+	bool					_contentUsesParameters;
+};
+
+#endif /* IntegralNode_hpp */
@@ -0,0 +1,251 @@
+//  IntegralNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "IntegralNode.hpp"
+
+#import "EvaluateBatch.hpp"
+#import "IterationNode.hpp"
+#import "Quadrature.hpp"
+#import "SCalcState.hpp"
+#import "TreeUtilities.hpp"
+
+#import <Foundation/Foundation.h>
+#import <math.h>
+
+// Default relative tolerance of an integral.
+static constexpr double kDefaultIntegrationTolerance = 1.0e-10;
+
+IntegralNode::IntegralNode( const std::string& variable,
+							autoASTNode start, autoASTNode end,
+							autoASTNode content,
+							autoASTNode tolerance )
+	: ASTNode{ start, end, content }
+	, _variable( variable )
+	, _contentUsesParameters( not UsedParameters( *content ).empty() )
+{
+	if (tolerance)
+	{
+		_children.push_back( tolerance );
+	}
+}
+
+// The tolerance, or nothing if the given tolerance is not positive.
+std::optional<double>	IntegralNode::Tolerance( SCalcState& state ) const
+{
+	std::optional<double> tolerance( kDefaultIntegrationTolerance );
+	
+	if (HasTolerance())
+	{
+		tolerance = _children[3]->Evaluate( state );
+		if ( tolerance.has_value() and (not (tolerance.value() > 0.0)) )
+		{
+			tolerance.reset();
+		}
+	}
+	
+	return tolerance;
+}
+
+std::optional<double>	IntegralNode::ContentAt( double inX, SCalcState& state ) const
+{
+	IndexVariableScope variable( state, _variable );
+	variable.Value() = inX;
+	
+	return _children[2]->Evaluate( state );
+}
+
+// Integrate the content, or if inDerivative is true, the derivative of the
+// content with respect to the parameter of differentiation.
+std::optional<double>	IntegralNode::IntegrateContent( double inStart,
+														double inEnd,
+														double inTolerance,
+														bool inDerivative,
+														SCalcState& state ) const
+{
+	std::optional<double> result;
+	IndexVariableScope variable( state, _variable );
+	const autoASTNode& content( _children[2] );
+	
+	BatchIntegrand integrand = [&]( const std::vector<double>& inPoints,
+									std::vector<double>& outValues ) -> bool
+	{
+		if (not inDerivative)
+		{
+			return EvaluateBatch( *content, _variable, variable, inPoints,
+				outValues, state );
+		}
+		for (size_t i = 0; i < inPoints.size(); ++i)
+		{
+			if (state.interruptCode != CalcInterruptCode::none)
+			{
+				return false;
+			}
+			variable.Value() = inPoints[i];
+			std::optional<Dual> value( content->EvaluateDual( state ) );
+			if (not value.has_value())
+			{
+				return false;
+			}
+			outValues[i] = value->derivative;
+		}
+		return true;
+	};
+	
+	std::optional<QuadratureResult> quadrature( Integrate( integrand,
+		inStart, inEnd, inTolerance ) );
+	if (quadrature.has_value())
+	{
+		result = quadrature->value;
+		state.integrandEvaluationCount += quadrature->evaluationCount;
+		state.integrationErrorEstimate += quadrature->errorEstimate;
+	}
+	
+	return result;
+}
+
+std::optional<double>	IntegralNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	
+	std::optional<double> startVal( _children[0]->Evaluate( state ) );
+	std::optional<double> endVal( _children[1]->Evaluate( state ) );
+	std::optional<double> tolerance( Tolerance( state ) );
+	
+	if (startVal.has_value() and endVal.has_value() and tolerance.has_value())
+	{
+		result = IntegrateContent( *startVal, *endVal, *tolerance, false, state );
+	}
+	
+	return result;
+}
+
+// The derivative follows the Leibniz rule: the integral of the derivative
+// of the content, plus terms for limits that vary.
+std::optional<Dual>	IntegralNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<Dual> startVal( _children[0]->EvaluateDual( state ) );
+	std::optional<Dual> endVal( _children[1]->EvaluateDual( state ) );
+	std::optional<double> tolerance( Tolerance( state ) );
+	if ( (not startVal.has_value()) or (not endVal.has_value()) or
+		(not tolerance.has_value()) )
+	{
+		return result;
+	}
+	
+	std::optional<double> value( IntegrateContent( startVal->value,
+		endVal->value, *tolerance, false, state ) );
+	if (not value.has_value())
+	{
+		return result;
+	}
+	Dual total{ *value, 0.0 };
+	
+	if (_contentUsesParameters or (state.dualIndexVariable != nullptr))
+	{
+		std::optional<double> derivative( IntegrateContent( startVal->value,
+			endVal->value, *tolerance, true, state ) );
+		if (not derivative.has_value())
+		{
+			return result;
+		}
+		total.derivative = *derivative;
+	}
+	
+	for (const auto& [ limit, sign ] : { std::pair( *endVal, 1.0 ),
+		std::pair( *startVal, -1.0 ) })
+	{
+		if (limit.derivative != 0.0)
+		{
+			std::optional<double> contentVal( ContentAt( limit.value, state ) );
+			if ( (not contentVal.has_value()) or (not isfinite( *contentVal )) )
+			{
+				return result;
+			}
+			total.derivative += sign * *contentVal * limit.derivative;
+		}
+	}
+	
+	result = total;
+	
+	return result;
+}
+
+autoCFDictionaryRef		IntegralNode::ToDictionary() const
+{
+	NSDictionary* result = nil;
+	NSDictionary* start = CF_NS(_children[0]->ToDictionary());
+	NSDictionary* end = CF_NS(_children[1]->ToDictionary());
+	NSDictionary* content = CF_NS(_children[2]->ToDictionary());
+	
+	NSDictionary* tolerance = HasTolerance()?
+		CF_NS(_children[3]->ToDictionary()) : @{};
+	
+	if ( (start != nil) and (end != nil) and (content != nil) and
+		(tolerance != nil) )
+	{
+		// Recorded like a sum or product, with its own subtype.
+		NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithDictionary: @{
+			@"kind": @"IterationNode",
+			@"subtype" : @( static_cast<int>(IterationKind::integration) ),
+			@"variable": @( Variable().c_str() ),
+			@"start": start,
+			@"end": end,
+			@"content": content
+		}];
+		if (HasTolerance())
+		{
+			dict[@"tolerance"] = tolerance;
+		}
+		result = dict;
+	}
+	
+	return NS_CF( result );
+}
+
+bool	IntegralNode::operator==( const ASTNode& other ) const
+{
+	const IntegralNode* asMyType = dynamic_cast<const IntegralNode*>( &other );
+	bool isEqual = (asMyType != nullptr) and
+		(asMyType->Variable() == Variable()) and
+		(asMyType->HasTolerance() == HasTolerance()) and
+		(*asMyType->Children()[0] == *Children()[0]) and
+		(*asMyType->Children()[1] == *Children()[1]) and
+		(*asMyType->Children()[2] == *Children()[2]) and
+		( (not HasTolerance()) or
+			(*asMyType->Children()[3] == *Children()[3]) );
+	return isEqual;
+}
+
+
+autoASTNode	IntegralNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new IntegralNode( _variable, children[0], children[1],
+		children[2], (children.size() > 3)? children[3] : autoASTNode() ) );
+}
@@ -29,27 +29,87 @@
 #import "ASTNode.hpp"
 #import "Built-ins.hpp"
 
+#import <map>
+#import <string>
+#import <vector>
+
+/*!
+	@class		IndexVariableScope
+	
+	@abstract	Binds an index variable for the duration of an iteration.
+	
+	@discussion	Any value that the variable had in an enclosing iteration is
+				restored afterwards.  Since the variable stays in the map of
+				index variable values until then, its value can be updated
+				without looking it up again.
+*/
+class IndexVariableScope
+{
+public:
+			IndexVariableScope( SCalcState& state, const std::string& name );
+			IndexVariableScope( const IndexVariableScope& ) = delete;
+			~IndexVariableScope();
+	
+	double&	Value() { return _binding->second; }
+
+private:
+	SCalcState&								_state;
+	std::map< std::string, double >::iterator	_binding;
+	std::optional<double>					_savedValue;
+};
+
+/*!
+	@class		IterationNode
+	
+	@abstract	A sum or product over consecutive values of an index variable.
+	
+	@discussion	The children are the start value, the end value, the content,
+				and optionally a tolerance.  If the end value is infinite, the
+				limit of the partial sums or products is estimated using a
+				SeriesAccelerator, and the tolerance determines when to stop.
+				
+				An iteration that is not nested in another iteration records
+				its partial sums or products in the prefixSums of the state,
+				so that a later iteration over a longer range of the same
+				content only needs to evaluate the additional terms.  Ranges
+				of more than 65536 terms are not cached.
+*/
 class IterationNode : public ASTNode
 {
 public:
 			IterationNode( IterationKind kind,
 							const std::string& indexVariable,
 							autoASTNode start, autoASTNode end,
-							autoASTNode content )
-				: ASTNode{ start, end, content }
-				, _kind( kind )
-				, _indexVariable( indexVariable ) {}
+							autoASTNode content,
+							autoASTNode tolerance = autoASTNode() );
 	
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 	
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
 	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
 	IterationKind			Kind() const { return _kind; }
 	const std::string&		Variable() const { return _indexVariable; }
+	bool					HasTolerance() const { return _children.size() > 3; }
 
 private:
+	std::optional<double>	EvaluateInfinite( double startNum,
+											SCalcState& state ) const;
+	std::optional<double>	EvaluateByPrefixSums( double startNum,
+												double endNum,
+												SCalcState& state ) const;
+	std::optional<Dual>		EvaluateInfiniteDual( double startNum,
+												SCalcState& state ) const;
+	std::optional<double>	Tolerance( SCalcState& state ) const;
+
 	IterationKind			_kind;
 	std::string				_indexVariable;
+	
+	// Used to look up PrefixSums of the content.
+	size_t						_contentHash;
+	std::vector<unsigned int>	_contentParameters;
 };
@@ -29,8 +29,231 @@
 #import "IterationNode.hpp"
 
 #import "SCalcState.hpp"
+#import "SeriesAccelerator.hpp"
+#import "TreeUtilities.hpp"
 
 #import <Foundation/Foundation.h>
+#import <math.h>
+#import <tuple>
+
+// Default relative tolerance for an infinite sum or product.
+static constexpr double kDefaultSeriesTolerance = 1.0e-10;
+
+// Give up on an infinite sum or product that has not converged after this
+// many terms.
+static constexpr size_t kMaxSeriesTerms = 1 << 20;
+
+// Iterations with fewer terms than this are not worth caching.
+static constexpr double kMinCachedTerms = 16.0;
+
+// Nor are those with more terms than this, for the sake of memory.  The
+// cache persists between calculations, so together with the limit on entries
+// this keeps it under 8 MB.
+static constexpr double kMaxCachedTerms = 1 << 16;
+
+// If the prefix sum cache would get more entries than this, we clear it.
+static constexpr size_t kMaxPrefixSumEntries = 16;
+
+IndexVariableScope::IndexVariableScope( SCalcState& state,
+										const std::string& name )
+	: _state( state )
+{
+	bool isNew = false;
+	std::tie( _binding, isNew ) = state.indexVariableValues.try_emplace( name, 0.0 );
+	if (not isNew)
+	{
+		_savedValue = _binding->second;
+	}
+}
+
+IndexVariableScope::~IndexVariableScope()
+{
+	if (_savedValue.has_value())
+	{
+		_binding->second = _savedValue.value();
+	}
+	else
+	{
+		_state.indexVariableValues.erase( _binding );
+	}
+}
+
+IterationNode::IterationNode( IterationKind kind,
+							const std::string& indexVariable,
+							autoASTNode start, autoASTNode end,
+							autoASTNode content,
+							autoASTNode tolerance )
+	: ASTNode{ start, end, content }
+	, _kind( kind )
+	, _indexVariable( indexVariable )
+	, _contentHash( StructuralHash( *content ) )
+	, _contentParameters( UsedParameters( *content ) )
+{
+	if (tolerance)
+	{
+		_children.push_back( tolerance );
+	}
+}
+
+static PrefixSums&	FindPrefixSums( SCalcState& state,
+									const IterationNode& node,
+									size_t contentHash,
+									double startNum,
+									std::vector<double>& argumentValues )
+{
+	auto [ first, last ] = state.prefixSums.equal_range( contentHash );
+	for (auto it = first; it != last; ++it)
+	{
+		const PrefixSums& sums( it->second );
+		if ( (sums.kind == node.Kind()) and (sums.variable == node.Variable()) and
+			(sums.start == startNum) and (sums.argumentValues == argumentValues) and
+			(*sums.content == *node.Children()[2]) )
+		{
+			return it->second;
+		}
+	}
+	
+	if (state.prefixSums.size() >= kMaxPrefixSumEntries)
+	{
+		state.prefixSums.clear();
+	}
+	auto newIt = state.prefixSums.emplace( contentHash, PrefixSums{
+		node.Children()[2], node.Kind(), node.Variable(), startNum,
+		std::move( argumentValues ) } );
+	return newIt->second;
+}
+
+std::optional<double>	IterationNode::EvaluateByPrefixSums( double startNum,
+															double endNum,
+															SCalcState& state ) const
+{
+	std::optional<double> result;
+	std::vector<double> argumentValues;
+	argumentValues.reserve( _contentParameters.size() );
+	for (unsigned int paramIndex : _contentParameters)
+	{
+		if (paramIndex >= state.functionArguments.size())
+		{
+			return result;
+		}
+		argumentValues.push_back( state.functionArguments[ paramIndex ] );
+	}
+	
+	PrefixSums& sums( FindPrefixSums( state, *this, _contentHash, startNum,
+		argumentValues ) );
+	const size_t termCount = static_cast<size_t>( floor( endNum - startNum ) ) + 1;
+	
+	if (sums.partials.size() < termCount)
+	{
+		// While our index variable is bound, nested iterations do not use
+		// the cache, so sums stays put.
+		IndexVariableScope index( state, Variable() );
+		double total = sums.partials.empty()?
+			((Kind() == IterationKind::summation)? 0.0 : 1.0) :
+			sums.partials.back();
+		sums.partials.reserve( termCount );
+		
+		while (sums.partials.size() < termCount)
+		{
+			if (state.interruptCode != CalcInterruptCode::none)
+			{
+				break;
+			}
+			index.Value() = startNum + sums.partials.size();
+			std::optional<double> contentVal( _children[2]->Evaluate( state ) );
+			if (not contentVal.has_value())
+			{
+				break;
+			}
+			if (Kind() == IterationKind::summation)
+			{
+				total += contentVal.value();
+			}
+			else
+			{
+				total *= contentVal.value();
+			}
+			sums.partials.push_back( total );
+		}
+	}
+	
+	if (sums.partials.size() >= termCount)
+	{
+		result = sums.partials[ termCount - 1 ];
+	}
+	
+	return result;
+}
+
+// The tolerance of an infinite sum or product, or nothing if the given
+// tolerance is not positive.
+std::optional<double>	IterationNode::Tolerance( SCalcState& state ) const
+{
+	std::optional<double> tolerance( kDefaultSeriesTolerance );
+	
+	if (HasTolerance())
+	{
+		tolerance = _children[3]->Evaluate( state );
+		if ( tolerance.has_value() and (not (tolerance.value() > 0.0)) )
+		{
+			tolerance.reset();
+		}
+	}
+	
+	return tolerance;
+}
+
+std::optional<double>	IterationNode::EvaluateInfinite( double startNum,
+													SCalcState& state ) const
+{
+	std::optional<double> result;
+	std::optional<double> tolerance( Tolerance( state ) );
+	if (not tolerance.has_value())
+	{
+		return result;
+	}
+	
+	SeriesAccelerator accelerator( *tolerance );
+	double partial = (Kind() == IterationKind::summation)? 0.0 : 1.0;
+	bool isConverged = false;
+	IndexVariableScope index( state, Variable() );
+	
+	for (double i = startNum; accelerator.Count() < kMaxSeriesTerms; ++i)
+	{
+		if (state.interruptCode != CalcInterruptCode::none)
+		{
+			break;
+		}
+		index.Value() = i;
+		std::optional<double> contentVal( _children[2]->Evaluate( state ) );
+		if (not contentVal.has_value())
+		{
+			break;
+		}
+		if (Kind() == IterationKind::summation)
+		{
+			partial += contentVal.value();
+		}
+		else
+		{
+			partial *= contentVal.value();
+		}
+		if (accelerator.AddPartial( partial ))
+		{
+			isConverged = true;
+			break;
+		}
+	}
+	
+	if (isConverged)
+	{
+		result = accelerator.Estimate();
+		state.seriesTermCount += accelerator.Count();
+		state.seriesErrorEstimate += accelerator.ErrorEstimate();
+	}
+	
+	return result;
+}
 
 std::optional<double>	IterationNode::Evaluate( SCalcState& state ) const
 {
@@ -39,12 +262,27 @@ std::optional<double>	IterationNode::Evaluate( SCalcState& state ) const
 	std::optional<double> startVal( _children[0]->Evaluate( state ) );
 	std::optional<double> endVal( _children[1]->Evaluate( state ) );
 	
-	if (startVal.has_value() and endVal.has_value())
+	if ( startVal.has_value() and endVal.has_value() and
+		isfinite( startVal.value() ) )
 	{
+		if (isinf( endVal.value() ) and (endVal.value() > 0.0))
+		{
+			return EvaluateInfinite( startVal.value(), state );
+		}
 		double startNum = startVal.value();
 		double endNum = endVal.value();
+		
+		// Only an outermost iteration can reuse partial sums.
+		if ( state.indexVariableValues.empty() and
+			(endNum - startNum + 1.0 >= kMinCachedTerms) and
+			(endNum - startNum < kMaxCachedTerms) )
+		{
+			return EvaluateByPrefixSums( startNum, endNum, state );
+		}
+		
 		double total = (Kind() == IterationKind::summation)? 0.0 : 1.0;
 		BOOL allEvaluated = YES;
+		IndexVariableScope index( state, Variable() );
 		
 		for (double i = startNum; i <= endNum; ++i)
 		{
@@ -53,7 +291,7 @@ std::optional<double>	IterationNode::Evaluate( SCalcState& state ) const
 				allEvaluated = NO;
 				break;
 			}
-			state.indexVariableValues[ Variable() ] = i;
+			index.Value() = i;
 			std::optional<double> contentVal( _children[2]->Evaluate( state ) );
 			if (contentVal.has_value())
 			{
@@ -73,7 +311,6 @@ std::optional<double>	IterationNode::Evaluate( SCalcState& state ) const
 				break;
 			}
 		}
-		state.indexVariableValues.erase( Variable() );
 		
 		if (allEvaluated)
 		{
@@ -84,6 +321,137 @@ std::optional<double>	IterationNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+static void Accumulate( IterationKind inKind, Dual& ioTotal, const Dual& inTerm )
+{
+	if (inKind == IterationKind::summation)
+	{
+		ioTotal.value += inTerm.value;
+		ioTotal.derivative += inTerm.derivative;
+	}
+	else
+	{
+		ioTotal.derivative = fma( ioTotal.derivative, inTerm.value,
+			ioTotal.value * inTerm.derivative );
+		ioTotal.value *= inTerm.value;
+	}
+}
+
+// The partial sums or products and their derivatives are accelerated
+// separately.  If the derivatives of the terms have all been zero, the
+// derivative is taken to have converged along with the value.
+std::optional<Dual>	IterationNode::EvaluateInfiniteDual( double startNum,
+														SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	std::optional<double> tolerance( Tolerance( state ) );
+	if (not tolerance.has_value())
+	{
+		return result;
+	}
+	
+	SeriesAccelerator valueAccelerator( *tolerance );
+	SeriesAccelerator derivativeAccelerator( *tolerance );
+	bool isValueConverged = false;
+	bool isDerivativeConverged = false;
+	bool hasDerivative = false;
+	Dual partial{ (Kind() == IterationKind::summation)? 0.0 : 1.0, 0.0 };
+	IndexVariableScope index( state, Variable() );
+	
+	for (double i = startNum; valueAccelerator.Count() < kMaxSeriesTerms; ++i)
+	{
+		if (state.interruptCode != CalcInterruptCode::none)
+		{
+			break;
+		}
+		index.Value() = i;
+		std::optional<Dual> contentVal( _children[2]->EvaluateDual( state ) );
+		if (not contentVal.has_value())
+		{
+			break;
+		}
+		Accumulate( Kind(), partial, *contentVal );
+		hasDerivative = hasDerivative or (partial.derivative != 0.0);
+		
+		if (not isValueConverged)
+		{
+			isValueConverged = valueAccelerator.AddPartial( partial.value );
+		}
+		if ( hasDerivative and (not isDerivativeConverged) )
+		{
+			isDerivativeConverged = derivativeAccelerator.AddPartial(
+				partial.derivative );
+		}
+		if ( isValueConverged and (isDerivativeConverged or (not hasDerivative)) )
+		{
+			result = Dual{ valueAccelerator.Estimate(),
+				hasDerivative? derivativeAccelerator.Estimate() : 0.0 };
+			break;
+		}
+	}
+	
+	if (result.has_value())
+	{
+		state.seriesTermCount += valueAccelerator.Count();
+		state.seriesErrorEstimate += valueAccelerator.ErrorEstimate();
+	}
+	
+	return result;
+}
+
+std::optional<Dual>	IterationNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	// If the content does not involve the parameters, neither does the
+	// result, since the bounds only take integer steps.  That does not hold
+	// when differentiating by an index variable of an enclosing equation.
+	if (_contentParameters.empty() and (state.dualIndexVariable == nullptr))
+	{
+		std::optional<double> value( Evaluate( state ) );
+		if (value.has_value())
+		{
+			result = Dual{ *value, 0.0 };
+		}
+		return result;
+	}
+	
+	std::optional<Dual> startVal( _children[0]->EvaluateDual( state ) );
+	std::optional<Dual> endVal( _children[1]->EvaluateDual( state ) );
+	
+	if ( startVal.has_value() and endVal.has_value() and
+		isfinite( startVal->value ) )
+	{
+		const double startNum = startVal->value;
+		const double endNum = endVal->value;
+		if (isinf( endNum ) and (endNum > 0.0))
+		{
+			return EvaluateInfiniteDual( startNum, state );
+		}
+		
+		Dual total{ (Kind() == IterationKind::summation)? 0.0 : 1.0, 0.0 };
+		IndexVariableScope index( state, Variable() );
+		
+		for (double i = startNum; i <= endNum; ++i)
+		{
+			if (state.interruptCode != CalcInterruptCode::none)
+			{
+				return result;
+			}
+			index.Value() = i;
+			std::optional<Dual> contentVal( _children[2]->EvaluateDual( state ) );
+			if (not contentVal.has_value())
+			{
+				return result;
+			}
+			Accumulate( Kind(), total, *contentVal );
+		}
+		
+		result = total;
+	}
+	
+	return result;
+}
+
 autoCFDictionaryRef		IterationNode::ToDictionary() const
 {
 	NSDictionary* result = nil;
@@ -91,16 +459,25 @@ autoCFDictionaryRef		IterationNode::ToDictionary() const
 	NSDictionary* end = CF_NS(_children[1]->ToDictionary());
 	NSDictionary* content = CF_NS(_children[2]->ToDictionary());
 	
-	if ( (start != nil) and (end != nil) and (content != nil) )
+	NSDictionary* tolerance = HasTolerance()?
+		CF_NS(_children[3]->ToDictionary()) : @{};
+	
+	if ( (start != nil) and (end != nil) and (content != nil) and
+		(tolerance != nil) )
 	{
-		result = @{
+		NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithDictionary: @{
 			@"kind": @"IterationNode",
 			@"subtype" : @( static_cast<int>(Kind()) ),
 			@"variable": @( Variable().c_str() ),
 			@"start": start,
 			@"end": end,
 			@"content": content
-		};
+		}];
+		if (HasTolerance())
+		{
+			dict[@"tolerance"] = tolerance;
+		}
+		result = dict;
 	}
 	
 	return NS_CF( result );
@@ -112,8 +489,19 @@ bool	IterationNode::operator==( const ASTNode& other ) const
 	bool isEqual = (asMyType != nullptr) and
 		(asMyType->Kind() == Kind()) and
 		(asMyType->Variable() == Variable()) and
+		(asMyType->HasTolerance() == HasTolerance()) and
 		(*asMyType->Children()[0] == *Children()[0]) and
 		(*asMyType->Children()[1] == *Children()[1]) and
-		(*asMyType->Children()[2] == *Children()[2]);
+		(*asMyType->Children()[2] == *Children()[2]) and
+		( (not HasTolerance()) or
+			(*asMyType->Children()[3] == *Children()[3]) );
 	return isEqual;
 }
+
+
+autoASTNode	IterationNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new IterationNode( _kind, _indexVariable,
+		children[0], children[1], children[2],
+		(children.size() > 3)? children[3] : autoASTNode() ) );
+}
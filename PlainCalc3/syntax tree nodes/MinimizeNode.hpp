@@ -0,0 +1,70 @@
+//  MinimizeNode.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef MinimizeNode_hpp
+#define MinimizeNode_hpp
+
+#import "ASTNode.hpp"
+#import <string>
+
+/*!
+	@class		MinimizeNode
+	@abstract	The minimum value of a user function of n variables.
+	@discussion	If there are n children, they are a starting point for the
+				Nelder-Mead method.  If there are 2n children, they are pairs
+				of lower and upper bounds of a box, and the search starts
+				from several points spread over the box, in parallel when
+				possible.  In one dimension, the interval is divided into
+				parts, each searched by Brent's method.
+				
+				The location of the minimum is recorded in the state.
+*/
+class MinimizeNode : public ASTNode
+{
+public:
+			MinimizeNode( const std::string& funcName, const ASTNodeVec& args )
+				: ASTNode( args )
+				, _funcName( funcName ) {}
+	
+	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
+	
+	autoCFDictionaryRef		ToDictionary() const override;
+	
+	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	const std::string&		FuncName() const { return _funcName; }
+
+private:
+	std::string				_funcName;
+};
+
+#endif /* MinimizeNode_hpp */
@@ -0,0 +1,232 @@
+//  MinimizeNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "MinimizeNode.hpp"
+
+#import "Minimizer.hpp"
+#import "ParallelEvaluation.hpp"
+#import "SCalcState.hpp"
+#import "UserFuncNode.hpp"
+
+#import <Foundation/Foundation.h>
+
+#import <algorithm>
+
+// Number of starting points, or of parts of an interval, searched when
+// minimizing over a box.
+static constexpr size_t kStartCount = 16;
+
+// Size of the initial simplex of a start within a box, relative to the box.
+static constexpr double kRelativeSimplexSize = 0.1;
+
+std::optional<double>	MinimizeNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	
+	auto defIt = state.userFunctions.find( _funcName );
+	if (defIt == state.userFunctions.end())
+	{
+		return result;
+	}
+	const size_t n = std::get<StringVec>( defIt->second ).size();
+	
+	std::vector<double> values;
+	values.reserve( _children.size() );
+	for (const autoASTNode& child : _children)
+	{
+		std::optional<double> value( child->Evaluate( state ) );
+		if (not value.has_value())
+		{
+			return result;
+		}
+		values.push_back( *value );
+	}
+	
+	const bool isBox = (values.size() == 2 * n);
+	if ( (n == 0) or ((values.size() != n) and (not isBox)) )
+	{
+		return result;
+	}
+	std::vector<double> low, high;
+	if (isBox)
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			low.push_back( std::min( values[2*i], values[2*i+1] ) );
+			high.push_back( std::max( values[2*i], values[2*i+1] ) );
+		}
+	}
+	
+	// Each start uses only the state it is given, so that starts can run on
+	// separate threads.
+	const size_t startCount = isBox? kStartCount : 1;
+	std::vector< std::optional<MinimumResult> > minima( startCount );
+	auto job = [&]( SCalcState& jobState, size_t inIndex )
+	{
+		std::vector<double> arguments;
+		ObjectiveFunction func = [&]( const std::vector<double>& inX )
+		{
+			arguments = inX;
+			return UserFuncNode::Call( _funcName, arguments, jobState );
+		};
+		
+		if (not isBox)
+		{
+			minima[ inIndex ] = MinimizeFromPoint( func, values,
+				DefaultSimplexSteps( values ) );
+		}
+		else if (n == 1)
+		{
+			const double width = (high[0] - low[0]) / startCount;
+			minima[ inIndex ] = MinimizeOnInterval( func,
+				low[0] + inIndex * width, low[0] + (inIndex + 1) * width );
+		}
+		else
+		{
+			std::vector<double> start( HaltonPoint( inIndex + 1, low, high ) );
+			std::vector<double> steps( DefaultSimplexSteps( start ) );
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (high[i] > low[i])
+				{
+					steps[i] = kRelativeSimplexSize * (high[i] - low[i]);
+				}
+			}
+			minima[ inIndex ] = MinimizeFromPoint( func, start, steps );
+		}
+	};
+	
+	if ( (state.parallel != nullptr) and (startCount > 1) )
+	{
+		state.parallel->RunAll( state, startCount, job );
+	}
+	else
+	{
+		for (size_t i = 0; i < startCount; ++i)
+		{
+			job( state, i );
+		}
+	}
+	
+	if (state.interruptCode != CalcInterruptCode::none)
+	{
+		return result;
+	}
+	const MinimumResult* best = nullptr;
+	size_t evaluationCount = 0;
+	for (const std::optional<MinimumResult>& minimum : minima)
+	{
+		if (not minimum.has_value())
+		{
+			return result;
+		}
+		evaluationCount += minimum->evaluationCount;
+		if ( (best == nullptr) or (minimum->value < best->value) )
+		{
+			best = &*minimum;
+		}
+	}
+	
+	result = best->value;
+	state.minimizerEvaluationCount += evaluationCount;
+	state.minimumLocation = best->location;
+	
+	return result;
+}
+
+// Where the function is smooth, its minimum value does not change to first
+// order as the starting point moves.
+std::optional<Dual>	MinimizeNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	for (const autoASTNode& child : _children)
+	{
+		std::optional<Dual> value( child->EvaluateDual( state ) );
+		if ( (not value.has_value()) or (value->derivative != 0.0) )
+		{
+			return result;
+		}
+	}
+	
+	std::optional<double> value( Evaluate( state ) );
+	if (value.has_value())
+	{
+		result = Dual{ *value, 0.0 };
+	}
+	
+	return result;
+}
+
+
+autoCFDictionaryRef	MinimizeNode::ToDictionary() const
+{
+	NSDictionary* result = nil;
+	
+	NSMutableArray<NSDictionary*>* dicts = [NSMutableArray array];
+	for (const autoASTNode& aNode : _children)
+	{
+		NSDictionary* argDict = CF_NS(aNode->ToDictionary());
+		if (argDict == nil)
+		{
+			return NS_CF( result );
+		}
+		[dicts addObject: argDict];
+	}
+	
+	result = @{
+		@"kind": @"Minimize",
+		@"function": @(_funcName.c_str()),
+		@"args": dicts
+	};
+	
+	return NS_CF( result );
+}
+
+
+bool	MinimizeNode::operator==( const ASTNode& other ) const
+{
+	const MinimizeNode* asMyType = dynamic_cast<const MinimizeNode*>( &other );
+	bool isEqual = (asMyType != nullptr) and
+		(asMyType->_funcName == _funcName) and
+		(asMyType->Children().size() == Children().size());
+	
+	for (size_t i = 0; isEqual and (i < Children().size()); ++i)
+	{
+		isEqual = (*Children()[i] == *asMyType->Children()[i]);
+	}
+	
+	return isEqual;
+}
+
+
+autoASTNode	MinimizeNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new MinimizeNode( _funcName, children ) );
+}
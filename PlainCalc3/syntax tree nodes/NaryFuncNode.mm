@@ -29,7 +29,9 @@
 #import "NaryFuncNode.hpp"
 
 #import "Built-ins.hpp"
+#import "Differentiation.hpp"
 #import "SCalcState.hpp"
+#import "ParallelEvaluation.hpp"
 
 #import <Foundation/Foundation.h>
 
@@ -39,20 +41,41 @@ std::optional<double>	NaryFuncNode::Evaluate( SCalcState& state ) const
 	
 	bool didEvaluateAll = true;
 	
-	std::vector<double> actualValues;
-	actualValues.reserve( _children.size() );
+	ScratchArguments scratch( state );
+	std::vector<double>& actualValues( scratch.Arguments() );
 	
-	for (autoASTNode oneArg : _children)
+	if ( (state.parallel != nullptr) and state.parallel->ShouldSpawn( state, _children ) )
 	{
-		std::optional<double> argVal = oneArg->Evaluate( state );
-		if (argVal.has_value())
+		std::vector< std::optional<double> > argVals( _children.size() );
+		state.parallel->EvaluateAll( state, _children, argVals.data() );
+		
+		for (const std::optional<double>& argVal : argVals)
 		{
-			actualValues.push_back( argVal.value() );
+			if (argVal.has_value())
+			{
+				actualValues.push_back( argVal.value() );
+			}
+			else
+			{
+				didEvaluateAll = false;
+				break;
+			}
 		}
-		else
+	}
+	else
+	{
+		for (autoASTNode oneArg : _children)
 		{
-			didEvaluateAll = false;
-			break;
+			std::optional<double> argVal = oneArg->Evaluate( state );
+			if (argVal.has_value())
+			{
+				actualValues.push_back( argVal.value() );
+			}
+			else
+			{
+				didEvaluateAll = false;
+				break;
+			}
 		}
 	}
 	
@@ -64,6 +87,31 @@ std::optional<double>	NaryFuncNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	NaryFuncNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::vector<Dual> actualValues;
+	actualValues.reserve( _children.size() );
+	
+	for (const autoASTNode& oneArg : _children)
+	{
+		std::optional<Dual> argVal( oneArg->EvaluateDual( state ) );
+		if (not argVal.has_value())
+		{
+			break;
+		}
+		actualValues.push_back( *argVal );
+	}
+	
+	if (actualValues.size() == _children.size())
+	{
+		result = ApplyNary( _func, actualValues );
+	}
+	
+	return result;
+}
+
 
 autoCFDictionaryRef	NaryFuncNode::ToDictionary() const
 {
@@ -134,3 +182,9 @@ bool	NaryFuncNode::operator==( const ASTNode& other ) const
 	}
 	return isEqual;
 }
+
+
+autoASTNode	NaryFuncNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new NaryFuncNode( _func, children ) );
+}
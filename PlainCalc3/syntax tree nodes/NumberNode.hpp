@@ -38,11 +38,14 @@ public:
 				: _number( number ) {}
 	
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 	
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
 	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
 	double					Value() const { return _number; }
 
 private:
@@ -35,6 +35,11 @@ std::optional<double>	NumberNode::Evaluate( SCalcState& state ) const
 	return std::optional<double>( _number );
 }
 
+std::optional<Dual>	NumberNode::EvaluateDual( SCalcState& state ) const
+{
+	return Dual{ _number, 0.0 };
+}
+
 
 autoCFDictionaryRef	NumberNode::ToDictionary() const
 {
@@ -51,3 +56,9 @@ bool	NumberNode::operator==( const ASTNode& other ) const
 	return (asMyType != nullptr) and
 		(asMyType->Value() == Value());
 }
+
+
+autoASTNode	NumberNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return MakeNode<NumberNode>( _number );
+}
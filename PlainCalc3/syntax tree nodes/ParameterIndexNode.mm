@@ -44,6 +44,18 @@ std::optional<double>	ParameterIndexNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	ParameterIndexNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	if (_index < state.dualArguments.size())
+	{
+		result = state.dualArguments[ _index ];
+	}
+	
+	return result;
+}
+
 autoCFDictionaryRef	ParameterIndexNode::ToDictionary() const
 {
 	NSDictionary* result = @{
@@ -60,3 +72,9 @@ bool	ParameterIndexNode::operator==( const ASTNode& other ) const
 	return (asMyType != nullptr) and
 		(asMyType->Index() == Index());
 }
+
+
+autoASTNode	ParameterIndexNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new ParameterIndexNode( _index ) );
+}
@@ -0,0 +1,83 @@
+//  PolynomialNode.hpp
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef PolynomialNode_hpp
+#define PolynomialNode_hpp
+
+#import "ASTNode.hpp"
+
+#import <vector>
+
+/*!
+	@class		PolynomialNode
+	
+	@abstract	A polynomial in one variable, with constant coefficients.
+	
+	@discussion	The single child is the variable, usually a parameter of a
+				user function.  The coefficients are stored in order of
+				increasing degree, and the leading coefficient is not zero.
+				Low degrees are evaluated by Horner's rule, and higher degrees
+				by Estrin's scheme, which has more independent operations for
+				the processor to overlap.  Both use fused multiply-add.
+				
+				These nodes are made by CompilePolynomial, not by the parser.
+*/
+class PolynomialNode : public ASTNode
+{
+public:
+	/// Highest degree that we represent.
+	static constexpr size_t	kMaxDegree = 32;
+	
+			PolynomialNode( autoASTNode variable,
+							const std::vector<double>& coefficients )
+				: ASTNode{ variable }
+				, _coefficients( coefficients ) {}
+	
+	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
+	
+	autoCFDictionaryRef		ToDictionary() const override;
+	
+	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	const std::vector<double>&	Coefficients() const { return _coefficients; }
+	size_t					Degree() const { return _coefficients.size() - 1; }
+	
+	/*!
+		@function	EvaluateAt
+		@abstract	Evaluate the polynomial at a given value of the variable.
+	*/
+	double					EvaluateAt( double x ) const noexcept;
+
+private:
+	std::vector<double>		_coefficients;
+};
+
+#endif /* PolynomialNode_hpp */
@@ -0,0 +1,153 @@
+//  PolynomialNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+#import "PolynomialNode.hpp"
+
+#import <Foundation/Foundation.h>
+#import <math.h>
+
+// Degree at which we switch from Horner's rule to Estrin's scheme.  Below
+// this, the dependency chain of Horner's rule is short enough not to matter.
+static constexpr size_t kMinEstrinDegree = 8;
+
+double	PolynomialNode::EvaluateAt( double x ) const noexcept
+{
+	const double* c = _coefficients.data();
+	const size_t degree = Degree();
+	double result;
+	
+	if (degree < kMinEstrinDegree)
+	{
+		result = c[ degree ];
+		for (size_t i = degree; i-- > 0; )
+		{
+			result = fma( result, x, c[i] );
+		}
+	}
+	else
+	{
+		// Combine coefficients in pairs using x, then pairs of those using
+		// x^2, then x^4, and so on.
+		double terms[ kMaxDegree / 2 + 1 ];
+		size_t termCount = 0;
+		for (size_t i = 0; i <= degree; i += 2)
+		{
+			terms[ termCount++ ] = (i < degree)? fma( c[i + 1], x, c[i] ) : c[i];
+		}
+		
+		double power = x * x;
+		while (termCount > 1)
+		{
+			size_t combined = 0;
+			for (size_t i = 0; i < termCount; i += 2)
+			{
+				terms[ combined++ ] = (i + 1 < termCount)?
+					fma( terms[i + 1], power, terms[i] ) : terms[i];
+			}
+			termCount = combined;
+			power *= power;
+		}
+		result = terms[0];
+	}
+	
+	return result;
+}
+
+std::optional<double>	PolynomialNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	std::optional<double> variableValue( _children[0]->Evaluate( state ) );
+	
+	if (variableValue.has_value())
+	{
+		result = EvaluateAt( variableValue.value() );
+	}
+	
+	return result;
+}
+
+// The value and derivative by Horner's method, where the derivative with
+// respect to the variable is accumulated alongside the value.
+std::optional<Dual>	PolynomialNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	std::optional<Dual> variableValue( _children[0]->EvaluateDual( state ) );
+	
+	if (variableValue.has_value())
+	{
+		const double x = variableValue->value;
+		double value = _coefficients.back();
+		double slope = 0.0;
+		for (size_t i = _coefficients.size() - 1; i > 0; --i)
+		{
+			slope = fma( slope, x, value );
+			value = fma( value, x, _coefficients[ i - 1 ] );
+		}
+		result = Dual{ value, slope * variableValue->derivative };
+	}
+	
+	return result;
+}
+
+autoCFDictionaryRef		PolynomialNode::ToDictionary() const
+{
+	NSDictionary* result = nil;
+	NSDictionary* variable = CF_NS(_children[0]->ToDictionary());
+	
+	if (variable != nil)
+	{
+		NSMutableArray<NSNumber*>* coefficients =
+			[NSMutableArray arrayWithCapacity: _coefficients.size()];
+		for (double coeff : _coefficients)
+		{
+			[coefficients addObject: @(coeff)];
+		}
+		
+		result = @{
+			@"kind": @"Polynomial",
+			@"variable": variable,
+			@"coefficients": coefficients
+		};
+	}
+	
+	return NS_CF( result );
+}
+
+bool	PolynomialNode::operator==( const ASTNode& other ) const
+{
+	const PolynomialNode* asMyType = dynamic_cast<const PolynomialNode*>( &other );
+	return (asMyType != nullptr) and
+		(asMyType->Coefficients() == Coefficients()) and
+		(*asMyType->Children()[0] == *Children()[0]);
+}
+
+
+autoASTNode	PolynomialNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new PolynomialNode( children[0], _coefficients ) );
+}
@@ -0,0 +1,234 @@
+//  SolveNode.mm
+//  PlainCalc3
+//
+//  Created by James Walker on 10/19/26.
+//  
+//
+/*
+	Copyright (c) 2026 James W. Walker
+
+	This software is provided 'as-is', without any express or implied warranty.
+	In no event will the authors be held liable for any damages arising from
+	the use of this software.
+
+	Permission is granted to anyone to use this software for any purpose,
+	including commercial applications, and to alter it and redistribute it
+	freely, subject to the following restrictions:
+
+	1.	The origin of this software must not be misrepresented; you must not
+		claim that you wrote the original software. If you use this software
+		in a product, an acknowledgment in the product documentation would be
+		appreciated but is not required.
+
+	2.	Altered source versions must be plainly marked as such, and must not be
+		misrepresented as being the original software.
+
+	3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#import "SolveNode.hpp"
+
+#import "IterationNode.hpp"
+#import "RootFinder.hpp"
+#import "SCalcState.hpp"
+
+#import <Foundation/Foundation.h>
+#import <math.h>
+
+SolveNode::SolveNode( const std::string& variable,
+						autoASTNode low, autoASTNode high,
+						autoASTNode content,
+						autoASTNode tolerance )
+	: ASTNode{ low, high, content }
+	, _variable( variable )
+{
+	if (tolerance)
+	{
+		_children.push_back( tolerance );
+	}
+}
+
+// The tolerance, or nothing if the given tolerance is negative.
+std::optional<double>	SolveNode::Tolerance( SCalcState& state ) const
+{
+	std::optional<double> tolerance( 0.0 );
+	
+	if (HasTolerance())
+	{
+		tolerance = _children[3]->Evaluate( state );
+		if ( tolerance.has_value() and (not (tolerance.value() >= 0.0)) )
+		{
+			tolerance.reset();
+		}
+	}
+	
+	return tolerance;
+}
+
+// The content and its derivative with respect to the variable, at the
+// current value of the variable, holding any parameters constant.
+std::optional<Dual>	SolveNode::ContentWithDerivative( SCalcState& state ) const
+{
+	std::vector<Dual> constantArgs;
+	constantArgs.reserve( state.functionArguments.size() );
+	for (double arg : state.functionArguments)
+	{
+		constantArgs.push_back( Dual{ arg, 0.0 } );
+	}
+	const std::string* savedVariable = state.dualIndexVariable;
+	
+	state.dualArguments.swap( constantArgs );
+	state.dualIndexVariable = &_variable;
+	std::optional<Dual> result( _children[2]->EvaluateDual( state ) );
+	state.dualArguments.swap( constantArgs );
+	state.dualIndexVariable = savedVariable;
+	
+	return result;
+}
+
+std::optional<double>	SolveNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	
+	std::optional<double> lowVal( _children[0]->Evaluate( state ) );
+	std::optional<double> highVal( _children[1]->Evaluate( state ) );
+	std::optional<double> tolerance( Tolerance( state ) );
+	if ( (not lowVal.has_value()) or (not highVal.has_value()) or
+		(not tolerance.has_value()) )
+	{
+		return result;
+	}
+	
+	IndexVariableScope variable( state, _variable );
+	const autoASTNode& content( _children[2] );
+	
+	// Evaluating the derivative for Newton steps takes more time, so if it
+	// is ever unavailable, we stop trying.
+	bool useDerivative = true;
+	
+	RootFunction func = [&]( double inX ) -> std::optional<Dual>
+	{
+		std::optional<Dual> value;
+		if (state.interruptCode != CalcInterruptCode::none)
+		{
+			return value;
+		}
+		variable.Value() = inX;
+		if (useDerivative)
+		{
+			value = ContentWithDerivative( state );
+			useDerivative = value.has_value();
+		}
+		if (not value.has_value())
+		{
+			std::optional<double> plainValue( content->Evaluate( state ) );
+			if (plainValue.has_value())
+			{
+				value = Dual{ *plainValue, NAN };
+			}
+		}
+		return value;
+	};
+	
+	std::optional<RootResult> root( FindRoot( func, *lowVal, *highVal,
+		*tolerance ) );
+	if (root.has_value())
+	{
+		result = root->root;
+		state.solverEvaluationCount += root->evaluationCount;
+	}
+	
+	return result;
+}
+
+// If f(x, p) = 0 defines x as a function of the parameter p, then by
+// implicit differentiation, dx/dp = - (∂f/∂p) / (∂f/∂x).  The ends of the
+// interval do not matter as long as they bracket the same zero.
+std::optional<Dual>	SolveNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<double> root( Evaluate( state ) );
+	if (not root.has_value())
+	{
+		return result;
+	}
+	
+	IndexVariableScope variable( state, _variable );
+	variable.Value() = *root;
+	std::optional<Dual> byParameter( _children[2]->EvaluateDual( state ) );
+	if (not byParameter.has_value())
+	{
+		return result;
+	}
+	
+	if (byParameter->derivative == 0.0)
+	{
+		result = Dual{ *root, 0.0 };
+	}
+	else
+	{
+		std::optional<Dual> byVariable( ContentWithDerivative( state ) );
+		if ( byVariable.has_value() and (byVariable->derivative != 0.0) )
+		{
+			result = Dual{ *root,
+				- byParameter->derivative / byVariable->derivative };
+		}
+	}
+	
+	return result;
+}
+
+autoCFDictionaryRef		SolveNode::ToDictionary() const
+{
+	NSDictionary* result = nil;
+	NSDictionary* low = CF_NS(_children[0]->ToDictionary());
+	NSDictionary* high = CF_NS(_children[1]->ToDictionary());
+	NSDictionary* content = CF_NS(_children[2]->ToDictionary());
+	
+	NSDictionary* tolerance = HasTolerance()?
+		CF_NS(_children[3]->ToDictionary()) : @{};
+	
+	if ( (low != nil) and (high != nil) and (content != nil) and
+		(tolerance != nil) )
+	{
+		// Recorded like a sum or product, with its own subtype.
+		NSMutableDictionary* dict = [NSMutableDictionary dictionaryWithDictionary: @{
+			@"kind": @"IterationNode",
+			@"subtype" : @( static_cast<int>(IterationKind::rootFinding) ),
+			@"variable": @( Variable().c_str() ),
+			@"start": low,
+			@"end": high,
+			@"content": content
+		}];
+		if (HasTolerance())
+		{
+			dict[@"tolerance"] = tolerance;
+		}
+		result = dict;
+	}
+	
+	return NS_CF( result );
+}
+
+bool	SolveNode::operator==( const ASTNode& other ) const
+{
+	const SolveNode* asMyType = dynamic_cast<const SolveNode*>( &other );
+	bool isEqual = (asMyType != nullptr) and
+		(asMyType->Variable() == Variable()) and
+		(asMyType->HasTolerance() == HasTolerance()) and
+		(*asMyType->Children()[0] == *Children()[0]) and
+		(*asMyType->Children()[1] == *Children()[1]) and
+		(*asMyType->Children()[2] == *Children()[2]) and
+		( (not HasTolerance()) or
+			(*asMyType->Children()[3] == *Children()[3]) );
+	return isEqual;
+}
+
+
+autoASTNode	SolveNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new SolveNode( _variable, children[0], children[1],
+		children[2], (children.size() > 3)? children[3] : autoASTNode() ) );
+}
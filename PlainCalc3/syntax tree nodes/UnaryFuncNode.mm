@@ -30,6 +30,7 @@
 
 #import "BasicMath.hpp"
 #import "Built-ins.hpp"
+#import "Differentiation.hpp"
 #import "SCalcState.hpp"
 
 #import <Foundation/Foundation.h>
@@ -48,6 +49,20 @@ std::optional<double>	UnaryFuncNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	UnaryFuncNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	
+	std::optional<Dual> paramValue( _children[0]->EvaluateDual( state ) );
+	
+	if (paramValue.has_value())
+	{
+		result = ApplyUnary( _func, *paramValue );
+	}
+	
+	return result;
+}
+
 
 autoCFDictionaryRef	UnaryFuncNode::ToDictionary() const
 {
@@ -96,3 +111,9 @@ bool	UnaryFuncNode::operator==( const ASTNode& other ) const
 		(*asMyType->Children()[0] == *Children()[0]);
 	return isEqual;
 }
+
+
+autoASTNode	UnaryFuncNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new UnaryFuncNode( _func, children[0] ) );
+}
@@ -44,10 +44,46 @@ public:
 					, _funcName( funcName ) {}
 
 	std::optional<double>	Evaluate( SCalcState& state ) const override;
+	std::optional<Dual>		EvaluateDual( SCalcState& state ) const override;
 
 	autoCFDictionaryRef		ToDictionary() const override;
 	
 	bool					operator==( const ASTNode& other ) const override;
+	
+	autoASTNode				CloneWithChildren( const ASTNodeVec& children ) const override;
+	
+	const std::string&		FuncName() const { return _funcName; }
+	
+	/*!
+		@function	Call
+		@abstract	Evaluate a user function at given arguments.
+		@param		inName			Name of the function.
+		@param		ioArguments		Arguments of the function.  The vector is
+									used as scratch space, but has the same
+									contents on return.
+		@param		state			The calculator state.
+		@result		The result, or nothing if the function could not be
+					evaluated.
+	*/
+	static std::optional<double>	Call( const std::string& inName,
+										std::vector<double>& ioArguments,
+										SCalcState& state );
+	
+	/*!
+		@function	CallDual
+		@abstract	Evaluate a user function and its derivative at dual
+					arguments.
+		@param		inName			Name of the function.
+		@param		ioArguments		Arguments of the function.  The vector is
+									used as scratch space, but has the same
+									contents on return.
+		@param		state			The calculator state.
+		@result		The dual result, or nothing if the function could not be
+					evaluated or differentiated.
+	*/
+	static std::optional<Dual>	CallDual( const std::string& inName,
+										std::vector<Dual>& ioArguments,
+										SCalcState& state );
 
 private:
 	std::string					_funcName;
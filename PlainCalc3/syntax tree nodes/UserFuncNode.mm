@@ -28,43 +28,174 @@
 
 #import "UserFuncNode.hpp"
 
-#import "Lookup.hpp"
 #import "SCalcState.hpp"
+#import "ChebyshevApproximant.hpp"
 #import "GetStackSize.hpp"
+#import "ParallelEvaluation.hpp"
+#import "LinearRecurrence.hpp"
+#import "RecursionTable.hpp"
 
 #import <Foundation/Foundation.h>
 
 #import <algorithm>
 
-static constexpr size_t kStackLimit = 1048576U; // 1 megabyte
-
-std::optional<double>	UserFuncNode::Evaluate( SCalcState& state ) const
+// During a parallel evaluation, all threads share one cache of results.
+static std::optional<double> FindCachedResult( SCalcState& state,
+												const UserFuncCacheKeyView& key )
 {
 	std::optional<double> result;
 	
-	state.maxStack = std::max( state.maxStack, GetStackSize() );
+	if (state.parallel != nullptr)
+	{
+		result = state.parallel->ResultCache().Find( key );
+	}
+	else
+	{
+		auto foundIt = state.resultCache.find( key );
+		if (foundIt != state.resultCache.end())
+		{
+			result = foundIt->second;
+		}
+	}
 	
-	if (state.suppressUserFuncEvaluation > 0)
+	return result;
+}
+
+static void CacheResult( SCalcState& state, UserFuncCacheKey&& key, double value )
+{
+	if (state.parallel != nullptr)
 	{
-		return result;
+		state.parallel->ResultCache().Insert( std::move(key), value );
 	}
-	else if (state.interruptCode != CalcInterruptCode::none)
+	else
 	{
-		return result;
+		state.resultCache.emplace( std::move(key), value );
 	}
-	else if (state.maxStack > kStackLimit )
+}
+
+// Checks made before each call of a user function.  Returns false if the
+// calculation should not go on.
+static bool CanCall( SCalcState& state )
+{
+	state.maxStack = std::max( state.maxStack, GetStackSize() );
+	
+	bool canCall = (state.suppressUserFuncEvaluation == 0) and
+		(state.interruptCode == CalcInterruptCode::none) and
+		not ( (state.parallel != nullptr) and state.parallel->IsInterrupted( state ) );
+	
+	if (canCall and (state.maxStack > GetStackLimit()))
 	{
 		state.interruptCode = CalcInterruptCode::stackLimit;
-		return result;
+		canCall = false;
+	}
+	
+	return canCall;
+}
+
+// Prefer the compiled form of the function body, in which calls to small
+// functions have been inlined.  A specialized function only exists in
+// compiled form.
+static autoASTNode FindBody( const std::string& inName, SCalcState& state,
+							const CompiledFunc*& outCompiled )
+{
+	autoASTNode rhs;
+	outCompiled = nullptr;
+	auto compiledIt = state.compiledFunctions.find( inName );
+	if (compiledIt != state.compiledFunctions.end())
+	{
+		outCompiled = &compiledIt->second;
+		rhs = outCompiled->body;
+	}
+	else
+	{
+		auto defIt = state.userFunctions.find( inName );
+		if (defIt != state.userFunctions.end())
+		{
+			rhs = std::get<autoASTNode>( defIt->second );
+		}
+	}
+	
+	return rhs;
+}
+
+static std::optional<double> CallWithArguments( const std::string& inName,
+												std::vector<double>& arguments,
+												const autoASTNode& rhs,
+												const CompiledFunc* compiled,
+												SCalcState& state )
+{
+	std::optional<double> result;
+	
+	if ( (state.tableFuncName != nullptr) and (*state.tableFuncName == inName) )
+	{
+		// A recursive call while filling a table.
+		return LookUpRecursionTable( arguments[0], state );
+	}
+	
+	if ( (arguments.size() == 1) and (not state.tabulations.empty()) )
+	{
+		auto tabIt = state.tabulations.find( inName );
+		if ( (tabIt != state.tabulations.end()) and
+			tabIt->second.approximant->Contains( arguments[0] ) )
+		{
+			return tabIt->second.approximant->Evaluate( arguments[0] );
+		}
+	}
+	if ( (compiled != nullptr) and (compiled->recurrence != nullptr) )
+	{
+		result = EvaluateLinearRecurrence( *compiled->recurrence,
+			arguments[0], state );
+		if (result.has_value())
+		{
+			return result;
+		}
+	}
+	if ( (compiled != nullptr) and (compiled->maxRecursionOffset > 0) )
+	{
+		result = EvaluateByRecursionTable( inName, *compiled,
+			arguments[0], state );
+		if (result.has_value())
+		{
+			return result;
+		}
 	}
 	
-	std::optional<FuncDef> userFunc( Lookup( _funcName, state.userFunctions ) );
-	if (userFunc.has_value())
+	// See if we have previously cached the result of this evaluation.  Only
+	// a new result needs a key that owns copies of the name and arguments.
+	result = FindCachedResult( state, UserFuncCacheKeyView{ inName, arguments } );
+	if (not result.has_value())
 	{
-		autoASTNode rhs = std::get<autoASTNode>( userFunc.value() );
+		state.functionArguments.swap( arguments );
+		
+		result = rhs->Evaluate( state );
+		
+		state.functionArguments.swap( arguments );
+		
+		if (result.has_value())
+		{
+			CacheResult( state, UserFuncCacheKey( inName, arguments ), *result );
+		}
+	}
+	
+	return result;
+}
 
-		std::vector<double> arguments;
-		arguments.reserve( _children.size() );
+std::optional<double>	UserFuncNode::Evaluate( SCalcState& state ) const
+{
+	std::optional<double> result;
+	
+	if (not CanCall( state ))
+	{
+		return result;
+	}
+	
+	const CompiledFunc* compiled = nullptr;
+	autoASTNode rhs( FindBody( _funcName, state, compiled ) );
+	
+	if (rhs != nullptr)
+	{
+		ScratchArguments scratch( state );
+		std::vector<double>& arguments( scratch.Arguments() );
 		
 		for (autoASTNode argNode: _children)
 		{
@@ -81,26 +212,8 @@ std::optional<double>	UserFuncNode::Evaluate( SCalcState& state ) const
 		
 		if (arguments.size() == _children.size())
 		{
-			// See if we have previously cached the result of this evaluation.
-			UserFuncCacheKey cacheKey( _funcName, arguments );
-			auto foundIt = state.resultCache.find( cacheKey );
-			if (foundIt == state.resultCache.end())
-			{
-				state.functionArguments.swap( arguments );
-				
-				result = rhs->Evaluate( state );
-				
-				if (result.has_value())
-				{
-					state.resultCache.emplace( std::move(cacheKey), *result  );
-				}
-
-				state.functionArguments.swap( arguments );
-			}
-			else // use cached result
-			{
-				result = foundIt->second;
-			}
+			result = CallWithArguments( _funcName, arguments, rhs, compiled,
+				state );
 		}
 	}
 	
@@ -108,6 +221,123 @@ std::optional<double>	UserFuncNode::Evaluate( SCalcState& state ) const
 	return result;
 }
 
+std::optional<Dual>	UserFuncNode::EvaluateDual( SCalcState& state ) const
+{
+	std::optional<Dual> result;
+	std::vector<Dual> arguments;
+	arguments.reserve( _children.size() );
+	
+	for (const autoASTNode& argNode : _children)
+	{
+		std::optional<Dual> argVal( argNode->EvaluateDual( state ) );
+		if (not argVal.has_value())
+		{
+			break;
+		}
+		arguments.push_back( *argVal );
+	}
+	
+	if (arguments.size() == _children.size())
+	{
+		result = CallDual( _funcName, arguments, state );
+	}
+	
+	return result;
+}
+
+std::optional<double>	UserFuncNode::Call( const std::string& inName,
+											std::vector<double>& ioArguments,
+											SCalcState& state )
+{
+	std::optional<double> result;
+	
+	if (not CanCall( state ))
+	{
+		return result;
+	}
+	
+	const CompiledFunc* compiled = nullptr;
+	autoASTNode rhs( FindBody( inName, state, compiled ) );
+	if (rhs != nullptr)
+	{
+		result = CallWithArguments( inName, ioArguments, rhs, compiled, state );
+	}
+	
+	return result;
+}
+
+std::optional<Dual>	UserFuncNode::CallDual( const std::string& inName,
+											std::vector<Dual>& ioArguments,
+											SCalcState& state )
+{
+	std::optional<Dual> result;
+	
+	if (not CanCall( state ))
+	{
+		return result;
+	}
+	
+	const CompiledFunc* compiled = nullptr;
+	autoASTNode rhs( FindBody( inName, state, compiled ) );
+	if (rhs == nullptr)
+	{
+		return result;
+	}
+	
+	std::vector<double> values;
+	values.reserve( ioArguments.size() );
+	bool isConstant = true;
+	for (const Dual& arg : ioArguments)
+	{
+		values.push_back( arg.value );
+		isConstant = isConstant and (arg.derivative == 0.0);
+	}
+	
+	if (isConstant)
+	{
+		// The result does not depend on the variable of differentiation, so
+		// the usual ways of evaluating the function apply.
+		std::optional<double> value( CallWithArguments( inName, values, rhs,
+			compiled, state ) );
+		if (value.has_value())
+		{
+			result = Dual{ *value, 0.0 };
+		}
+		return result;
+	}
+	
+	// The cache key lists each value followed by its derivative.
+	UserFuncCacheKey cacheKey( inName, {} );
+	cacheKey.second.reserve( 2 * ioArguments.size() );
+	for (const Dual& arg : ioArguments)
+	{
+		cacheKey.second.push_back( arg.value );
+		cacheKey.second.push_back( arg.derivative );
+	}
+	auto foundIt = state.dualResultCache.find( cacheKey );
+	if (foundIt != state.dualResultCache.end())
+	{
+		return foundIt->second;
+	}
+	
+	// Parts of the body that do not involve the parameters may be evaluated
+	// in the usual way, so they need the values of the arguments too.
+	state.dualArguments.swap( ioArguments );
+	state.functionArguments.swap( values );
+	
+	result = rhs->EvaluateDual( state );
+	
+	state.functionArguments.swap( values );
+	state.dualArguments.swap( ioArguments );
+	
+	if (result.has_value())
+	{
+		state.dualResultCache.emplace( std::move( cacheKey ), *result );
+	}
+	
+	return result;
+}
+
 
 autoCFDictionaryRef	UserFuncNode::ToDictionary() const
 {
@@ -166,3 +396,9 @@ bool	UserFuncNode::operator==( const ASTNode& other ) const
 	
 	return isEqual;
 }
+
+
+autoASTNode	UserFuncNode::CloneWithChildren( const ASTNodeVec& children ) const
+{
+	return autoASTNode( new UserFuncNode( _funcName, children ) );
+}